@@ -0,0 +1,1093 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "poly.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RECORD "record"
+#define COMPARE "compare"
+#define UPDATE "update"
+#define SCALING "scaling"
+#define RUN "run"
+
+/** Największa liczba próbek jednego pomiaru */
+#define SAMPLES 31
+
+/** Liczba niezależnych przebiegów (osobnych procesów) pomiarów */
+#define RUNS 9
+
+/** Liczba próbek na parę (operacja, rozmiar) w jednym przebiegu */
+#define RUN_SAMPLES 5
+
+/** Minimalny czas pojedynczej próbki w nanosekundach */
+#define MIN_SAMPLE_NS 2000000.0
+
+/** Domyślna tolerancja spadku przepustowości w procentach */
+#define DEFAULT_TIME_TOLERANCE 15.0
+
+/** Domyślna tolerancja wzrostu liczby alokacji w procentach */
+#define DEFAULT_ALLOC_TOLERANCE 0.0
+
+/** Liczba próbek na punkt w jednym przebiegu trybu badania złożoności */
+#define SCALING_SAMPLES 5
+
+/** Liczba przebiegów po rozmiarach w trybie badania złożoności */
+#define SCALING_SWEEPS 5
+
+/** Najmniejszy rozmiar w trybie badania złożoności */
+#define SCALING_MIN_SIZE 256
+
+/** Dopuszczalna nadwyżka dopasowanego wykładnika nad oczekiwanym */
+#define SCALING_SLACK 0.25
+
+/** Klasy rozmiarów (liczba jednomianów) wielomianów wejściowych */
+static const unsigned size_classes[] = {100, 1000, 10000};
+
+/** Liczba klas rozmiarów */
+#define SIZE_CLASSES (sizeof(size_classes) / sizeof(size_classes[0]))
+
+/** Licznik alokacji wykonanych przez bibliotekę */
+static long alloc_count = 0;
+
+#ifdef POLY_BENCH_COUNT_ALLOCS
+/* Linker podmienia malloc, calloc i realloc na poniższe funkcje
+ * (opcja -Wl,--wrap), dzięki czemu możemy zliczać alokacje bez
+ * modyfikowania kodu biblioteki. */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    alloc_count++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    alloc_count++;
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    alloc_count++;
+    return __real_realloc(ptr, size);
+}
+#endif
+
+/**
+ * Wynik pomiaru dla pary (operacja, rozmiar).
+ */
+typedef struct BenchResult
+{
+    char op[32]; ///< nazwa operacji
+    unsigned size; ///< klasa rozmiaru
+    double median_ns; ///< mediana czasu jednej operacji
+    double ci_low_ns; ///< dolna granica przedziału (najmniejsza mediana przebiegu)
+    double ci_high_ns; ///< górna granica przedziału (największa mediana przebiegu)
+    long allocs; ///< liczba alokacji jednej operacji (-1 gdy nieznana)
+} BenchResult;
+
+/**
+ * Dane wejściowe mierzonej operacji.
+ */
+typedef struct BenchInput
+{
+    Poly p; ///< pierwszy argument
+    Poly q; ///< drugi argument
+    Mono *monos; ///< bufor jednomianów dla PolyAddMonos
+    poly_coeff_t *coeffs; ///< bufor współczynników
+    unsigned size; ///< klasa rozmiaru
+} BenchInput;
+
+/**
+ * Opis mierzonej operacji.
+ */
+typedef struct BenchOp
+{
+    const char *name; ///< nazwa operacji w raporcie
+    void (*run)(BenchInput *in); ///< jedno wykonanie operacji
+    double expected_exp; ///< oczekiwany wykładnik złożoności względem rozmiaru
+    unsigned max_size; ///< największy mierzony rozmiar
+    double extra_slack; ///< zapas wykładnika ponad SCALING_SLACK (zwykle zero)
+} BenchOp;
+
+/**
+ * Zwraca aktualny czas w nanosekundach.
+ */
+static double NowNs(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * Generator liczb pseudolosowych (LCG), żeby dane wejściowe były
+ * powtarzalne między uruchomieniami.
+ * @param state : stan generatora
+ * @return kolejna liczba
+ */
+static unsigned long NextRandom(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+/**
+ * Tworzy gęsty wielomian jednej zmiennej o @p size wyrazach.
+ * @param size : liczba wyrazów
+ * @param seed : ziarno generatora współczynników
+ * @return wielomian
+ */
+static Poly MakeDensePoly(unsigned size, unsigned long seed)
+{
+    Mono *m = calloc(size, sizeof(Mono));
+    assert(m != NULL);
+    for (unsigned i = 0; i < size; i++)
+    {
+        Poly c = PolyFromCoeff((poly_coeff_t)(NextRandom(&seed) % 1999) - 999);
+        if (PolyIsZero(&c))
+            c = PolyFromCoeff(1);
+        m[i] = MonoFromPoly(&c, (poly_exp_t)i);
+    }
+    Poly res = PolyAddMonos(size, m);
+    free(m);
+    return res;
+}
+
+static void RunClone(BenchInput *in)
+{
+    Poly r = PolyClone(&in->p);
+    PolyDestroy(&r);
+}
+
+static void RunAdd(BenchInput *in)
+{
+    Poly r = PolyAdd(&in->p, &in->q);
+    PolyDestroy(&r);
+}
+
+static void RunSub(BenchInput *in)
+{
+    Poly r = PolySub(&in->p, &in->q);
+    PolyDestroy(&r);
+}
+
+static void RunNeg(BenchInput *in)
+{
+    Poly r = PolyNeg(&in->p);
+    PolyDestroy(&r);
+}
+
+static void RunScale(BenchInput *in)
+{
+    Poly r = PolyScale(&in->p, 3);
+    PolyDestroy(&r);
+}
+
+static void RunAddCoeff(BenchInput *in)
+{
+    Poly r = PolyAddCoeff(&in->p, 3);
+    PolyDestroy(&r);
+}
+
+static void RunAddOwned(BenchInput *in)
+{
+    // acc = acc + q; kopiowane są tylko kolejne składniki, a ich jednomiany
+    // trafiają do wyniku bez ponownej alokacji.
+    Poly acc = PolyZero();
+    for (int i = 0; i < 4; i++)
+    {
+        Poly term = PolyClone(&in->q);
+        acc = PolyAddOwned(&acc, &term);
+    }
+    PolyDestroy(&acc);
+}
+
+static void RunAddTo(BenchInput *in)
+{
+    // acc += q; jednomiany alokowane są tylko przy pierwszym dodaniu.
+    Poly acc = PolyZero();
+    for (int i = 0; i < 4; i++)
+        PolyAddTo(&acc, &in->q);
+    PolyDestroy(&acc);
+}
+
+static void RunMul(BenchInput *in)
+{
+    Poly r = PolyMul(&in->p, &in->q);
+    PolyDestroy(&r);
+}
+
+static void RunAddMany(BenchInput *in)
+{
+    // 2p - q + 3p + q + ... dla 8 składników jednym wywołaniem.
+    Poly polys[8];
+    poly_coeff_t weights[8];
+    for (int i = 0; i < 8; i++)
+    {
+        polys[i] = i % 2 == 0 ? in->p : in->q;
+        weights[i] = i % 2 == 0 ? i + 2 : (i % 4 == 1 ? -1 : 1);
+    }
+    Poly r = PolyAddMany(8, polys, weights);
+    PolyDestroy(&r);
+}
+
+static void RunMulTrunc(BenchInput *in)
+{
+    // Tylko niższa połowa iloczynu.
+    Poly r = PolyMulTrunc(&in->p, &in->q, (poly_exp_t)in->size);
+    PolyDestroy(&r);
+}
+
+static void RunSquare(BenchInput *in)
+{
+    Poly r = PolySquare(&in->p);
+    PolyDestroy(&r);
+}
+
+static void RunPow(BenchInput *in)
+{
+    Poly r = PolyPow(&in->p, 4);
+    PolyDestroy(&r);
+}
+
+static void RunCompose(BenchInput *in)
+{
+    // Podstawienie x + 1 za x.
+    static const poly_coeff_t shift[] = {1, 1};
+    Poly q = PolyFromCoeffArray(2, shift, 1);
+    Poly r = PolyCompose(&in->p, 1, &q);
+    PolyDestroy(&q);
+    PolyDestroy(&r);
+}
+
+static void RunDivRem(BenchInput *in)
+{
+    // Dzielnik: dolna połowa q z wiodącym współczynnikiem 1.
+    unsigned half = in->size / 2 > 0 ? in->size / 2 : 1;
+    PolyToCoeffArray(&in->q, half, in->coeffs, 1);
+    in->coeffs[half - 1] = 1;
+    Poly d = PolyFromCoeffArray(half, in->coeffs, 1);
+    Poly quot, rem;
+    PolyDivRem(&in->p, &d, &quot, &rem);
+    PolyDestroy(&d);
+    PolyDestroy(&quot);
+    PolyDestroy(&rem);
+}
+
+static void RunDivExact(BenchInput *in)
+{
+    // Iloczyn p * q dzielony przez q oraz (przerwane) sprawdzenie, czy
+    // q + 1 dzieli p * q.
+    Poly product = PolyMul(&in->p, &in->q);
+    Poly quot;
+    PolyDivExact(&product, &in->q, &quot);
+    Poly shifted = PolyAddCoeff(&in->q, 1);
+    PolyDivides(&shifted, &product);
+    PolyDestroy(&product);
+    PolyDestroy(&quot);
+    PolyDestroy(&shifted);
+}
+
+static void RunGcd(BenchInput *in)
+{
+    // NWD dwóch gęstych wielomianów, które są względnie pierwsze, więc
+    // wystarcza jeden obraz modulo liczba pierwsza.
+    Poly gcd = PolyGcd(&in->p, &in->q);
+    PolyDestroy(&gcd);
+}
+
+static void RunGcdExtMod(BenchInput *in)
+{
+    // NWD z współczynnikami Bézouta modulo liczba pierwsza 2^31 - 1.
+    Poly gcd, s, t;
+    PolyGcdExtMod(&in->p, &in->q, 2147483647, &gcd, &s, &t);
+    PolyDestroy(&gcd);
+    PolyDestroy(&s);
+    PolyDestroy(&t);
+}
+
+static void RunResultant(BenchInput *in)
+{
+    Poly r = PolyResultant(&in->p, &in->q, 0);
+    PolyDestroy(&r);
+}
+
+static void RunDerivative(BenchInput *in)
+{
+    Poly r = PolyDerivative(&in->p, 0);
+    PolyDestroy(&r);
+}
+
+static void RunEvalGrad(BenchInput *in)
+{
+    poly_coeff_t point[1] = {3}, grad[1], hess[1];
+    PolyEvalGrad(&in->p, 1, point, grad, hess);
+}
+
+static void RunSeriesInvMod(BenchInput *in)
+{
+    Poly r;
+    PolySeriesInvMod(&in->p, (poly_exp_t)in->size, 998244353, &r);
+    PolyDestroy(&r);
+}
+
+static void RunSeriesExpMod(BenchInput *in)
+{
+    // Wyraz wolny argumentu exp musi być zerem.
+    PolyToCoeffArray(&in->p, in->size, in->coeffs, 1);
+    Poly f = PolyAddCoeff(&in->p, -in->coeffs[0]);
+    Poly r;
+    PolySeriesExpMod(&f, (poly_exp_t)in->size, 998244353, &r);
+    PolyDestroy(&f);
+    PolyDestroy(&r);
+}
+
+static void RunShift(BenchInput *in)
+{
+    Poly r = PolyShift(&in->p, 3);
+    PolyDestroy(&r);
+}
+
+static void RunAddMonos(BenchInput *in)
+{
+    // Jednomiany w kolejności rosnących wykładników, z powtórzeniami.
+    for (unsigned i = 0; i < in->size; i++)
+    {
+        Poly c = PolyFromCoeff((poly_coeff_t)i % 7 + 1);
+        in->monos[i] = MonoFromPoly(&c, (poly_exp_t)(i / 2));
+    }
+    Poly r = PolyAddMonos(in->size, in->monos);
+    PolyDestroy(&r);
+}
+
+static void RunAddMonosShuffled(BenchInput *in)
+{
+    // Jednomiany w losowej kolejności, z powtórzeniami.
+    unsigned long seed = 7;
+    for (unsigned i = 0; i < in->size; i++)
+    {
+        Poly c = PolyFromCoeff((poly_coeff_t)i % 7 + 1);
+        in->monos[i] = MonoFromPoly(&c, (poly_exp_t)(NextRandom(&seed) % in->size));
+    }
+    Poly r = PolyAddMonos(in->size, in->monos);
+    PolyDestroy(&r);
+}
+
+static void RunBuilder(BenchInput *in)
+{
+    // Te same wyrazy co w add-monos, ale bez powtórzeń i od razu malejąco.
+    PolyBuilder b;
+    PolyBuilderInit(&b);
+    PolyBuilderReserve(&b, in->size);
+    for (unsigned i = in->size; i-- > 0;)
+        PolyBuilderAppendCoeff(&b, (poly_exp_t)i, (poly_coeff_t)i % 7 + 1);
+    Poly r = PolyBuilderFinish(&b);
+    PolyDestroy(&r);
+}
+
+static void RunCoeffArray(BenchInput *in)
+{
+    PolyToCoeffArray(&in->p, in->size, in->coeffs, 1);
+    Poly r = PolyFromCoeffArray(in->size, in->coeffs, 1);
+    PolyDestroy(&r);
+}
+
+static void RunAddMonosNested(BenchInput *in)
+{
+    // Połowa jednomianów ma wykładnik 0, a ich współczynniki to kolejne
+    // potęgi następnej zmiennej, więc sumowanie powtórzeń buduje coraz
+    // dłuższy wielomian we współczynniku.
+    for (unsigned i = 0; i < in->size; i++)
+    {
+        Poly one = PolyFromCoeff(1);
+        Mono inner = MonoFromPoly(&one, (poly_exp_t)i);
+        Poly c = PolyAddMonos(1, &inner);
+        in->monos[i] = MonoFromPoly(&c, (poly_exp_t)(i % 2));
+    }
+    Poly r = PolyAddMonos(in->size, in->monos);
+    PolyDestroy(&r);
+}
+
+/** Mierzone operacje */
+static const BenchOp ops[] = {
+        {"clone",            RunClone,          1.0, 16384, 0.0},
+        {"add",              RunAdd,            1.0, 16384, 0.0},
+        {"sub",              RunSub,            1.0, 16384, 0.0},
+        {"neg",              RunNeg,            1.0, 16384, 0.0},
+        {"scale",            RunScale,          1.0, 16384, 0.0},
+        {"add-coeff",        RunAddCoeff,       1.0, 16384, 0.0},
+        {"add-owned",        RunAddOwned,       1.0, 16384, 0.0},
+        {"add-to",           RunAddTo,          1.0, 16384, 0.0},
+        {"add-many",         RunAddMany,        1.0, 16384, 0.0},
+        {"mul",              RunMul,            1.6, 16384, 0.0},
+        {"mul-trunc",        RunMulTrunc,       1.6, 16384, 0.0},
+        {"square",           RunSquare,         1.6, 16384, 0.0},
+        {"pow",              RunPow,            1.6, 4096, 0.0},
+        {"compose",          RunCompose,        1.6, 4096, 0.0},
+        {"div-rem",          RunDivRem,         1.6, 16384, 0.0},
+        // Dzielenie kopcem: n^2 log n, a między 768 a 896 wyrazami dane
+        // przestają mieścić się w L1, co podnosi nachylenie o około 0.3.
+        {"div-exact",        RunDivExact,       2.2, 1024, 0.3},
+        {"gcd",              RunGcd,            2.0, 1024, 0.0},
+        {"gcd-ext-mod",      RunGcdExtMod,      1.8, 8192, 0.0},
+        {"resultant",        RunResultant,      2.0, 4096, 0.0},
+        {"derivative",       RunDerivative,     1.0, 16384, 0.0},
+        {"eval-grad",        RunEvalGrad,       1.0, 16384, 0.0},
+        {"series-inv-mod",   RunSeriesInvMod,   1.6, 16384, 0.0},
+        {"series-exp-mod",   RunSeriesExpMod,   1.6, 16384, 0.0},
+        {"shift",            RunShift,          1.6, 16384, 0.0},
+        {"add-monos",        RunAddMonos,       1.0, 16384, 0.0},
+        {"add-monos-shuffled", RunAddMonosShuffled, 1.0, 16384, 0.0},
+        {"add-monos-nested", RunAddMonosNested, 1.0, 4096, 0.0},
+        {"builder",          RunBuilder,        1.0, 16384, 0.0},
+        {"coeff-array",      RunCoeffArray,     1.0, 16384, 0.0},
+};
+
+/** Liczba mierzonych operacji */
+#define OPS (sizeof(ops) / sizeof(ops[0]))
+
+static int DoubleComparator(const void *x1, const void *x2)
+{
+    double d1 = *(const double *)x1;
+    double d2 = *(const double *)x2;
+    return (d1 > d2) - (d1 < d2);
+}
+
+/**
+ * Mierzy operację @p op na danych rozmiaru @p size.
+ * Mediana liczona jest z @p count próbek, a jej 95% przedział ufności
+ * wyznaczają statystyki pozycyjne (przybliżenie normalne rozkładu
+ * dwumianowego), więc nie zakładamy nic o rozkładzie czasów.
+ * @param op : operacja
+ * @param size : klasa rozmiaru
+ * @param count : liczba próbek (co najwyżej SAMPLES)
+ * @return wynik pomiaru
+ */
+static BenchResult Measure(const BenchOp *op, unsigned size, int count)
+{
+    assert(count > 0 && count <= SAMPLES);
+    BenchInput in;
+    in.p = MakeDensePoly(size, 1);
+    in.q = MakeDensePoly(size, 2);
+    in.monos = calloc(size, sizeof(Mono));
+    assert(in.monos != NULL);
+    in.coeffs = calloc(size, sizeof(poly_coeff_t));
+    assert(in.coeffs != NULL);
+    in.size = size;
+
+    // Rozgrzewka i liczba alokacji jednego wykonania.
+    long allocs_before = alloc_count;
+    op->run(&in);
+    long allocs = alloc_count - allocs_before;
+
+    // Dobieramy liczbę powtórzeń tak, by próbka trwała co najmniej
+    // MIN_SAMPLE_NS.
+    unsigned iters = 1;
+    for (;;)
+    {
+        double start = NowNs();
+        for (unsigned i = 0; i < iters; i++)
+            op->run(&in);
+        if (NowNs() - start >= MIN_SAMPLE_NS || iters >= (1u << 20))
+            break;
+        iters *= 2;
+    }
+
+    double samples[SAMPLES];
+    for (int s = 0; s < count; s++)
+    {
+        double start = NowNs();
+        for (unsigned i = 0; i < iters; i++)
+            op->run(&in);
+        samples[s] = (NowNs() - start) / iters;
+    }
+    qsort(samples, (size_t)count, sizeof(double), DoubleComparator);
+
+    double half_width = 0.98 * sqrt((double)count);
+    int low = (int)floor(count / 2.0 - half_width);
+    int high = (int)ceil(count / 2.0 + half_width);
+    if (low < 0)
+        low = 0;
+    if (high > count - 1)
+        high = count - 1;
+
+    BenchResult res;
+    snprintf(res.op, sizeof(res.op), "%s", op->name);
+    res.size = size;
+    res.median_ns = samples[count / 2];
+    res.ci_low_ns = samples[low];
+    res.ci_high_ns = samples[high];
+#ifdef POLY_BENCH_COUNT_ALLOCS
+    res.allocs = allocs;
+#else
+    (void)allocs;
+    res.allocs = -1;
+#endif
+
+    PolyDestroy(&in.p);
+    PolyDestroy(&in.q);
+    free(in.monos);
+    free(in.coeffs);
+    return res;
+}
+
+/**
+ * Wyszukuje wynik pomiaru operacji @p op na danych rozmiaru @p size.
+ * @param res : wyniki
+ * @param count : liczba wyników
+ * @param op : nazwa operacji
+ * @param size : klasa rozmiaru
+ * @return wynik lub NULL, jeśli go nie ma
+ */
+static const BenchResult *FindResult(const BenchResult *res, size_t count,
+                                     const char *op, unsigned size)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (strcmp(res[i].op, op) == 0 && res[i].size == size)
+            return &res[i];
+    }
+    return NULL;
+}
+
+/**
+ * Mierzy w jednym przebiegu wszystkie operacje we wszystkich klasach
+ * rozmiarów, pomijając pary (operacja, rozmiar) obecne w @p skip.
+ * @param skip : wyniki, których nie mierzymy ponownie (może być NULL)
+ * @param skip_count : liczba wyników w @p skip
+ * @param count : tu zapisywana jest liczba wyników
+ * @return tablica wyników (do zwolnienia przez wywołującego)
+ */
+static BenchResult *MeasureRun(const BenchResult *skip, size_t skip_count,
+                               size_t *count)
+{
+    BenchResult *res = calloc(OPS * SIZE_CLASSES, sizeof(BenchResult));
+    assert(res != NULL);
+    *count = 0;
+    for (size_t i = 0; i < OPS; i++)
+    {
+        for (size_t j = 0; j < SIZE_CLASSES; j++)
+        {
+            if (size_classes[j] > ops[i].max_size
+                || FindResult(skip, skip_count, ops[i].name, size_classes[j]) != NULL)
+                continue;
+            res[*count] = Measure(&ops[i], size_classes[j], RUN_SAMPLES);
+            (*count)++;
+        }
+    }
+    return res;
+}
+
+/**
+ * Zapisuje wyniki w formacie JSON.
+ * @param out : plik wyjściowy
+ * @param res : wyniki
+ * @param count : liczba wyników
+ */
+static void WriteJson(FILE *out, const BenchResult *res, size_t count)
+{
+    fprintf(out, "{\n  \"version\": 1,\n  \"results\": [\n");
+    for (size_t i = 0; i < count; i++)
+    {
+        fprintf(out,
+                "    {\"op\": \"%s\", \"size\": %u, \"median_ns\": %.1f, "
+                "\"ci_low_ns\": %.1f, \"ci_high_ns\": %.1f, \"allocs\": %ld}%s\n",
+                res[i].op, res[i].size, res[i].median_ns, res[i].ci_low_ns,
+                res[i].ci_high_ns, res[i].allocs, i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+/**
+ * Odczytuje wartość liczbową pola @p key z obiektu JSON zaczynającego się
+ * w @p obj i kończącego przed @p end.
+ * @return czy pole zostało znalezione
+ */
+static bool JsonNumber(const char *obj, const char *end, const char *key,
+                       double *value)
+{
+    char pattern[40];
+    snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+    const char *pos = strstr(obj, pattern);
+    if (pos == NULL || pos >= end)
+        return false;
+    pos = strchr(pos + strlen(pattern), ':');
+    if (pos == NULL || pos >= end)
+        return false;
+    char *num_end;
+    *value = strtod(pos + 1, &num_end);
+    return num_end != pos + 1;
+}
+
+/**
+ * Wczytuje wyniki zapisane przez WriteJson ze strumienia (pliku albo
+ * wyjścia procesu potomnego) aż do jego końca.
+ * Parser rozumie tylko płaskie obiekty z tablicy "results".
+ * @param in : strumień
+ * @param count : tu zapisywana jest liczba wyników
+ * @return tablica wyników
+ */
+static BenchResult *ReadJsonStream(FILE *in, size_t *count)
+{
+    size_t len = 0, text_capacity = 4096;
+    char *text = malloc(text_capacity);
+    assert(text != NULL);
+    size_t read;
+    while ((read = fread(text + len, 1, text_capacity - len - 1, in)) > 0)
+    {
+        len += read;
+        if (len + 1 == text_capacity)
+        {
+            text_capacity *= 2;
+            text = realloc(text, text_capacity);
+            assert(text != NULL);
+        }
+    }
+    text[len] = '\0';
+
+    size_t capacity = 16;
+    BenchResult *res = calloc(capacity, sizeof(BenchResult));
+    assert(res != NULL);
+    *count = 0;
+    const char *pos = strstr(text, "\"results\"");
+    while (pos != NULL && (pos = strchr(pos, '{')) != NULL)
+    {
+        const char *end = strchr(pos, '}');
+        if (end == NULL)
+            break;
+        const char *op = strstr(pos, "\"op\"");
+        double size, median, low, high, allocs;
+        if (op != NULL && op < end && (op = strchr(op + 4, '"')) != NULL
+            && JsonNumber(pos, end, "size", &size)
+            && JsonNumber(pos, end, "median_ns", &median)
+            && JsonNumber(pos, end, "ci_low_ns", &low)
+            && JsonNumber(pos, end, "ci_high_ns", &high)
+            && JsonNumber(pos, end, "allocs", &allocs))
+        {
+            if (*count == capacity)
+            {
+                capacity *= 2;
+                res = realloc(res, capacity * sizeof(BenchResult));
+                assert(res != NULL);
+            }
+            const char *op_end = strchr(op + 1, '"');
+            size_t op_len = (size_t)(op_end - op - 1);
+            if (op_len >= sizeof(res[*count].op))
+                op_len = sizeof(res[*count].op) - 1;
+            memcpy(res[*count].op, op + 1, op_len);
+            res[*count].op[op_len] = '\0';
+            res[*count].size = (unsigned)size;
+            res[*count].median_ns = median;
+            res[*count].ci_low_ns = low;
+            res[*count].ci_high_ns = high;
+            res[*count].allocs = (long)allocs;
+            (*count)++;
+        }
+        pos = end + 1;
+    }
+    free(text);
+    return res;
+}
+
+/**
+ * Wczytuje wyniki bazowe zapisane przez WriteJson do pliku.
+ * @param path : ścieżka pliku
+ * @param count : tu zapisywana jest liczba wyników
+ * @return tablica wyników lub NULL w razie błędu
+ */
+static BenchResult *ReadJson(const char *path, size_t *count)
+{
+    FILE *in = fopen(path, "rb");
+    if (in == NULL)
+        return NULL;
+    BenchResult *res = ReadJsonStream(in, count);
+    fclose(in);
+    return res;
+}
+
+/**
+ * Mierzy wszystkie operacje w RUNS niezależnych przebiegach. Każdy
+ * przebieg to osobny proces (@p program w trybie RUN), bo układ pamięci,
+ * od którego zależy czas krótkich operacji, ustala się przy starcie
+ * procesu: przebiegi w jednym procesie dzieliłyby go i mierzyłyby tylko
+ * rozrzut wewnątrz niego. Wynikiem jest mediana median przebiegów,
+ * a przedział wyznaczają najmniejsza i największa z nich.
+ * @param program : ścieżka tego programu
+ * @param skip_path : plik z wynikami, których nie mierzymy ponownie (może
+ * być NULL)
+ * @param count : tu zapisywana jest liczba wyników
+ * @return tablica wyników (do zwolnienia przez wywołującego) lub NULL,
+ * jeśli któryś przebieg się nie powiódł
+ */
+static BenchResult *MeasureAll(const char *program, const char *skip_path,
+                               size_t *count)
+{
+    char command[4096];
+    int length = snprintf(command, sizeof(command), "\"%s\" %s", program, RUN);
+    if (skip_path != NULL && length > 0 && (size_t)length < sizeof(command))
+        length += snprintf(command + length, sizeof(command) - (size_t)length,
+                           " \"%s\"", skip_path);
+    if (length < 0 || (size_t)length >= sizeof(command))
+        return NULL;
+
+    BenchResult *res = NULL;
+    double *medians = NULL;
+    bool failed = false;
+    *count = 0;
+    for (int run = 0; run < RUNS && !failed; run++)
+    {
+        fprintf(stderr, "run %d/%d\n", run + 1, RUNS);
+        FILE *child = popen(command, "r");
+        if (child == NULL)
+        {
+            failed = true;
+            break;
+        }
+        size_t run_count;
+        BenchResult *one = ReadJsonStream(child, &run_count);
+        failed = pclose(child) != 0 || (run > 0 && run_count != *count);
+        if (!failed && run == 0)
+        {
+            res = one;
+            *count = run_count;
+            medians = calloc(run_count * RUNS + 1, sizeof(double));
+            assert(medians != NULL);
+        }
+        for (size_t i = 0; i < *count && !failed; i++)
+        {
+            const BenchResult *r = FindResult(one, run_count, res[i].op, res[i].size);
+            if (r == NULL)
+                failed = true;
+            else
+                medians[i * RUNS + (size_t)run] = r->median_ns;
+        }
+        if (one != res)
+            free(one);
+    }
+    if (failed)
+    {
+        free(res);
+        free(medians);
+        return NULL;
+    }
+    for (size_t i = 0; i < *count; i++)
+    {
+        double *runs = medians + i * RUNS;
+        qsort(runs, RUNS, sizeof(double), DoubleComparator);
+        res[i].median_ns = runs[RUNS / 2];
+        res[i].ci_low_ns = runs[0];
+        res[i].ci_high_ns = runs[RUNS - 1];
+        fprintf(stderr, "%-12s %6u  %14.1f ns  [%.1f, %.1f]  allocs %ld\n",
+                res[i].op, res[i].size, res[i].median_ns, res[i].ci_low_ns,
+                res[i].ci_high_ns, res[i].allocs);
+    }
+    free(medians);
+    return res;
+}
+
+/**
+ * Sprawdza, czy operacja jest wolniejsza niż w wynikach bazowych: stosunek
+ * median musi przekraczać 1 + @p time_tol, a spadek musi powtarzać się we
+ * wszystkich przebiegach (nawet najszybszy jest wolniejszy od mediany
+ * bazowej).
+ * @param base : wynik bazowy
+ * @param cur : bieżący wynik
+ * @param time_tol : tolerancja czasu (ułamek)
+ * @return czy to spadek przepustowości
+ */
+static bool IsSlower(const BenchResult *base, const BenchResult *cur, double time_tol)
+{
+    return cur->median_ns > base->median_ns * (1.0 + time_tol)
+           && cur->ci_low_ns > base->median_ns;
+}
+
+/**
+ * Porównuje bieżący pomiar z wynikami bazowymi.
+ * Spadek przepustowości (IsSlower) zgłaszamy tylko wtedy, gdy powtarza się
+ * we wszystkich przebiegach, a jeśli podano wcześniejszy pomiar @p first,
+ * to także w nim. Chwilowe obciążenie maszyny zaburza co najwyżej jeden
+ * z dwóch pomiarów, więc nie powoduje fałszywych alarmów.
+ * @param base : wyniki bazowe
+ * @param base_count : liczba wyników bazowych
+ * @param cur : bieżące wyniki
+ * @param cur_count : liczba bieżących wyników
+ * @param first : wcześniejszy pomiar, który ma potwierdzić spadki (może być
+ * NULL)
+ * @param first_count : liczba wyników w @p first
+ * @param time_tol : tolerancja czasu (ułamek)
+ * @param alloc_tol : tolerancja liczby alokacji (ułamek)
+ * @return liczba wykrytych regresji
+ */
+static int Compare(const BenchResult *base, size_t base_count,
+                   const BenchResult *cur, size_t cur_count,
+                   const BenchResult *first, size_t first_count,
+                   double time_tol, double alloc_tol)
+{
+    int regressions = 0;
+    for (size_t i = 0; i < cur_count; i++)
+    {
+        const BenchResult *b = FindResult(base, base_count, cur[i].op, cur[i].size);
+        if (b == NULL)
+        {
+            fprintf(stderr, "[new]        %-12s %6u  no baseline\n",
+                    cur[i].op, cur[i].size);
+            continue;
+        }
+        const BenchResult *f = FindResult(first, first_count, cur[i].op, cur[i].size);
+        const char *verdict = "[ok]";
+        if (IsSlower(b, &cur[i], time_tol) && first != NULL
+            && (f == NULL || !IsSlower(b, f, time_tol)))
+        {
+            verdict = "[unconfirmed]";
+        }
+        else if (IsSlower(b, &cur[i], time_tol))
+        {
+            verdict = "[slower]";
+            regressions++;
+        }
+        else if (cur[i].median_ns * (1.0 + time_tol) < b->median_ns
+                 && cur[i].ci_high_ns < b->median_ns)
+        {
+            verdict = "[faster]";
+        }
+        fprintf(stderr, "%-12s %-12s %6u  %14.1f ns -> %14.1f ns (%+.1f%%)\n",
+                verdict, cur[i].op, cur[i].size, b->median_ns, cur[i].median_ns,
+                100.0 * (cur[i].median_ns / b->median_ns - 1.0));
+        if (cur[i].allocs >= 0 && b->allocs >= 0
+            && (double)cur[i].allocs > (double)b->allocs * (1.0 + alloc_tol))
+        {
+            fprintf(stderr, "[allocs]     %-12s %6u  %ld -> %ld\n",
+                    cur[i].op, cur[i].size, b->allocs, cur[i].allocs);
+            regressions++;
+        }
+    }
+    return regressions;
+}
+
+/**
+ * Mierzy operację na rozmiarach SCALING_MIN_SIZE * 2^k nie większych niż
+ * max_size operacji i dopasowuje metodą
+ * najmniejszych kwadratów prostą do punktów (log n, log t). Jej nachylenie
+ * to empiryczny wykładnik złożoności, porównywany z oczekiwanym.
+ * Rozmiary mierzone są w SCALING_SWEEPS przeplatanych przebiegach, a do
+ * dopasowania bierzemy najmniejszą medianę dla każdego rozmiaru: szum
+ * tylko wydłuża pomiary, więc minimum jest stabilne między uruchomieniami,
+ * nawet gdy chwilowe obciążenie zaburzy jeden przebieg.
+ * @param op : operacja
+ * @return czy dopasowany wykładnik mieści się w oczekiwanym z zapasem
+ * SCALING_SLACK (i dodatkowym zapasem operacji)
+ */
+static bool CheckScaling(const BenchOp *op)
+{
+    double best[32];
+    int steps = 0;
+    for (int sweep = 0; sweep < SCALING_SWEEPS; sweep++)
+    {
+        steps = 0;
+        for (unsigned size = SCALING_MIN_SIZE; size <= op->max_size; size *= 2)
+        {
+            assert(steps < (int)(sizeof(best) / sizeof(best[0])));
+            BenchResult res = Measure(op, size, SCALING_SAMPLES);
+            if (sweep == 0 || res.median_ns < best[steps])
+                best[steps] = res.median_ns;
+            steps++;
+        }
+    }
+    double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+    unsigned size = SCALING_MIN_SIZE;
+    for (int i = 0; i < steps; i++, size *= 2)
+    {
+        double x = log((double)size);
+        double y = log(best[i]);
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+        fprintf(stderr, "%-12s %6u  %14.1f ns\n", op->name, size, best[i]);
+    }
+    double n = steps;
+    double slope = (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x);
+    bool ok = slope <= op->expected_exp + SCALING_SLACK + op->extra_slack;
+    fprintf(stderr, "%-12s %-12s fitted n^%.2f, expected n^%.2f\n",
+            ok ? "[ok]" : "[too-slow]", op->name, slope, op->expected_exp);
+    return ok;
+}
+
+/**
+ * Wypisuje na standardowe wyjście błędów informację o argumentach programu
+ * @param program_name nazwa programu
+ */
+void PrintHelp(char *program_name)
+{
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "\t%s %s <output.json>\n", program_name, RECORD);
+    fprintf(stderr,
+            "\t%s %s <baseline.json> [time_tolerance_%%] [alloc_tolerance_%%]\n",
+            program_name, COMPARE);
+    fprintf(stderr, "\t%s %s <baseline.json>\n", program_name, UPDATE);
+    fprintf(stderr, "\t%s %s [operation]\n", program_name, SCALING);
+    fprintf(stderr, "\t%s %s [baseline.json]\n", program_name, RUN);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+    if (strcmp(argv[1], RECORD) == 0 && argc == 3)
+    {
+        size_t count;
+        BenchResult *res = MeasureAll(argv[0], NULL, &count);
+        if (res == NULL)
+        {
+            fprintf(stderr, "measurement run failed\n");
+            return -1;
+        }
+        FILE *out = fopen(argv[2], "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", argv[2]);
+            free(res);
+            return -1;
+        }
+        WriteJson(out, res, count);
+        fclose(out);
+        free(res);
+        return 0;
+    }
+    else if (strcmp(argv[1], RUN) == 0 && argc <= 3)
+    {
+        // Jeden przebieg pomiarów na standardowe wyjście, uruchamiany przez
+        // MeasureAll w osobnym procesie.
+        size_t skip_count = 0;
+        BenchResult *skip = NULL;
+        if (argc == 3 && (skip = ReadJson(argv[2], &skip_count)) == NULL)
+        {
+            fprintf(stderr, "cannot read %s\n", argv[2]);
+            return -1;
+        }
+        size_t count;
+        BenchResult *res = MeasureRun(skip, skip_count, &count);
+        WriteJson(stdout, res, count);
+        free(skip);
+        free(res);
+        return 0;
+    }
+    else if (strcmp(argv[1], COMPARE) == 0 && argc >= 3 && argc <= 5)
+    {
+        double time_tol = argc > 3 ? atof(argv[3]) : DEFAULT_TIME_TOLERANCE;
+        double alloc_tol = argc > 4 ? atof(argv[4]) : DEFAULT_ALLOC_TOLERANCE;
+        size_t base_count;
+        BenchResult *base = ReadJson(argv[2], &base_count);
+        if (base == NULL)
+        {
+            fprintf(stderr, "cannot read %s\n", argv[2]);
+            return -1;
+        }
+        size_t cur_count;
+        BenchResult *cur = MeasureAll(argv[0], NULL, &cur_count);
+        if (cur == NULL)
+        {
+            fprintf(stderr, "measurement run failed\n");
+            free(base);
+            return -1;
+        }
+        int regressions = Compare(base, base_count, cur, cur_count, NULL, 0,
+                                  time_tol / 100.0, alloc_tol / 100.0);
+        if (regressions > 0)
+        {
+            // Spadki liczymy tylko wtedy, gdy powtórzą się w drugim,
+            // niezależnym pomiarze.
+            fprintf(stderr, "%d regression(s), measuring again to confirm\n",
+                    regressions);
+            size_t confirm_count;
+            BenchResult *confirm = MeasureAll(argv[0], NULL, &confirm_count);
+            if (confirm == NULL)
+            {
+                fprintf(stderr, "measurement run failed\n");
+                free(base);
+                free(cur);
+                return -1;
+            }
+            regressions = Compare(base, base_count, confirm, confirm_count,
+                                  cur, cur_count, time_tol / 100.0, alloc_tol / 100.0);
+            free(confirm);
+        }
+        fprintf(stderr, "%d regression(s)\n", regressions);
+        free(base);
+        free(cur);
+        return regressions > 0;
+    }
+    else if (strcmp(argv[1], UPDATE) == 0 && argc == 3)
+    {
+        // Mierzymy tylko operacje i rozmiary, których brakuje w wynikach
+        // bazowych, i dopisujemy je na końcu; dotychczasowe wyniki
+        // zapisujemy bez zmian.
+        size_t base_count;
+        BenchResult *base = ReadJson(argv[2], &base_count);
+        if (base == NULL)
+        {
+            fprintf(stderr, "cannot read %s\n", argv[2]);
+            return -1;
+        }
+        size_t added_count;
+        BenchResult *added = MeasureAll(argv[0], argv[2], &added_count);
+        if (added == NULL)
+        {
+            fprintf(stderr, "measurement run failed\n");
+            free(base);
+            return -1;
+        }
+        if (added_count > 0)
+        {
+            base = realloc(base, (base_count + added_count) * sizeof(BenchResult));
+            assert(base != NULL);
+            memcpy(base + base_count, added, added_count * sizeof(BenchResult));
+            FILE *out = fopen(argv[2], "w");
+            if (out == NULL)
+            {
+                fprintf(stderr, "cannot open %s\n", argv[2]);
+                free(base);
+                free(added);
+                return -1;
+            }
+            WriteJson(out, base, base_count + added_count);
+            fclose(out);
+        }
+        fprintf(stderr, "%zu result(s) added\n", added_count);
+        free(base);
+        free(added);
+        return 0;
+    }
+    else if (strcmp(argv[1], SCALING) == 0 && argc <= 3)
+    {
+        int failed = 0;
+        bool found = false;
+        for (size_t i = 0; i < OPS; i++)
+        {
+            if (argc == 3 && strcmp(argv[2], ops[i].name) != 0)
+                continue;
+            found = true;
+            failed += !CheckScaling(&ops[i]);
+        }
+        if (!found)
+        {
+            fprintf(stderr, "unknown operation %s\n", argv[2]);
+            return -1;
+        }
+        fprintf(stderr, "%d operation(s) scale worse than expected\n", failed);
+        return failed > 0;
+    }
+    PrintHelp(argv[0]);
+    return -1;
+}
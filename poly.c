@@ -1,112 +1,19 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include <assert.h>
 
-typedef long poly_coeff_t;
-typedef int poly_exp_t;
-
-enum UnionTest {
-    SIMPLE,
-    COMPLEX,
-    ZERO
-};
-
-struct Poly;
-typedef struct Poly Poly;
-
-struct Mono;
-typedef struct Mono Mono;
-
-struct Poly {
-    enum UnionTest tag;
-    union {
-        Mono *m;
-        poly_coeff_t c;
-    } type;
-};
-
-struct Mono {
-    Poly p;
-    poly_exp_t exp;
-    struct Mono *next;
-};
-
-
-/**
- * Tworzy wielomian, który jest współczynnikiem.
- * @param[in] c : wartość współczynnika
- * @return wielomian
- */
-static inline Poly PolyFromCoeff(poly_coeff_t c)
-{
-    printf("PolyFromCoeff\n");
-    Poly p;
-    p.tag = SIMPLE;
-    p.type.c = c;
-    return p;
-}
-
-/**
- * Tworzy wielomian tożsamościowo równy zeru.
- * @return wielomian
- */
-static inline Poly PolyZero()
-{
-    printf("PolyZero\n");
-    Poly p;
-    p.tag = ZERO;
-    p.type.m = NULL;
-    return p;
-}
-
-/**
- * Tworzy jednomian `p * x^e`.
- * Przejmuje na własność zawartość struktury wskazywanej przez @p p.
- * @param[in] p : wielomian - współczynnik jednomianu
- * @param[in] e : wykładnik
- * @return jednomian `p * x^e`
- */
-static inline Mono MonoFromPoly(const Poly *p, poly_exp_t e)
-{
-    printf("MonoFromPoly\n");
-    Mono m;
-    m.exp = e;
-    m.p = *p;
-    m.next = NULL;
-    return m;
-}
-
-/**
- * Sprawdza, czy wielomian jest współczynnikiem.
- * @param[in] p : wielomian
- * @return Czy wielomian jest współczynnikiem?
- */
-static inline bool PolyIsCoeff(const Poly *p)
-{
-    printf("PolyIsCoeff\n");
-    return p->tag == SIMPLE;
-}
-
-/**
- * Sprawdza, czy wielomian jest tożsamościowo równy zeru.
- * @param[in] p : wielomian
- * @return Czy wielomian jest równy zero?
- */
-static inline bool PolyIsZero(const Poly *p)
-{
-    printf("PolyIsZero\n");
-    return ((p->tag == COMPLEX) && (p->type.m == NULL))
-            || ((p->tag == SIMPLE) && (p->type.c == 0))
-            || (p->tag == ZERO);
-}
+#ifdef POLY_TRACE
+#include "poly_untraced.h"
+#endif
+#include "poly.h"
 
 /**
  * Usuwa wielomian z pamięci.
  * @param[in] p : wielomian
  */
 void PolyDestroy(Poly *p) {
-    printf("PolyDestroy\n");
     if (!PolyIsZero(p) && !PolyIsCoeff(p)) {
         while (p->type.m != NULL) {
             Mono *tmp = p->type.m;
@@ -117,16 +24,6 @@ void PolyDestroy(Poly *p) {
     }
 }
 
-/**
- * Usuwa jednomian z pamięci.
- * @param[in] m : jednomian
- */
-static inline void MonoDestroy(Mono *m)
-{
-    printf("MonoDestroy\n");            // czy mogę założyć, że to jednomian w wielomianie (alokowany dynamicznie)??
-    PolyDestroy(&m->p);
-}
-
 /**
  * Robi pełną, głęboką kopię wielomianu.
  * @param[in] p : wielomian
@@ -134,7 +31,6 @@ static inline void MonoDestroy(Mono *m)
  */
 Poly PolyClone(const Poly *p)
 {
-    printf("PolyClone\n");
     if (PolyIsZero(p)) {
         return PolyZero();
     } else if (PolyIsCoeff(p)) {
@@ -172,466 +68,6165 @@ Poly PolyClone(const Poly *p)
 }
 
 /**
- * Robi pełną, głęboką kopię jednomianu.
- * @param[in] m : jednomian
- * @return skopiowany jednomian
+ * Tworzy jednomian `p * x^exp` będący elementem listy.
+ * Przejmuje na własność zawartość @p p.
+ * @param[in] p : współczynnik
+ * @param[in] exp : wykładnik
+ * @return zaalokowany jednomian
+ */
+static Mono *MonoNew(Poly p, poly_exp_t exp)
+{
+    Mono *m = (Mono*) malloc(sizeof(Mono));
+    assert(m != NULL);
+    m->p = p;
+    m->exp = exp;
+    m->next = NULL;
+    return m;
+}
+
+/**
+ * Tworzy wielomian z listy jednomianów o malejących wykładnikach.
+ * Pusta lista daje zero, a lista złożona z jednego jednomianu `c * x^0`,
+ * gdzie `c` jest współczynnikiem, daje współczynnik `c`.
+ * Przejmuje na własność listę @p list.
+ * @param[in] list : lista jednomianów
+ * @return wielomian
+ */
+static Poly PolyFromList(Mono *list)
+{
+    Poly p;
+    if (list == NULL) {
+        return PolyZero();
+    } else if (list->next == NULL && list->exp == 0 && PolyIsCoeff(&list->p)) {
+        p = list->p;
+        free(list);
+        return p;
+    }
+    p.tag = COMPLEX;
+    p.type.m = list;
+    return p;
+}
+
+/**
+ * Robi pełną, głęboką kopię wielomianu, zmieniając przy tym znak
+ * wszystkich współczynników, jeśli @p negate jest prawdą.
+ * @param[in] p : wielomian
+ * @param[in] negate : czy zmienić znak
+ * @return `p` lub `-p`
  */
-static inline Mono MonoClone(const Mono *m)
+static Poly PolyCloneSigned(const Poly *p, bool negate)
 {
-    printf("MonoClone\n");
-    Mono new_m;
-    new_m.exp = m->exp;
-    new_m.p = PolyClone(&m->p);
-    return new_m;
+    if (PolyIsZero(p)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        return PolyFromCoeff(negate ? -p->type.c : p->type.c);
+    } else {
+        Mono doll;
+        doll.next = NULL;
+        Mono *wanderer = &doll;
+        for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+            wanderer->next = MonoNew(PolyCloneSigned(&tmp->p, negate), tmp->exp);
+            wanderer = wanderer->next;
+        }
+        Poly p_clone;
+        p_clone.tag = COMPLEX;
+        p_clone.type.m = doll.next;
+        return p_clone;
+    }
 }
 
+/**
+ * Dodaje współczynnik do wielomianu @p p albo do `-p`.
+ * Jednomiany przechodzone są raz: te o dodatnich wykładnikach są kopiowane,
+ * a współczynnik jest dodawany (rekurencyjnie) do wyrazu wolnego, który
+ * jako ostatni na liście jest jedynym modyfikowanym jednomianem.
+ * @param[in] p : wielomian
+ * @param[in] c : współczynnik
+ * @param[in] negate : czy zmienić znak @p p
+ * @return `p + c` lub `-p + c`
+ */
+static Poly PolyAddCoeffSigned(const Poly *p, poly_coeff_t c, bool negate)
+{
+    if (PolyIsZero(p)) {
+        return c != 0 ? PolyFromCoeff(c) : PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        poly_coeff_t sum = (negate ? -p->type.c : p->type.c) + c;
+        return sum != 0 ? PolyFromCoeff(sum) : PolyZero();
+    } else if (c == 0) {
+        return PolyCloneSigned(p, negate);
+    } else {
+        Mono doll;
+        doll.next = NULL;
+        Mono *wanderer = &doll;
+        Mono *tmp = p->type.m;
+        for (; tmp != NULL && tmp->exp > 0; tmp = tmp->next) {
+            wanderer->next = MonoNew(PolyCloneSigned(&tmp->p, negate), tmp->exp);
+            wanderer = wanderer->next;
+        }
+        Poly constant = tmp != NULL ? PolyAddCoeffSigned(&tmp->p, c, negate)
+                                    : PolyFromCoeff(c);
+        if (!PolyIsZero(&constant)) {
+            wanderer->next = MonoNew(constant, 0);
+        }
+        return PolyFromList(doll.next);
+    }
+}
 
+/**
+ * Mnoży wielomian przez współczynnik.
+ * Każdy jednomian odwiedzany jest raz; jednomiany, których współczynnik
+ * stał się zerem (np. przez przepełnienie), są pomijane.
+ * @param[in] p : wielomian
+ * @param[in] c : współczynnik
+ * @return `c * p`
+ */
+static Poly PolyScaleCoeff(const Poly *p, poly_coeff_t c)
+{
+    if (c == 0 || PolyIsZero(p)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        poly_coeff_t product = p->type.c * c;
+        return product != 0 ? PolyFromCoeff(product) : PolyZero();
+    } else {
+        Mono doll;
+        doll.next = NULL;
+        Mono *wanderer = &doll;
+        for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+            Poly scaled = PolyScaleCoeff(&tmp->p, c);
+            if (!PolyIsZero(&scaled)) {
+                wanderer->next = MonoNew(scaled, tmp->exp);
+                wanderer = wanderer->next;
+            }
+        }
+        return PolyFromList(doll.next);
+    }
+}
 
 /**
- * Dodaje dwa wielomiany.
+ * Dodaje do wielomianu @p p wielomian @p q albo `-q`.
+ * Obie listy jednomianów przechodzone są raz, a współczynniki @p q
+ * negowane są w locie (także rekurencyjnie we współczynnikach), więc
+ * odejmowanie kosztuje tyle samo co dodawanie i nie tworzy kopii `-q`.
  * @param[in] p : wielomian
  * @param[in] q : wielomian
- * @return `p + q`
+ * @param[in] negate : czy odjąć @p q zamiast go dodać
+ * @return `p + q` lub `p - q`
  */
-Poly PolyAdd(const Poly *p, const Poly *q)
+static Poly PolyAddSigned(const Poly *p, const Poly *q, bool negate)
 {
-    printf("PolyAdd\n");
-    Mono *zeroexp;
-    Poly added, new;
-    if (PolyIsZero(p)) {
-        return PolyClone(q);
-    } else if (PolyIsZero(q)) {
+    Poly added;
+    if (PolyIsZero(q)) {
         return PolyClone(p);
+    } else if (PolyIsZero(p)) {
+        return PolyCloneSigned(q, negate);
     } else if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
-        if (p->type.c + p->type.c != 0) {
-            return PolyFromCoeff(p->type.c + p->type.c);
+        poly_coeff_t sum = negate ? p->type.c - q->type.c : p->type.c + q->type.c;
+        if (sum != 0) {
+            return PolyFromCoeff(sum);
         }
         else {
             return PolyZero();
         }
-    } else if (PolyIsCoeff(p) || PolyIsCoeff(q)) {
-        zeroexp = (Mono *) malloc(sizeof(Mono));
-        assert(zeroexp != NULL);
-        zeroexp->exp = 0;
-        zeroexp->next = NULL;
-        new.tag = COMPLEX;
-        new.type.m = zeroexp;
-        if (PolyIsCoeff(p)) {
-            zeroexp->p = PolyFromCoeff(p->type.c);
-            added = PolyAdd(&new, q);
-        } else {
-            zeroexp->p = PolyFromCoeff(q->type.c);
-            added = PolyAdd(&new, p);
-        }
-        PolyDestroy(&new);
-        return added;
+    } else if (PolyIsCoeff(p)) {
+        return PolyAddCoeffSigned(q, p->type.c, negate);
+    } else if (PolyIsCoeff(q)) {
+        return PolyAddCoeffSigned(p, negate ? -q->type.c : q->type.c, false);
     } else {
-        added.tag = COMPLEX;
-        Mono *doll = (Mono*) malloc(sizeof(Mono));
-        assert(doll != NULL);
-        Mono *wanderer = doll;
-        Mono *new_mono;
+        Mono doll;
+        doll.next = NULL;
+        Mono *wanderer = &doll;
         Mono *mono_p = p->type.m;
         Mono *mono_q = q->type.m;
-        while (mono_p != NULL && mono_q != NULL) {
-            if (mono_p->exp != mono_q->exp) {
-                new_mono = (Mono*) malloc(sizeof(Mono));
-                assert(new_mono != NULL);
-                new_mono->next = NULL;
-                if (mono_p->exp > mono_q->exp) {
-                    new_mono->exp = mono_p->exp;
-                    new_mono->p = PolyClone(&mono_p->p);
-                    mono_p = mono_p->next;
-                } else {  // mono_p->exp > mono_q->exp
-                    new_mono->exp = mono_q->exp;
-                    new_mono->p = PolyClone(&mono_q->p);
-                    mono_q = mono_q->next;
-                }
-                wanderer->next = new_mono;
+        while (mono_p != NULL || mono_q != NULL) {
+            if (mono_q == NULL || (mono_p != NULL && mono_p->exp > mono_q->exp)) {
+                wanderer->next = MonoNew(PolyClone(&mono_p->p), mono_p->exp);
+                wanderer = wanderer->next;
+                mono_p = mono_p->next;
+            } else if (mono_p == NULL || mono_q->exp > mono_p->exp) {
+                wanderer->next = MonoNew(PolyCloneSigned(&mono_q->p, negate),
+                                         mono_q->exp);
                 wanderer = wanderer->next;
+                mono_q = mono_q->next;
             } else { //p.exp == q.exp
-                new_mono = (Mono*) malloc(sizeof(Mono));
-                assert(new_mono != NULL);
-                new_mono->p = PolyAdd(&mono_p->p, &mono_q->p);
-                if (PolyIsZero(&new_mono->p)) {
-                    PolyDestroy(&new_mono->p);
-                    free(new_mono);
-                } else {
-                    new_mono->next = NULL;
-                    new_mono->exp = mono_p->exp;
-                    wanderer->next = new_mono;
+                added = PolyAddSigned(&mono_p->p, &mono_q->p, negate);
+                if (!PolyIsZero(&added)) {
+                    wanderer->next = MonoNew(added, mono_p->exp);
                     wanderer = wanderer->next;
                 }
                 mono_p = mono_p->next;
                 mono_q = mono_q->next;
             }
         }
-
-        if (mono_p != NULL || mono_q != NULL) {
-            while (mono_p != NULL) {
-                new_mono = (Mono*) malloc(sizeof(Mono));
-                assert(new_mono != NULL);
-                new_mono->exp = mono_p->exp;
-                new_mono->next = NULL;
-                new_mono->p = PolyClone(&mono_p->p);
-                mono_p = mono_p->next;
-            }
-            while (mono_q != NULL) {
-                new_mono = (Mono*) malloc(sizeof(Mono));
-                assert(new_mono != NULL);
-                new_mono->exp = mono_q->exp;
-                new_mono->next = NULL;
-                new_mono->p = PolyClone(&mono_q->p);
-                mono_q = mono_q->next;
-            }
-        }
-
-        added.type.m = doll->next;
-        wanderer = added.type.m;
-        free(doll);
-
-        Poly helper;
-        if (wanderer == NULL) {
-            added = PolyZero();
-        } else  { /*
-            while (wanderer->p.tag == COMPLEX &&
-                   wanderer->exp == 0 &&
-                   wanderer->next == NULL) {
-                helper = PolyAt(&added, 1);
-                PolyDestroy(&added);
-                added = helper;
-                wanderer = added.type.m;
-            } */
-            if (wanderer->p.tag == SIMPLE && wanderer->next == NULL) {
-                helper = added;
-                added = PolyFromCoeff(added.type.m->p.type.c);
-                PolyDestroy(&helper);
-            }
-        }
-        return added;
+        return PolyFromList(doll.next);
     }
 }
 
-
-poly_exp_t MonoExpComparator(const void *x1, const void *x2) {
-    printf("MonoExpComparator\n");
-    Mono *y1 = (Mono*) x1;
-    Mono *y2 = (Mono*) x2;
-    return y2->exp - y1->exp;
-}
-
-
 /**
- * Sumuje listę jednomianów i tworzy z nich wielomian.
- * Przejmuje na własność zawartość tablicy @p monos.
- * @param[in] count : liczba jednomianów
- * @param[in] monos : tablica jednomianów
- * @return wielomian będący sumą jednomianów
+ * Zmienia w miejscu znak wszystkich współczynników wielomianu.
+ * @param[in,out] p : wielomian
  */
-Poly PolyAddMonos(unsigned count, const Mono monos[])
+static void PolyNegInPlace(Poly *p)
 {
-    printf("PolyAddMonos\n");
-    Poly p;
-    Poly helper, destroyer;
-    Mono *tmp = (Mono*) monos;
-    qsort(tmp, count, sizeof(Mono), MonoExpComparator);
-    unsigned i = 0;
-    Mono *doll = (Mono*) malloc(sizeof(Mono));
-    assert(doll != NULL);
-    doll->exp = -1;
-    Mono *backer = NULL;
-    Mono *wanderer = doll;
-    Mono *newMono;
-    while (i < count) {
-        if (!PolyIsZero(&tmp[i].p)) {
-            printf("1\n");
-            if (wanderer->exp != tmp[i].exp) {
-
-                printf("2\n");
-                newMono = (Mono*) malloc(sizeof(Mono));
-                assert(newMono != NULL);
-                newMono->next = NULL;
-                newMono->exp = tmp[i].exp;
-                newMono->p = tmp[i].p;
-                wanderer->next = newMono;
-                backer = wanderer;
-                wanderer = wanderer->next;
-            }
-            else {
-                helper = PolyAdd(&wanderer->p, &tmp[i].p);
-                if (PolyIsZero(&helper)) {
-                    PolyDestroy(&wanderer->p);
-                    free(wanderer);
-                    wanderer = backer;
-                    wanderer->next = NULL;
-                } else {
-                    destroyer = wanderer->p;
-                    MonoDestroy(&tmp[i]);
-                    PolyDestroy(&destroyer);
-                    wanderer->p = helper;
-                }
-            }
-        }
-        i++;
-    }
-    wanderer = doll->next;
-    p.type.m = wanderer;
-    free(doll);
-    if (wanderer == NULL) {
-        p = PolyZero();
-    } else  {/*
-        while (wanderer->p.tag == COMPLEX &&
-               wanderer->exp == 0 &&
-               wanderer->next == NULL) {
-            helper = PolyAt(&p, 1);
-            PolyDestroy(&p);
-            p = helper;
-            wanderer = p.type.m;
-        } */
-        if (wanderer->p.tag == SIMPLE && wanderer->next == NULL) {
-            helper = p;
-            p = PolyFromCoeff(wanderer->p.type.c);
-            PolyDestroy(&helper);
+    if (PolyIsZero(p)) {
+        return;
+    } else if (PolyIsCoeff(p)) {
+        p->type.c = -p->type.c;
+    } else {
+        for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+            PolyNegInPlace(&tmp->p);
         }
     }
-    return p;
-
 }
 
-
-
 /**
- * Mnoży dwa wielomiany.
- * @param[in] p : wielomian
- * @param[in] q : wielomian
- * @return `p * q`
- *
- * */
-Poly PolyMul(const Poly *p, const Poly *q)
+ * Dodaje w miejscu współczynnik do wielomianu.
+ * Zmieniany jest tylko wyraz wolny (ostatni na liście); nowy jednomian
+ * alokowany jest tylko wtedy, gdy wyrazu wolnego nie było.
+ * @param[in,out] p : wielomian
+ * @param[in] c : współczynnik
+ */
+static void PolyAddCoeffInPlace(Poly *p, poly_coeff_t c)
 {
-    printf("PolyMul\n");
-    if (PolyIsZero(p) || PolyIsZero(q)) {
-        return PolyZero();
-    } else if (PolyIsCoeff(p) || PolyIsCoeff(q)) {
-        if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
-            return PolyFromCoeff(p->type.c * p->type.c);
-        } else {
-            Poly toMultiply;
-            Poly score;
-            Mono *zeroexp = (Mono*) malloc(sizeof(Mono));
-            assert(zeroexp != NULL);
-            zeroexp->exp = 0;
-            zeroexp->next = NULL;
-            toMultiply.tag = COMPLEX;
-            toMultiply.type.m = zeroexp;
-            if (PolyIsCoeff(p)) {
-                zeroexp->p = PolyFromCoeff(p->type.c);
-                score = PolyMul(&toMultiply, q);
-            } else {
-                zeroexp->p = PolyFromCoeff(q->type.c);
-                score = PolyMul(&toMultiply, p);
-            }
-            PolyDestroy(&toMultiply);
-            return score;
-        }
+    if (c == 0) {
+        return;
+    } else if (PolyIsZero(p)) {
+        *p = PolyFromCoeff(c);
+    } else if (PolyIsCoeff(p)) {
+        poly_coeff_t sum = p->type.c + c;
+        *p = sum != 0 ? PolyFromCoeff(sum) : PolyZero();
     } else {
-        poly_exp_t counter = 0;
-        Mono *header_p = p->type.m;
-        while (header_p != NULL) {
-            counter++;
-            header_p = header_p->next;
-        }
-        Mono *header_q = q->type.m;
-        while (header_q != NULL) {
-            counter++;
-            header_q = header_q->next;
+        Mono **link = &p->type.m;
+        while (*link != NULL && (*link)->exp > 0) {
+            link = &(*link)->next;
         }
-        Mono *monos = (Mono*) malloc(sizeof(Mono) * counter);
-        poly_exp_t i = 0;
-        header_p = p->type.m;
-        while (header_p != NULL) {
-            header_q = q->type.m;
-            while (header_q != NULL) {
-                monos[i].exp = header_p->exp + header_q->exp;
-                monos[i].next = NULL;
-                monos[i].p = PolyMul(&header_p->p, &header_q->p);
-                i++;
+        if (*link == NULL) {
+            *link = MonoNew(PolyFromCoeff(c), 0);
+        } else {
+            PolyAddCoeffInPlace(&(*link)->p, c);
+            if (PolyIsZero(&(*link)->p)) {
+                free(*link);
+                *link = NULL;
             }
-            header_p = header_p->next;
         }
-        Poly score2 = PolyAddMonos((unsigned)counter, monos);
-        free(monos);
-        return score2;
+        *p = PolyFromList(p->type.m);
     }
 }
 
 /**
- * Zwraca przeciwny wielomian.
- * @param[in] p : wielomian
- * @return `-p`
+ * Mnoży w miejscu wielomian przez współczynnik.
+ * Jednomiany, których współczynnik stał się zerem, są zwalniane.
+ * @param[in,out] p : wielomian
+ * @param[in] c : współczynnik
  */
-Poly PolyNeg(const Poly *p)
+static void PolyScaleInPlace(Poly *p, poly_coeff_t c)
 {
-    printf("PolyNeg\n");
     if (PolyIsZero(p)) {
-        return PolyZero();
+        return;
+    } else if (c == 0) {
+        PolyDestroy(p);
+        *p = PolyZero();
     } else if (PolyIsCoeff(p)) {
-        return PolyFromCoeff(p->type.c * (-1));
+        poly_coeff_t product = p->type.c * c;
+        *p = product != 0 ? PolyFromCoeff(product) : PolyZero();
     } else {
-        Poly p_neg;
-        p_neg.tag = p->tag;
-        Mono *tmp = p->type.m;
-        Mono *start = (Mono*) malloc(sizeof(Mono));
-        assert(start != NULL);
-        start->exp = tmp->exp;
-        start->next = NULL;
-        Mono *wanderer = start;
-        Mono *helper;
-        tmp = tmp->next;
-        while (tmp != NULL) {
-            helper = (Mono*) malloc(sizeof(Mono));
-            assert(helper != NULL);
-            helper->next = NULL;
-            helper->exp = tmp->exp;
-            wanderer->next = helper;
-            wanderer = helper;
-            tmp = tmp->next;
+        Mono **link = &p->type.m;
+        while (*link != NULL) {
+            Mono *tmp = *link;
+            PolyScaleInPlace(&tmp->p, c);
+            if (PolyIsZero(&tmp->p)) {
+                *link = tmp->next;
+                free(tmp);
+            } else {
+                link = &tmp->next;
+            }
         }
-        wanderer = start;
-        tmp = p->type.m;
-        while (wanderer != NULL) {
-            wanderer->p = PolyClone(&tmp->p);
-            wanderer = wanderer->next;
-            tmp = tmp->next;
+        *p = PolyFromList(p->type.m);
+    }
+}
+
+/**
+ * Dodaje w miejscu do wielomianu @p p wielomian @p q albo `-q`.
+ * Obie listy przechodzone są raz. Przy równych wykładnikach współczynniki
+ * są sumowane rekurencyjnie w miejscu, a jednomiany, których wykładników
+ * nie ma w @p p, są wstawiane do listy @p p: jeśli @p take jest prawdą,
+ * są to jednomiany @p q wpięte bez kopiowania (wtedy po wywołaniu @p q jest
+ * zerem), a w przeciwnym razie ich kopie, a @p q pozostaje niezmieniony.
+ * Dopuszczalne jest @p p równe @p q (np. `p += p`).
+ * @param[in,out] p : wielomian
+ * @param[in,out] q : wielomian
+ * @param[in] negate : czy odjąć @p q zamiast go dodać
+ * @param[in] take : czy przejąć @p q
+ */
+static void PolyAddInPlace(Poly *p, Poly *q, bool negate, bool take)
+{
+    if (p == q) {
+        PolyScaleInPlace(p, negate ? 0 : 2);
+    } else if (PolyIsZero(q)) {
+        return;
+    } else if (PolyIsZero(p)) {
+        if (!take) {
+            *p = PolyCloneSigned(q, negate);
+            return;
+        }
+        if (negate) {
+            PolyNegInPlace(q);
         }
-        p_neg.type.m = start;
-        return p_neg;
+        *p = *q;
+    } else if (PolyIsCoeff(q)) {
+        PolyAddCoeffInPlace(p, negate ? -q->type.c : q->type.c);
+    } else if (PolyIsCoeff(p)) {
+        poly_coeff_t c = p->type.c;
+        if (take) {
+            *p = *q;
+            if (negate) {
+                PolyNegInPlace(p);
+            }
+        } else {
+            *p = PolyCloneSigned(q, negate);
+        }
+        PolyAddCoeffInPlace(p, c);
+    } else {
+        Mono **link = &p->type.m;
+        Mono *mono_q = q->type.m;
+        while (mono_q != NULL) {
+            Mono *mono_p = *link;
+            Mono *next = mono_q->next;
+            if (mono_p != NULL && mono_p->exp > mono_q->exp) {
+                link = &mono_p->next;
+                continue;
+            } else if (mono_p == NULL || mono_q->exp > mono_p->exp) {
+                Mono *inserted = mono_q;
+                if (!take) {
+                    inserted = MonoNew(PolyCloneSigned(&mono_q->p, negate),
+                                       mono_q->exp);
+                } else if (negate) {
+                    PolyNegInPlace(&mono_q->p);
+                }
+                inserted->next = mono_p;
+                *link = inserted;
+                link = &inserted->next;
+            } else { //p.exp == q.exp
+                PolyAddInPlace(&mono_p->p, &mono_q->p, negate, take);
+                if (take) {
+                    free(mono_q);
+                }
+                if (PolyIsZero(&mono_p->p)) {
+                    *link = mono_p->next;
+                    free(mono_p);
+                } else {
+                    link = &mono_p->next;
+                }
+            }
+            mono_q = next;
+        }
+        *p = PolyFromList(p->type.m);
+    }
+    if (take) {
+        *q = PolyZero();
     }
 }
 
 /**
- * Odejmuje wielomian od wielomianu.
+ * Dodaje dwa wielomiany.
  * @param[in] p : wielomian
  * @param[in] q : wielomian
- * @return `p - q`
+ * @return `p + q`
  */
-Poly PolySub(const Poly *p, const Poly *q)
+Poly PolyAdd(const Poly *p, const Poly *q)
 {
-    printf("PolySub\n");
-    Poly q_neg = PolyNeg(q);
-    Poly subbed = PolyAdd(p, &q_neg);
-    PolyDestroy(&q_neg);
-    return subbed;
+    return PolyAddSigned(p, q, false);
 }
 
 /**
- * Zwraca stopień wielomianu ze względu na zadaną zmienną (-1 dla wielomianu
- * tożsamościowo równego zeru).
- * Zmienne indeksowane są od 0.
- * Zmienna o indeksie 0 oznacza zmienną główną tego wielomianu.
- * Większe indeksy oznaczają zmienne wielomianów znajdujących się
- * we współczynnikach.
+ * Mnoży wielomian przez współczynnik.
  * @param[in] p : wielomian
- * @param[in] var_idx : indeks zmiennej
- * @return stopień wielomianu @p p z względu na zmienną o indeksie @p var_idx
+ * @param[in] c : współczynnik
+ * @return `c * p`
  */
-poly_exp_t PolyDegBy(const Poly *p, unsigned var_idx)
+Poly PolyScale(const Poly *p, poly_coeff_t c)
 {
-    printf("PolyDegBy\n");
-    if (PolyIsZero(p)) {
-        return -1;
-    }
-    else if (var_idx == 0) {
-        return p->type.m->exp;
-    }
-    else {
-        poly_exp_t deg = -2;
-        poly_exp_t y;
-        Mono *helper = p->type.m;
-        while (helper != NULL) {
-            y = PolyDegBy(&helper->p, var_idx - 1);
-            if (y > deg) {
-                deg = y;
-            }
-            helper = helper->next;
-        }
-        return deg;
-    }
+    return PolyScaleCoeff(p, c);
 }
 
 /**
- * Zwraca stopień wielomianu (-1 dla wielomianu tożsamościowo równego zeru).
+ * Dodaje współczynnik do wielomianu.
  * @param[in] p : wielomian
- * @return stopień wielomianu @p p
+ * @param[in] c : współczynnik
+ * @return `p + c`
  */
-poly_exp_t PolyDeg(const Poly *p)
+Poly PolyAddCoeff(const Poly *p, poly_coeff_t c)
+{
+    return PolyAddCoeffSigned(p, c, false);
+}
+
+/**
+ * Aktualna głowa jednej z łączonych list jednomianów.
+ */
+typedef struct MergeHead {
+    const Mono *m; ///< pierwszy nieprzetworzony jednomian listy
+    poly_coeff_t weight; ///< waga wielomianu, z którego pochodzi lista
+    unsigned index; ///< numer wielomianu, z którego pochodzi lista
+} MergeHead;
+
+/**
+ * Przywraca własność kopca (największy wykładnik na szczycie), przesuwając
+ * element @p i w dół.
+ * @param[in,out] heap : kopiec
+ * @param[in] size : liczba elementów kopca
+ * @param[in] i : indeks przesuwanego elementu
+ */
+static void MergeHeapSiftDown(MergeHead heap[], unsigned size, unsigned i)
+{
+    MergeHead moved = heap[i];
+    while (2 * i + 1 < size) {
+        unsigned child = 2 * i + 1;
+        if (child + 1 < size && heap[child + 1].m->exp > heap[child].m->exp) {
+            child++;
+        }
+        if (heap[child].m->exp <= moved.m->exp) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = moved;
+}
+
+/**
+ * Sumuje wielomiany @p polys z wagami @p weights.
+ * Wszystkie listy jednomianów łączone są naraz: głowy list trzymane są
+ * w kopcu według wykładników, a współczynniki przy tym samym wykładniku
+ * sumowane są rekurencyjnie tą samą metodą. Koszt to
+ * O(łączna liczba jednomianów * log @p count).
+ * @param[in] count : liczba wielomianów
+ * @param[in] polys : wielomiany
+ * @param[in] weights : wagi (NULL oznacza same jedynki)
+ * @return `weights[0] * polys[0] + ... + weights[count-1] * polys[count-1]`
+ */
+static Poly PolyAddManyWeighted(unsigned count, const Poly *polys[],
+                                const poly_coeff_t weights[])
+{
+    poly_coeff_t constant = 0;
+    unsigned size = 0;
+    MergeHead *heap = (MergeHead*) malloc(sizeof(MergeHead) * (count + 1));
+    assert(heap != NULL);
+    for (unsigned i = 0; i < count; i++) {
+        poly_coeff_t weight = weights != NULL ? weights[i] : 1;
+        if (weight == 0 || PolyIsZero(polys[i])) {
+            continue;
+        } else if (PolyIsCoeff(polys[i])) {
+            constant += weight * polys[i]->type.c;
+        } else {
+            heap[size].m = polys[i]->type.m;
+            heap[size].weight = weight;
+            size++;
+        }
+    }
+    if (size == 0) {
+        free(heap);
+        return constant != 0 ? PolyFromCoeff(constant) : PolyZero();
+    }
+    for (unsigned i = size / 2; i-- > 0;) {
+        MergeHeapSiftDown(heap, size, i);
+    }
+    const Poly **group = (const Poly**) malloc(sizeof(Poly*) * (size + 1));
+    poly_coeff_t *group_weights = (poly_coeff_t*) malloc(sizeof(poly_coeff_t) * (size + 1));
+    assert(group != NULL && group_weights != NULL);
+    Poly constant_poly = PolyFromCoeff(constant);
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    while (size > 0) {
+        poly_exp_t exp = heap[0].m->exp;
+        unsigned group_size = 0;
+        while (size > 0 && heap[0].m->exp == exp) {
+            group[group_size] = &heap[0].m->p;
+            group_weights[group_size] = heap[0].weight;
+            group_size++;
+            heap[0].m = heap[0].m->next;
+            if (heap[0].m == NULL) {
+                heap[0] = heap[--size];
+            }
+            if (size > 0) {
+                MergeHeapSiftDown(heap, size, 0);
+            }
+        }
+        if (exp == 0 && constant != 0) {
+            group[group_size] = &constant_poly;
+            group_weights[group_size] = 1;
+            group_size++;
+            constant = 0;
+        }
+        bool coeffs_only = true;
+        poly_coeff_t coeff_sum = 0;
+        for (unsigned i = 0; i < group_size && coeffs_only; i++) {
+            coeffs_only = PolyIsCoeff(group[i]);
+            if (coeffs_only) {
+                coeff_sum += group_weights[i] * group[i]->type.c;
+            }
+        }
+        Poly sum;
+        if (coeffs_only) {
+            sum = coeff_sum != 0 ? PolyFromCoeff(coeff_sum) : PolyZero();
+        } else if (group_size == 1 && group_weights[0] == 1) {
+            sum = PolyClone(group[0]);
+        } else if (group_size == 1) {
+            sum = PolyScaleCoeff(group[0], group_weights[0]);
+        } else {
+            sum = PolyAddManyWeighted(group_size, group, group_weights);
+        }
+        if (!PolyIsZero(&sum)) {
+            wanderer->next = MonoNew(sum, exp);
+            wanderer = wanderer->next;
+        }
+    }
+    if (constant != 0) {
+        wanderer->next = MonoNew(constant_poly, 0);
+    }
+    free(heap);
+    free(group);
+    free(group_weights);
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Sumuje wielomiany, opcjonalnie z wagami (kombinacja liniowa).
+ * Wszystkie wielomiany łączone są naraz, bez sum pośrednich.
+ * @param[in] count : liczba wielomianów
+ * @param[in] polys : tablica wielomianów
+ * @param[in] weights : tablica wag albo NULL (wszystkie wagi równe 1)
+ * @return `weights[0] * polys[0] + ... + weights[count-1] * polys[count-1]`
+ */
+Poly PolyAddMany(unsigned count, const Poly polys[], const poly_coeff_t weights[])
+{
+    const Poly **pointers = (const Poly**) malloc(sizeof(Poly*) * (count + 1));
+    assert(pointers != NULL);
+    for (unsigned i = 0; i < count; i++) {
+        pointers[i] = &polys[i];
+    }
+    Poly sum = PolyAddManyWeighted(count, pointers, weights);
+    free(pointers);
+    return sum;
+}
+
+
+/**
+ * Odwraca kolejność jednomianów w tablicy.
+ * @param[in,out] monos : tablica jednomianów
+ * @param[in] count : liczba jednomianów
+ */
+static void MonosReverse(Mono *monos, unsigned count)
+{
+    for (unsigned i = 0, j = count; i + 1 < j; i++, j--) {
+        Mono tmp = monos[i];
+        monos[i] = monos[j - 1];
+        monos[j - 1] = tmp;
+    }
+}
+
+/**
+ * Sortuje jednomiany malejąco po wykładnikach przez wstawianie.
+ * Używane dla krótkich tablic.
+ * @param[in,out] monos : tablica jednomianów
+ * @param[in] count : liczba jednomianów
+ */
+static void MonosInsertionSort(Mono *monos, unsigned count)
+{
+    for (unsigned i = 1; i < count; i++) {
+        Mono tmp = monos[i];
+        unsigned j = i;
+        while (j > 0 && monos[j - 1].exp < tmp.exp) {
+            monos[j] = monos[j - 1];
+            j--;
+        }
+        monos[j] = tmp;
+    }
+}
+
+/** Liczba bitów wykładnika sortowana w jednym przebiegu sortowania pozycyjnego */
+#define RADIX_BITS 8
+
+/** Liczba kubełków w jednym przebiegu sortowania pozycyjnego */
+#define RADIX_SIZE (1u << RADIX_BITS)
+
+/**
+ * Sortuje jednomiany malejąco po wykładnikach sortowaniem pozycyjnym (LSD),
+ * po RADIX_BITS bitów wykładnika na przebieg. Przebiegów jest tyle, ile
+ * cyfr ma największy wykładnik, a przebiegi, w których wszystkie
+ * jednomiany mają tę samą cyfrę, są pomijane.
+ * @param[in,out] monos : tablica jednomianów
+ * @param[in] count : liczba jednomianów
+ * @param[in] max_exp : największy wykładnik w tablicy
+ */
+static void MonosRadixSort(Mono *monos, unsigned count, poly_exp_t max_exp)
+{
+    Mono *buffer = (Mono*) malloc(sizeof(Mono) * count);
+    assert(buffer != NULL);
+    Mono *from = monos;
+    Mono *to = buffer;
+    for (unsigned shift = 0; shift < sizeof(poly_exp_t) * 8
+                             && ((unsigned) max_exp >> shift) != 0;
+         shift += RADIX_BITS) {
+        unsigned counts[RADIX_SIZE] = {0};
+        for (unsigned i = 0; i < count; i++) {
+            counts[((unsigned) from[i].exp >> shift) & (RADIX_SIZE - 1)]++;
+        }
+        if (counts[((unsigned) from[0].exp >> shift) & (RADIX_SIZE - 1)] == count) {
+            continue;
+        }
+        // Kubełki o większych cyfrach trafiają na początek.
+        unsigned position = 0;
+        for (unsigned digit = RADIX_SIZE; digit-- > 0;) {
+            unsigned size = counts[digit];
+            counts[digit] = position;
+            position += size;
+        }
+        for (unsigned i = 0; i < count; i++) {
+            to[counts[((unsigned) from[i].exp >> shift) & (RADIX_SIZE - 1)]++] = from[i];
+        }
+        Mono *swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from != monos) {
+        for (unsigned i = 0; i < count; i++) {
+            monos[i] = from[i];
+        }
+    }
+    free(buffer);
+}
+
+/** Długość tablicy, do której jednomiany sortowane są przez wstawianie */
+#define INSERTION_SORT_MAX 16
+
+/**
+ * Sprawdza jednym przejściem, czy tablica jest posortowana malejąco lub
+ * rosnąco po wykładnikach (w drugim przypadku odwraca ją) i wyznacza
+ * najmniejszy i największy wykładnik.
+ * @param[in,out] monos : niepusta tablica jednomianów
+ * @param[in] count : liczba jednomianów
+ * @param[out] min_exp : najmniejszy wykładnik
+ * @param[out] max_exp : największy wykładnik
+ * @return czy tablica jest teraz posortowana malejąco
+ */
+static bool MonosOrderRun(Mono *monos, unsigned count,
+                          poly_exp_t *min_exp, poly_exp_t *max_exp)
+{
+    bool descending = true, ascending = true;
+    *min_exp = *max_exp = monos[0].exp;
+    for (unsigned i = 1; i < count; i++) {
+        descending &= monos[i - 1].exp >= monos[i].exp;
+        ascending &= monos[i - 1].exp <= monos[i].exp;
+        if (monos[i].exp > *max_exp) {
+            *max_exp = monos[i].exp;
+        } else if (monos[i].exp < *min_exp) {
+            *min_exp = monos[i].exp;
+        }
+    }
+    if (!descending && ascending) {
+        MonosReverse(monos, count);
+    }
+    return descending || ascending;
+}
+
+/**
+ * Sortuje jednomiany malejąco po wykładnikach.
+ * Tablica już posortowana malejąco lub rosnąco rozpoznawana jest jednym
+ * przejściem (w drugim przypadku jest tylko odwracana), krótkie tablice
+ * sortowane są przez wstawianie, a pozostałe sortowaniem pozycyjnym.
+ * @param[in,out] monos : tablica jednomianów
+ * @param[in] count : liczba jednomianów
+ */
+static void MonosSort(Mono *monos, unsigned count)
+{
+    poly_exp_t min_exp, max_exp;
+    if (count == 0 || MonosOrderRun(monos, count, &min_exp, &max_exp)) {
+        return;
+    } else if (count <= INSERTION_SORT_MAX) {
+        MonosInsertionSort(monos, count);
+    } else {
+        MonosRadixSort(monos, count, max_exp);
+    }
+}
+
+/** Oznaczenie pustego miejsca w akumulatorze jednomianów */
+#define ACC_EMPTY (-1)
+
+/**
+ * Akumulator jednomianów: sumuje współczynniki jednomianów o równych
+ * wykładnikach bez sortowania wszystkich jednomianów.
+ * W trybie bezpośrednim jednomian o wykładniku `e` trafia na miejsce
+ * `e - min_exp`, a w przeciwnym razie do tablicy haszującej z adresowaniem
+ * otwartym (próbkowanie liniowe), powiększanej dwukrotnie, gdy zapełni się
+ * w połowie. Sortowane są dopiero różne wykładniki przy tworzeniu wyniku.
+ */
+typedef struct MonoAcc {
+    Mono *slots; ///< miejsca; wolne mają wykładnik ACC_EMPTY
+    unsigned size; ///< liczba miejsc (w tablicy haszującej potęga dwójki)
+    unsigned used; ///< liczba zajętych miejsc
+    poly_exp_t min_exp; ///< najmniejszy wykładnik w trybie bezpośrednim
+    bool direct; ///< czy tryb bezpośredni
+} MonoAcc;
+
+/** Najmniejszy rozmiar tablicy haszującej akumulatora */
+#define ACC_MIN_SIZE 16
+
+/**
+ * Alokuje @p size wolnych miejsc akumulatora.
+ */
+static Mono *MonoAccSlots(unsigned size)
+{
+    Mono *slots = (Mono*) malloc(sizeof(Mono) * size);
+    assert(slots != NULL);
+    for (unsigned i = 0; i < size; i++) {
+        slots[i].exp = ACC_EMPTY;
+    }
+    return slots;
+}
+
+/**
+ * Inicjuje akumulator w trybie bezpośrednim dla wykładników
+ * z przedziału [@p min_exp, @p max_exp].
+ * @param[out] acc : akumulator
+ * @param[in] min_exp : najmniejszy wykładnik
+ * @param[in] max_exp : największy wykładnik
+ */
+static void MonoAccInitDirect(MonoAcc *acc, poly_exp_t min_exp, poly_exp_t max_exp)
+{
+    acc->size = (unsigned) (max_exp - min_exp) + 1;
+    acc->slots = MonoAccSlots(acc->size);
+    acc->used = 0;
+    acc->min_exp = min_exp;
+    acc->direct = true;
+}
+
+/**
+ * Inicjuje akumulator z tablicą haszującą.
+ * @param[out] acc : akumulator
+ * @param[in] expected : spodziewana liczba różnych wykładników
+ */
+static void MonoAccInitHash(MonoAcc *acc, unsigned long expected)
+{
+    unsigned size = ACC_MIN_SIZE;
+    while (size < 2 * expected && size < (1u << 30)) {
+        size *= 2;
+    }
+    acc->size = size;
+    acc->slots = MonoAccSlots(size);
+    acc->used = 0;
+    acc->min_exp = 0;
+    acc->direct = false;
+}
+
+/**
+ * Zwraca miejsce dla wykładnika @p exp w tablicy haszującej
+ * (zajęte przez ten wykładnik albo wolne).
+ */
+static Mono *MonoAccFind(Mono *slots, unsigned size, poly_exp_t exp)
+{
+    unsigned i = ((unsigned) exp * 2654435769u) & (size - 1);
+    while (slots[i].exp != ACC_EMPTY && slots[i].exp != exp) {
+        i = (i + 1) & (size - 1);
+    }
+    return &slots[i];
+}
+
+/**
+ * Dwukrotnie powiększa tablicę haszującą akumulatora.
+ * @param[in,out] acc : akumulator
+ */
+static void MonoAccGrow(MonoAcc *acc)
+{
+    Mono *old = acc->slots;
+    unsigned old_size = acc->size;
+    acc->size *= 2;
+    acc->slots = MonoAccSlots(acc->size);
+    for (unsigned i = 0; i < old_size; i++) {
+        if (old[i].exp != ACC_EMPTY) {
+            *MonoAccFind(acc->slots, acc->size, old[i].exp) = old[i];
+        }
+    }
+    free(old);
+}
+
+/**
+ * Dodaje jednomian `p * x^exp` do akumulatora.
+ * Przejmuje na własność zawartość @p p.
+ * @param[in,out] acc : akumulator
+ * @param[in,out] p : współczynnik
+ * @param[in] exp : wykładnik
+ */
+static void MonoAccAdd(MonoAcc *acc, Poly *p, poly_exp_t exp)
 {
-    printf("PolyDeg\n");
     if (PolyIsZero(p)) {
-        return -1;
+        return;
     }
-    else if (PolyIsCoeff(p)) {
-        return 0;
+    Mono *slot;
+    if (acc->direct) {
+        slot = &acc->slots[exp - acc->min_exp];
+    } else {
+        if (2 * (acc->used + 1) > acc->size) {
+            MonoAccGrow(acc);
+        }
+        slot = MonoAccFind(acc->slots, acc->size, exp);
     }
-    else {
-        return p->type.m->exp;
+    if (slot->exp == ACC_EMPTY) {
+        slot->exp = exp;
+        slot->p = *p;
+        acc->used++;
+    } else {
+        PolyAddInPlace(&slot->p, p, false, true);
     }
 }
 
 /**
- * Sprawdza równość dwóch wielomianów.
- * @param[in] p : wielomian
- * @param[in] q : wielomian
- * @return `p = q`
+ * Tworzy wielomian z zawartości akumulatora i zwalnia akumulator.
+ * @param[in,out] acc : akumulator
+ * @return suma dodanych jednomianów
  */
-bool PolyIsEq(const Poly *p, const Poly *q)
+static Poly MonoAccFinish(MonoAcc *acc)
 {
-    printf("PolyIsEq\n");
-    if (PolyIsZero(p) || PolyIsZero(q)) {
-        return PolyIsZero(p) && PolyIsZero(q);
-    } else if (PolyIsCoeff(p) || PolyIsCoeff(q)) {
-        if (!(PolyIsCoeff(p) && PolyIsCoeff(q))) {
-            return false;
-        } else {
-            return p->type.c == q->type.c;
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    unsigned count = 0;
+    if (!acc->direct) {
+        for (unsigned i = 0; i < acc->size; i++) {
+            if (acc->slots[i].exp != ACC_EMPTY) {
+                acc->slots[count++] = acc->slots[i];
+            }
         }
+        MonosSort(acc->slots, count);
     } else {
-        bool isEq = true;
-        Mono *tmp_p = p->type.m;
-        Mono *tmp_q = q->type.m;
-        while (tmp_p != NULL && tmp_q != NULL) {
-            if (tmp_p->exp != tmp_q->exp) {
-                return false;
+        // Miejsca są uporządkowane rosnąco, więc wystarczy je odwrócić.
+        MonosReverse(acc->slots, acc->size);
+        count = acc->size;
+    }
+    for (unsigned i = 0; i < count; i++) {
+        Mono *slot = &acc->slots[i];
+        if (slot->exp != ACC_EMPTY && !PolyIsZero(&slot->p)) {
+            wanderer->next = MonoNew(slot->p, slot->exp);
+            wanderer = wanderer->next;
+        }
+    }
+    free(acc->slots);
+    return PolyFromList(doll.next);
+}
+
+/** Liczba jednomianów, od której PolyAddMonos szacuje liczbę powtórzeń */
+#define ACC_SAMPLE_MIN_COUNT 1024
+
+/** Liczba próbek przy szacowaniu liczby powtórzeń */
+#define ACC_SAMPLE 256
+
+/**
+ * Szacuje, czy w tablicy jest mało różnych wykładników: sprawdza
+ * ACC_SAMPLE równomiernie rozłożonych jednomianów i uznaje, że powtórzeń
+ * jest dużo, jeśli wśród nich jest co najwyżej ACC_SAMPLE / 4 różnych
+ * wykładników.
+ * @param[in] monos : tablica jednomianów
+ * @param[in] count : liczba jednomianów
+ * @return czy opłaca się sumować przez tablicę haszującą
+ */
+static bool MonosFewDistinct(const Mono *monos, unsigned count)
+{
+    if (count < ACC_SAMPLE_MIN_COUNT) {
+        return false;
+    }
+    poly_exp_t seen[2 * ACC_SAMPLE];
+    for (unsigned i = 0; i < 2 * ACC_SAMPLE; i++) {
+        seen[i] = ACC_EMPTY;
+    }
+    unsigned distinct = 0;
+    for (unsigned k = 0; k < ACC_SAMPLE; k++) {
+        poly_exp_t exp = monos[(unsigned long) k * count / ACC_SAMPLE].exp;
+        unsigned i = ((unsigned) exp * 2654435769u) & (2 * ACC_SAMPLE - 1);
+        while (seen[i] != ACC_EMPTY && seen[i] != exp) {
+            i = (i + 1) & (2 * ACC_SAMPLE - 1);
+        }
+        if (seen[i] == ACC_EMPTY) {
+            seen[i] = exp;
+            distinct++;
+        }
+    }
+    return distinct <= ACC_SAMPLE / 4;
+}
+
+/**
+ * Sumuje listę jednomianów i tworzy z nich wielomian.
+ * Przejmuje na własność zawartość tablicy @p monos.
+ * Tablica już uporządkowana jest tylko przeglądana. W przeciwnym razie,
+ * jeśli wykładników jest mało w stosunku do liczby jednomianów (przedział
+ * wykładników jest krótszy niż tablica albo próbka wskazuje na dużo
+ * powtórzeń), jednomiany sumowane są w akumulatorze, a jeśli nie, tablica
+ * jest sortowana. Jednomiany o równych wykładnikach sumowane są w miejscu.
+ * @param[in] count : liczba jednomianów
+ * @param[in] monos : tablica jednomianów
+ * @return wielomian będący sumą jednomianów
+ */
+Poly PolyAddMonos(unsigned count, const Mono monos[])
+{
+    Mono *tmp = (Mono*) monos;
+    poly_exp_t min_exp, max_exp;
+    if (count == 0) {
+        return PolyZero();
+    } else if (!MonosOrderRun(tmp, count, &min_exp, &max_exp)) {
+        bool dense = (unsigned long) (max_exp - min_exp) < count;
+        if (dense || MonosFewDistinct(tmp, count)) {
+            MonoAcc acc;
+            if (dense) {
+                MonoAccInitDirect(&acc, min_exp, max_exp);
             } else {
-                isEq = PolyIsEq(&tmp_p->p, &tmp_q->p);
-                if (isEq == false) {                          //warunek chyba ok?
-                    return false;
-                }
+                MonoAccInitHash(&acc, ACC_SAMPLE);
             }
-            tmp_p = tmp_p->next;
-            tmp_q = tmp_q->next;
+            for (unsigned i = 0; i < count; i++) {
+                MonoAccAdd(&acc, &tmp[i].p, tmp[i].exp);
+            }
+            return MonoAccFinish(&acc);
+        } else if (count <= INSERTION_SORT_MAX) {
+            MonosInsertionSort(tmp, count);
+        } else {
+            MonosRadixSort(tmp, count, max_exp);
         }
-        if (!(tmp_q == NULL && tmp_p == NULL)) {
-            return false;
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    unsigned i = 0;
+    while (i < count) {
+        Poly sum = tmp[i].p;
+        poly_exp_t exp = tmp[i].exp;
+        for (i++; i < count && tmp[i].exp == exp; i++) {
+            PolyAddInPlace(&sum, &tmp[i].p, false, true);
+        }
+        if (!PolyIsZero(&sum)) {
+            wanderer->next = MonoNew(sum, exp);
+            wanderer = wanderer->next;
         }
-        return isEq;
     }
+    return PolyFromList(doll.next);
 }
 
 /**
- * Wylicza wartość wielomianu w punkcie @p x.
- * Wstawia pod pierwszą zmienną wielomianu wartość @p x.
- * W wyniku może powstać wielomian, jeśli współczynniki są wielomianem
- * i zmniejszane są indeksy zmiennych w takim wielomianie o jeden.
- * Formalnie dla wielomianu @f$p(x_0, x_1, x_2, \ldots)@f$ wynikiem jest
- * wielomian @f$p(x, x_0, x_1, \ldots)@f$.
- * @param[in] p
- * @param[in] x
- * @return @f$p(x, x_0, x_1, \ldots)@f$
-*/
-Poly PolyAt(const Poly *p, poly_coeff_t x)
+ * Inicjuje pustego budowniczego wielomianu.
+ * @param[out] b : budowniczy
+ */
+void PolyBuilderInit(PolyBuilder *b)
 {
-    printf("PolyAt\n");
-    Poly m;
-    return m;
-}
\ No newline at end of file
+    b->head = NULL;
+    b->tail = NULL;
+    b->spare = NULL;
+}
+
+/**
+ * Rezerwuje miejsce na @p capacity kolejnych jednomianów, żeby
+ * dołączanie ich nie alokowało pamięci.
+ * @param[in,out] b : budowniczy
+ * @param[in] capacity : liczba jednomianów
+ */
+void PolyBuilderReserve(PolyBuilder *b, unsigned capacity)
+{
+    for (Mono *tmp = b->spare; tmp != NULL && capacity > 0; tmp = tmp->next) {
+        capacity--;
+    }
+    while (capacity-- > 0) {
+        Mono *m = (Mono*) malloc(sizeof(Mono));
+        assert(m != NULL);
+        m->next = b->spare;
+        b->spare = m;
+    }
+}
+
+/**
+ * Dołącza jednomian `p * x^exp` na koniec budowanego wielomianu.
+ * Wykładnik musi być mniejszy od wykładnika poprzednio dołączonego
+ * jednomianu (sprawdzane tylko asercją). Zerowy współczynnik jest pomijany.
+ * Przejmuje na własność zawartość @p p.
+ * @param[in,out] b : budowniczy
+ * @param[in] exp : wykładnik
+ * @param[in] p : współczynnik
+ */
+void PolyBuilderAppend(PolyBuilder *b, poly_exp_t exp, const Poly *p)
+{
+    assert(b->tail == NULL || exp < b->tail->exp);
+    if (PolyIsZero(p)) {
+        return;
+    }
+    Mono *m = b->spare;
+    if (m != NULL) {
+        b->spare = m->next;
+        m->p = *p;
+        m->exp = exp;
+        m->next = NULL;
+    } else {
+        m = MonoNew(*p, exp);
+    }
+    if (b->tail == NULL) {
+        b->head = m;
+    } else {
+        b->tail->next = m;
+    }
+    b->tail = m;
+}
+
+/**
+ * Dołącza jednomian `c * x^exp` na koniec budowanego wielomianu.
+ * @param[in,out] b : budowniczy
+ * @param[in] exp : wykładnik
+ * @param[in] c : współczynnik
+ */
+void PolyBuilderAppendCoeff(PolyBuilder *b, poly_exp_t exp, poly_coeff_t c)
+{
+    Poly p = PolyFromCoeff(c);
+    PolyBuilderAppend(b, exp, &p);
+}
+
+/**
+ * Kończy budowanie i zwraca wielomian złożony z dołączonych jednomianów.
+ * Zwalnia niewykorzystane zarezerwowane jednomiany; budowniczy jest potem
+ * pusty i można go użyć ponownie.
+ * @param[in,out] b : budowniczy
+ * @return zbudowany wielomian
+ */
+Poly PolyBuilderFinish(PolyBuilder *b)
+{
+    while (b->spare != NULL) {
+        Mono *tmp = b->spare;
+        b->spare = tmp->next;
+        free(tmp);
+    }
+    Poly p = PolyFromList(b->head);
+    b->head = NULL;
+    b->tail = NULL;
+    return p;
+}
+
+
+
+/**
+ * Tworzy wielomian z tablicy współczynników o @p dims wymiarach.
+ * @param[in] dims : liczba wymiarów (zmiennych)
+ * @param[in] sizes : rozmiary kolejnych wymiarów
+ * @param[in] strides : odstępy (w elementach) między kolejnymi elementami
+ * w kolejnych wymiarach
+ * @param[in] coeffs : element o indeksach równych zero
+ * @return wielomian
+ */
+static Poly PolyFromTensor(unsigned dims, const unsigned sizes[],
+                           const ptrdiff_t strides[], const poly_coeff_t *coeffs)
+{
+    if (dims == 0) {
+        return *coeffs != 0 ? PolyFromCoeff(*coeffs) : PolyZero();
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (unsigned i = sizes[0]; i-- > 0;) {
+        Poly c = PolyFromTensor(dims - 1, sizes + 1, strides + 1,
+                                coeffs + (ptrdiff_t) i * strides[0]);
+        if (!PolyIsZero(&c)) {
+            wanderer->next = MonoNew(c, (poly_exp_t) i);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Zeruje tablicę współczynników o @p dims wymiarach.
+ * @param[in] dims : liczba wymiarów
+ * @param[in] sizes : rozmiary kolejnych wymiarów
+ * @param[in] strides : odstępy między elementami w kolejnych wymiarach
+ * @param[out] coeffs : element o indeksach równych zero
+ */
+static void TensorClear(unsigned dims, const unsigned sizes[],
+                        const ptrdiff_t strides[], poly_coeff_t *coeffs)
+{
+    if (dims == 0) {
+        *coeffs = 0;
+        return;
+    }
+    for (unsigned i = 0; i < sizes[0]; i++) {
+        TensorClear(dims - 1, sizes + 1, strides + 1,
+                    coeffs + (ptrdiff_t) i * strides[0]);
+    }
+}
+
+/**
+ * Wpisuje współczynniki wielomianu do wyzerowanej tablicy o @p dims
+ * wymiarach.
+ * @param[in] p : wielomian
+ * @param[in] dims : liczba wymiarów
+ * @param[in] sizes : rozmiary kolejnych wymiarów
+ * @param[in] strides : odstępy między elementami w kolejnych wymiarach
+ * @param[out] coeffs : element o indeksach równych zero
+ * @return czy wielomian zmieścił się w tablicy
+ */
+static bool PolyToTensor(const Poly *p, unsigned dims, const unsigned sizes[],
+                         const ptrdiff_t strides[], poly_coeff_t *coeffs)
+{
+    if (PolyIsZero(p)) {
+        return true;
+    } else if (PolyIsCoeff(p)) {
+        for (unsigned k = 0; k < dims; k++) {
+            if (sizes[k] == 0) {
+                return false;
+            }
+        }
+        *coeffs = p->type.c;
+        return true;
+    } else if (dims == 0) {
+        return false;
+    }
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        if ((unsigned) tmp->exp >= sizes[0]
+            || !PolyToTensor(&tmp->p, dims - 1, sizes + 1, strides + 1,
+                             coeffs + (ptrdiff_t) tmp->exp * strides[0])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Tworzy wielomian jednej zmiennej z tablicy współczynników:
+ * `coeffs[i * stride]` jest współczynnikiem przy `x^i`.
+ * @param[in] count : liczba współczynników
+ * @param[in] coeffs : tablica współczynników
+ * @param[in] stride : odstęp (w elementach) między kolejnymi współczynnikami
+ * @return wielomian
+ */
+Poly PolyFromCoeffArray(unsigned count, const poly_coeff_t coeffs[], ptrdiff_t stride)
+{
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (unsigned i = count; i-- > 0;) {
+        poly_coeff_t c = coeffs[(ptrdiff_t) i * stride];
+        if (c != 0) {
+            wanderer->next = MonoNew(PolyFromCoeff(c), (poly_exp_t) i);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Zapisuje współczynniki wielomianu jednej zmiennej do tablicy:
+ * `coeffs[i * stride]` dostaje współczynnik przy `x^i`, a pozostałe
+ * elementy są zerowane.
+ * @param[in] p : wielomian
+ * @param[in] count : liczba współczynników
+ * @param[out] coeffs : tablica współczynników
+ * @param[in] stride : odstęp (w elementach) między kolejnymi współczynnikami
+ * @return czy wielomian jest wielomianem jednej zmiennej stopnia mniejszego
+ * niż @p count (jeśli nie, zawartość tablicy jest nieokreślona)
+ */
+bool PolyToCoeffArray(const Poly *p, unsigned count, poly_coeff_t coeffs[], ptrdiff_t stride)
+{
+    for (unsigned i = 0; i < count; i++) {
+        coeffs[(ptrdiff_t) i * stride] = 0;
+    }
+    if (PolyIsZero(p)) {
+        return true;
+    } else if (PolyIsCoeff(p)) {
+        if (count == 0) {
+            return false;
+        }
+        coeffs[0] = p->type.c;
+        return true;
+    }
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        if ((unsigned) tmp->exp >= count || !PolyIsCoeff(&tmp->p)) {
+            return false;
+        }
+        coeffs[(ptrdiff_t) tmp->exp * stride] = tmp->p.type.c;
+    }
+    return true;
+}
+
+/**
+ * Tworzy wielomian z wielowymiarowej tablicy współczynników: element
+ * o indeksach `(i_0, ..., i_{dims-1})`, czyli
+ * `coeffs[i_0 * strides[0] + ... + i_{dims-1} * strides[dims-1]]`,
+ * jest współczynnikiem przy `x_0^i_0 * ... * x_{dims-1}^i_{dims-1}`.
+ * @param[in] dims : liczba wymiarów (zmiennych)
+ * @param[in] sizes : rozmiary kolejnych wymiarów
+ * @param[in] strides : odstępy (w elementach) w kolejnych wymiarach
+ * @param[in] coeffs : tablica współczynników
+ * @return wielomian
+ */
+Poly PolyFromCoeffTensor(unsigned dims, const unsigned sizes[],
+                         const ptrdiff_t strides[], const poly_coeff_t coeffs[])
+{
+    return PolyFromTensor(dims, sizes, strides, coeffs);
+}
+
+/**
+ * Zapisuje współczynniki wielomianu do wielowymiarowej tablicy w układzie
+ * opisanym przy PolyFromCoeffTensor; pozostałe elementy są zerowane.
+ * @param[in] p : wielomian
+ * @param[in] dims : liczba wymiarów (zmiennych)
+ * @param[in] sizes : rozmiary kolejnych wymiarów
+ * @param[in] strides : odstępy (w elementach) w kolejnych wymiarach
+ * @param[out] coeffs : tablica współczynników
+ * @return czy wielomian zmieścił się w tablicy (jeśli nie, jej zawartość
+ * jest nieokreślona)
+ */
+bool PolyToCoeffTensor(const Poly *p, unsigned dims, const unsigned sizes[],
+                       const ptrdiff_t strides[], poly_coeff_t coeffs[])
+{
+    TensorClear(dims, sizes, strides, coeffs);
+    return PolyToTensor(p, dims, sizes, strides, coeffs);
+}
+
+/** Długość, od której gęste iloczyny liczone są algorytmem Karatsuby */
+#define KARATSUBA_MIN 32
+
+/**
+ * Sprawdza, czy wielomian jest gęstym wielomianem jednej zmiennej
+ * o stałych współczynnikach i wyznacza jego najmniejszy wykładnik oraz
+ * liczbę jednomianów.
+ * Wielomian uznajemy za gęsty, jeśli zajmuje co najmniej połowę przedziału
+ * od najmniejszego do największego wykładnika.
+ * Najmniejszy wykładnik i liczba jednomianów wyznaczane są zawsze.
+ * @param[in] p : wielomian niebędący współczynnikiem
+ * @param[out] min_exp : najmniejszy wykładnik
+ * @param[out] count : liczba jednomianów
+ * @return czy wielomian jest gęsty
+ */
+static bool PolyIsDense(const Poly *p, poly_exp_t *min_exp, unsigned *count)
+{
+    bool coeffs_only = true;
+    *count = 0;
+    *min_exp = p->type.m->exp;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        coeffs_only &= PolyIsCoeff(&tmp->p);
+        (*count)++;
+        *min_exp = tmp->exp;
+    }
+    return coeffs_only
+           && (unsigned long) (p->type.m->exp - *min_exp) < 2 * (unsigned long) *count;
+}
+
+/**
+ * Zapisuje współczynniki gęstego wielomianu przesunięte o @p min_exp
+ * (`a[i]` jest współczynnikiem przy `x^(i + min_exp)`).
+ * Rachunki na tablicach prowadzone są w arytmetyce modulo 2^64, tak samo
+ * jak przepełniają się współczynniki.
+ * @param[in] p : gęsty wielomian
+ * @param[in] min_exp : najmniejszy wykładnik
+ * @param[in] n : długość tablicy
+ * @return zaalokowana tablica
+ */
+static unsigned long *PolyToDense(const Poly *p, poly_exp_t min_exp, unsigned n)
+{
+    unsigned long *a = (unsigned long*) calloc(n, sizeof(unsigned long));
+    assert(a != NULL);
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        a[tmp->exp - min_exp] = (unsigned long) tmp->p.type.c;
+    }
+    return a;
+}
+
+/**
+ * Tworzy wielomian z tablicy współczynników: `a[i]` jest współczynnikiem
+ * przy `x^(i + shift)`.
+ * @param[in] a : tablica współczynników
+ * @param[in] n : długość tablicy
+ * @param[in] shift : wykładnik przy `a[0]`
+ * @return wielomian
+ */
+static Poly PolyFromDense(const unsigned long a[], unsigned n, poly_exp_t shift)
+{
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (unsigned i = n; i-- > 0;) {
+        if (a[i] != 0) {
+            wanderer->next = MonoNew(PolyFromCoeff((poly_coeff_t) a[i]),
+                                     (poly_exp_t) i + shift);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Podnosi do kwadratu gęsty wielomian zapisany w tablicy.
+ * Krótkie tablice mnożone są szkolnie, z każdym iloczynem mieszanym
+ * liczonym raz i podwajanym, a dłuższe algorytmem Karatsuby:
+ * `(a0 + a1 x^h)^2 = a0^2 + ((a0 + a1)^2 - a0^2 - a1^2) x^h + a1^2 x^2h`.
+ * @param[in] a : tablica współczynników
+ * @param[in] n : długość tablicy (dodatnia)
+ * @param[out] res : wynik, 2n - 1 współczynników
+ * @param[in] scratch : pamięć pomocnicza, co najmniej 4n + 64 elementów
+ */
+static void DenseSquare(const unsigned long a[], unsigned n, unsigned long res[],
+                        unsigned long scratch[])
+{
+    if (n < KARATSUBA_MIN) {
+        for (unsigned i = 0; i < 2 * n - 1; i++) {
+            res[i] = 0;
+        }
+        for (unsigned i = 0; i < n; i++) {
+            res[2 * i] += a[i] * a[i];
+            unsigned long twice = 2 * a[i];
+            for (unsigned j = i + 1; j < n; j++) {
+                res[i + j] += twice * a[j];
+            }
+        }
+        return;
+    }
+    unsigned h = n / 2, m = n - h;
+    DenseSquare(a, h, res, scratch);
+    res[2 * h - 1] = 0;
+    DenseSquare(a + h, m, res + 2 * h, scratch);
+    unsigned long *sum = scratch;
+    unsigned long *middle = scratch + m;
+    for (unsigned i = 0; i < m; i++) {
+        sum[i] = a[h + i] + (i < h ? a[i] : 0);
+    }
+    DenseSquare(sum, m, middle, middle + 2 * m - 1);
+    for (unsigned i = 0; i < 2 * h - 1; i++) {
+        middle[i] -= res[i];
+    }
+    for (unsigned i = 0; i < 2 * m - 1; i++) {
+        middle[i] -= res[2 * h + i];
+    }
+    for (unsigned i = 0; i < 2 * m - 1; i++) {
+        res[h + i] += middle[i];
+    }
+}
+
+/**
+ * Mnoży dwa gęste wielomiany zapisane w tablicach tej samej długości.
+ * Krótkie tablice mnożone są szkolnie, a dłuższe algorytmem Karatsuby:
+ * `(a0 + a1 x^h) (b0 + b1 x^h) = a0 b0
+ * + ((a0 + a1) (b0 + b1) - a0 b0 - a1 b1) x^h + a1 b1 x^2h`.
+ * @param[in] a : tablica współczynników
+ * @param[in] b : tablica współczynników
+ * @param[in] n : długość tablic (dodatnia)
+ * @param[out] res : wynik, 2n - 1 współczynników
+ * @param[in] scratch : pamięć pomocnicza, co najmniej 4n + 256 elementów
+ */
+static void DenseMul(const unsigned long a[], const unsigned long b[], unsigned n,
+                     unsigned long res[], unsigned long scratch[])
+{
+    if (n < KARATSUBA_MIN) {
+        for (unsigned i = 0; i < 2 * n - 1; i++) {
+            res[i] = 0;
+        }
+        for (unsigned i = 0; i < n; i++) {
+            for (unsigned j = 0; j < n; j++) {
+                res[i + j] += a[i] * b[j];
+            }
+        }
+        return;
+    }
+    unsigned h = n / 2, m = n - h;
+    DenseMul(a, b, h, res, scratch);
+    res[2 * h - 1] = 0;
+    DenseMul(a + h, b + h, m, res + 2 * h, scratch);
+    unsigned long *sum_a = scratch;
+    unsigned long *sum_b = scratch + m;
+    unsigned long *middle = scratch + 2 * m;
+    for (unsigned i = 0; i < m; i++) {
+        sum_a[i] = a[h + i] + (i < h ? a[i] : 0);
+        sum_b[i] = b[h + i] + (i < h ? b[i] : 0);
+    }
+    DenseMul(sum_a, sum_b, m, middle, middle + 2 * m - 1);
+    for (unsigned i = 0; i < 2 * h - 1; i++) {
+        middle[i] -= res[i];
+    }
+    for (unsigned i = 0; i < 2 * m - 1; i++) {
+        middle[i] -= res[2 * h + i];
+    }
+    for (unsigned i = 0; i < 2 * m - 1; i++) {
+        res[h + i] += middle[i];
+    }
+}
+
+/**
+ * Mnoży dwa gęste wielomiany zapisane w tablicach dowolnych długości.
+ * Dłuższa tablica dzielona jest na bloki długości krótszej, a każdy blok
+ * mnożony jest funkcją DenseMul.
+ * @param[in] a : tablica współczynników
+ * @param[in] na : długość @p a (dodatnia)
+ * @param[in] b : tablica współczynników
+ * @param[in] nb : długość @p b (dodatnia)
+ * @param[out] res : wynik, na + nb - 1 współczynników
+ */
+static void DenseMulAny(const unsigned long a[], unsigned na,
+                        const unsigned long b[], unsigned nb, unsigned long res[])
+{
+    if (na < nb) {
+        DenseMulAny(b, nb, a, na, res);
+        return;
+    }
+    unsigned long *block = (unsigned long*) malloc(sizeof(unsigned long) * (8 * (unsigned long) nb + 256));
+    assert(block != NULL);
+    unsigned long *product = block + nb;
+    unsigned long *scratch = product + 2 * nb - 1;
+    for (unsigned i = 0; i < na + nb - 1; i++) {
+        res[i] = 0;
+    }
+    for (unsigned start = 0; start < na; start += nb) {
+        unsigned len = na - start < nb ? na - start : nb;
+        for (unsigned i = 0; i < nb; i++) {
+            block[i] = i < len ? a[start + i] : 0;
+        }
+        DenseMul(block, b, nb, product, scratch);
+        for (unsigned i = 0; i < len + nb - 1; i++) {
+            res[start + i] += product[i];
+        }
+    }
+    free(block);
+}
+
+/**
+ * Mnoży dwa gęste wielomiany jednej zmiennej o stałych współczynnikach
+ * na tablicach funkcją DenseMulAny.
+ * @param[in] p : gęsty wielomian
+ * @param[in] min_p : najmniejszy wykładnik @p p
+ * @param[in] q : gęsty wielomian
+ * @param[in] min_q : najmniejszy wykładnik @p q
+ * @return `p * q`
+ */
+static Poly PolyMulDense(const Poly *p, poly_exp_t min_p, const Poly *q, poly_exp_t min_q)
+{
+    unsigned np = (unsigned) (p->type.m->exp - min_p) + 1;
+    unsigned nq = (unsigned) (q->type.m->exp - min_q) + 1;
+    unsigned long *a = PolyToDense(p, min_p, np);
+    unsigned long *b = PolyToDense(q, min_q, nq);
+    unsigned long *res = (unsigned long*) malloc(sizeof(unsigned long) * (np + nq - 1));
+    assert(res != NULL);
+    DenseMulAny(a, np, b, nq, res);
+    Poly product = PolyFromDense(res, np + nq - 1, min_p + min_q);
+    free(a);
+    free(b);
+    free(res);
+    return product;
+}
+
+/**
+ * Mnoży dwa wielomiany.
+ * Długie gęste wielomiany jednej zmiennej o stałych współczynnikach
+ * mnożone są na tablicach algorytmem Karatsuby. W pozostałych przypadkach
+ * iloczyny jednomianów sumowane są w akumulatorze: bezpośrednio
+ * indeksowanym wykładnikiem, jeśli przedział wykładników wyniku jest krótki
+ * (np. dla gęstych wielomianów), a w przeciwnym razie w tablicy haszującej.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @return `p * q`
+ *
+ * */
+Poly PolyMul(const Poly *p, const Poly *q)
+{
+    if (PolyIsZero(p) || PolyIsZero(q)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p) || PolyIsCoeff(q)) {
+        if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
+            poly_coeff_t product = p->type.c * q->type.c;
+            return product != 0 ? PolyFromCoeff(product) : PolyZero();
+        } else if (PolyIsCoeff(p)) {
+            return PolyScaleCoeff(q, p->type.c);
+        } else {
+            return PolyScaleCoeff(p, q->type.c);
+        }
+    } else {
+        poly_exp_t min_p, min_q;
+        unsigned count_p, count_q;
+        bool dense_p = PolyIsDense(p, &min_p, &count_p);
+        bool dense_q = PolyIsDense(q, &min_q, &count_q);
+        if (dense_p && dense_q && count_p >= KARATSUBA_MIN && count_q >= KARATSUBA_MIN) {
+            return PolyMulDense(p, min_p, q, min_q);
+        }
+        // Iloczynów jest count_p * count_q, ale różnych wykładników nie więcej
+        // niż długość przedziału, do którego należą.
+        poly_exp_t min_exp = min_p + min_q;
+        poly_exp_t max_exp = p->type.m->exp + q->type.m->exp;
+        MonoAcc acc;
+        if ((unsigned long) (max_exp - min_exp) < 2 * (unsigned long) count_p * count_q) {
+            MonoAccInitDirect(&acc, min_exp, max_exp);
+        } else {
+            MonoAccInitHash(&acc, count_p + count_q);
+        }
+        for (Mono *header_p = p->type.m; header_p != NULL; header_p = header_p->next) {
+            for (Mono *header_q = q->type.m; header_q != NULL; header_q = header_q->next) {
+                Poly product = PolyMul(&header_p->p, &header_q->p);
+                MonoAccAdd(&acc, &product, header_p->exp + header_q->exp);
+            }
+        }
+        return MonoAccFinish(&acc);
+    }
+}
+
+/**
+ * Podnosi wielomian do kwadratu.
+ * Gęste wielomiany jednej zmiennej o stałych współczynnikach podnoszone
+ * są do kwadratu na tablicach (algorytmem Karatsuby, jeśli są dość długie),
+ * a pozostałe szkolnie: każdy iloczyn mieszany `2 a_i a_j` liczony jest
+ * raz, a kwadraty współczynników rekurencyjnie tą samą funkcją.
+ * @param[in] p : wielomian
+ * @return `p * p`
+ */
+Poly PolySquare(const Poly *p)
+{
+    if (PolyIsZero(p)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        poly_coeff_t square = p->type.c * p->type.c;
+        return square != 0 ? PolyFromCoeff(square) : PolyZero();
+    }
+    poly_exp_t min_exp;
+    unsigned count;
+    if (PolyIsDense(p, &min_exp, &count) && count >= KARATSUBA_MIN) {
+        unsigned n = (unsigned) (p->type.m->exp - min_exp) + 1;
+        unsigned long *a = PolyToDense(p, min_exp, n);
+        unsigned long *res = (unsigned long*) malloc(sizeof(unsigned long) * (6 * n + 64));
+        assert(res != NULL);
+        DenseSquare(a, n, res, res + 2 * n);
+        Poly square = PolyFromDense(res, 2 * n - 1, 2 * min_exp);
+        free(a);
+        free(res);
+        return square;
+    }
+    MonoAcc acc;
+    if ((unsigned long) (p->type.m->exp - min_exp) < (unsigned long) count * count) {
+        MonoAccInitDirect(&acc, 2 * min_exp, 2 * p->type.m->exp);
+    } else {
+        MonoAccInitHash(&acc, 2 * (unsigned long) count);
+    }
+    for (Mono *mono_i = p->type.m; mono_i != NULL; mono_i = mono_i->next) {
+        Poly square = PolySquare(&mono_i->p);
+        MonoAccAdd(&acc, &square, 2 * mono_i->exp);
+        for (Mono *mono_j = mono_i->next; mono_j != NULL; mono_j = mono_j->next) {
+            Poly product = PolyMul(&mono_i->p, &mono_j->p);
+            PolyScaleInPlace(&product, 2);
+            MonoAccAdd(&acc, &product, mono_i->exp + mono_j->exp);
+        }
+    }
+    return MonoAccFinish(&acc);
+}
+
+/**
+ * Mnoży dwa gęste wielomiany zapisane w tablicach tej samej długości,
+ * wyznaczając tylko @p n najniższych współczynników iloczynu.
+ * Krótkie tablice mnożone są szkolnie z pominięciem iloczynów `a_i b_j`
+ * dla `i + j >= n`. Dłuższe dzielone są w punkcie `h` około `0.7 n`
+ * (metoda Muldersa): `a0 b0` liczone jest w całości funkcją DenseMul,
+ * `a1 b1 x^2h` jest pomijane, a niskie części `a0 b1` i `a1 b0` liczone są
+ * rekurencyjnie. Przy podziale na połowy oszczędność znikałaby, bo Karatsuba
+ * i tak liczy `a1 b1` raz.
+ * @param[in] a : tablica współczynników
+ * @param[in] b : tablica współczynników
+ * @param[in] n : długość tablic (dodatnia)
+ * @param[out] res : wynik, @p n współczynników
+ * @param[in] scratch : pamięć pomocnicza, co najmniej 8n + 512 elementów
+ */
+static void DenseMulLow(const unsigned long a[], const unsigned long b[], unsigned n,
+                        unsigned long res[], unsigned long scratch[])
+{
+    if (n < KARATSUBA_MIN) {
+        for (unsigned i = 0; i < n; i++) {
+            res[i] = 0;
+        }
+        for (unsigned i = 0; i < n; i++) {
+            for (unsigned j = 0; i + j < n; j++) {
+                res[i + j] += a[i] * b[j];
+            }
+        }
+        return;
+    }
+    unsigned m = 3 * n / 10, h = n - m;
+    DenseMul(a, b, h, scratch, scratch + 2 * h - 1);
+    for (unsigned i = 0; i < n; i++) {
+        res[i] = scratch[i];
+    }
+    DenseMulLow(a, b + h, m, scratch, scratch + m);
+    for (unsigned i = 0; i < m; i++) {
+        res[h + i] += scratch[i];
+    }
+    DenseMulLow(a + h, b, m, scratch, scratch + m);
+    for (unsigned i = 0; i < m; i++) {
+        res[h + i] += scratch[i];
+    }
+}
+
+/**
+ * Mnoży dwa gęste wielomiany zapisane w tablicach dowolnych długości,
+ * wyznaczając tylko @p n najniższych współczynników iloczynu.
+ * Tablice obcinane są do długości @p n, a jeśli obie są co najmniej
+ * w połowie tak długie jak wynik, mnożone funkcją DenseMulLow; w przeciwnym
+ * razie iloczyn jest krótki i liczony w całości funkcją DenseMulAny.
+ * @param[in] a : tablica współczynników
+ * @param[in] na : długość @p a
+ * @param[in] b : tablica współczynników
+ * @param[in] nb : długość @p b
+ * @param[in] n : liczba wyznaczanych współczynników
+ * @param[out] res : wynik, @p n współczynników
+ */
+static void DenseMulTrunc(const unsigned long a[], unsigned na,
+                          const unsigned long b[], unsigned nb, unsigned n, unsigned long res[])
+{
+    na = na < n ? na : n;
+    nb = nb < n ? nb : n;
+    if (na == 0 || nb == 0) {
+        for (unsigned i = 0; i < n; i++) {
+            res[i] = 0;
+        }
+    } else if (n >= KARATSUBA_MIN && 2 * na >= n && 2 * nb >= n) {
+        unsigned long *block = (unsigned long*) malloc(sizeof(unsigned long) * (10 * (unsigned long) n + 512));
+        assert(block != NULL);
+        for (unsigned i = 0; i < n; i++) {
+            block[i] = i < na ? a[i] : 0;
+            block[n + i] = i < nb ? b[i] : 0;
+        }
+        DenseMulLow(block, block + n, n, res, block + 2 * n);
+        free(block);
+    } else {
+        unsigned long *product = (unsigned long*) malloc(sizeof(unsigned long) * (na + nb - 1));
+        assert(product != NULL);
+        DenseMulAny(a, na, b, nb, product);
+        for (unsigned i = 0; i < n; i++) {
+            res[i] = i < na + nb - 1 ? product[i] : 0;
+        }
+        free(product);
+    }
+}
+
+/**
+ * Mnoży wielomian przez współczynnik, pomijając jednomiany wyniku stopnia
+ * co najmniej @p n (względem pierwszej zmiennej albo, jeśli @p total jest
+ * prawdą, stopnia łącznego).
+ * @param[in] p : wielomian
+ * @param[in] c : współczynnik
+ * @param[in] n : ograniczenie stopnia
+ * @param[in] total : czy ograniczać stopień łączny
+ * @return obcięty iloczyn `c * p`
+ */
+static Poly PolyScaleTrunc(const Poly *p, poly_coeff_t c, poly_exp_t n, bool total)
+{
+    if (n <= 0 || c == 0 || PolyIsZero(p)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        poly_coeff_t product = p->type.c * c;
+        return product != 0 ? PolyFromCoeff(product) : PolyZero();
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        if (tmp->exp >= n) {
+            continue;
+        }
+        Poly scaled = total ? PolyScaleTrunc(&tmp->p, c, n - tmp->exp, true)
+                            : PolyScaleCoeff(&tmp->p, c);
+        if (!PolyIsZero(&scaled)) {
+            wanderer->next = MonoNew(scaled, tmp->exp);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Zapisuje w tablicy, w kolejności rosnących wykładników, jednomiany
+ * wielomianu o wykładnikach mniejszych niż @p limit.
+ * @param[in] p : wielomian niebędący współczynnikiem
+ * @param[in] limit : ograniczenie wykładników
+ * @param[out] count : liczba zapisanych jednomianów
+ * @param[out] coeffs_only : czy ich współczynniki są stałymi
+ * @return zaalokowana tablica (NULL, jeśli @p count jest zerem)
+ */
+static Mono **PolyMonosBelow(const Poly *p, poly_exp_t limit, unsigned *count,
+                             bool *coeffs_only)
+{
+    Mono *tmp = p->type.m;
+    *count = 0;
+    *coeffs_only = true;
+    while (tmp != NULL && tmp->exp >= limit) {
+        tmp = tmp->next;
+    }
+    for (Mono *rest = tmp; rest != NULL; rest = rest->next) {
+        (*count)++;
+        *coeffs_only &= PolyIsCoeff(&rest->p);
+    }
+    if (*count == 0) {
+        return NULL;
+    }
+    Mono **monos = (Mono**) malloc(sizeof(Mono*) * *count);
+    assert(monos != NULL);
+    for (unsigned i = *count; i-- > 0; tmp = tmp->next) {
+        monos[i] = tmp;
+    }
+    return monos;
+}
+
+/**
+ * Mnoży gęste wielomiany jednej zmiennej o stałych współczynnikach,
+ * wyznaczając tylko jednomiany o wykładnikach mniejszych niż @p n,
+ * funkcją DenseMulTrunc.
+ * @param[in] a : jednomiany pierwszego czynnika (rosnąco)
+ * @param[in] na : ich liczba
+ * @param[in] b : jednomiany drugiego czynnika (rosnąco)
+ * @param[in] nb : ich liczba
+ * @param[in] n : ograniczenie wykładników (większe niż suma najmniejszych)
+ * @return obcięty iloczyn
+ */
+static Poly PolyMulTruncDense(Mono *const a[], unsigned na, Mono *const b[], unsigned nb,
+                              poly_exp_t n)
+{
+    poly_exp_t shift = a[0]->exp + b[0]->exp;
+    unsigned len = (unsigned) (n - shift);
+    unsigned la = (unsigned) (a[na - 1]->exp - a[0]->exp) + 1;
+    unsigned lb = (unsigned) (b[nb - 1]->exp - b[0]->exp) + 1;
+    unsigned long *da = (unsigned long*) calloc(la, sizeof(unsigned long));
+    unsigned long *db = (unsigned long*) calloc(lb, sizeof(unsigned long));
+    unsigned long *res = (unsigned long*) malloc(sizeof(unsigned long) * len);
+    assert(da != NULL && db != NULL && res != NULL);
+    for (unsigned i = 0; i < na; i++) {
+        da[a[i]->exp - a[0]->exp] = (unsigned long) a[i]->p.type.c;
+    }
+    for (unsigned i = 0; i < nb; i++) {
+        db[b[i]->exp - b[0]->exp] = (unsigned long) b[i]->p.type.c;
+    }
+    DenseMulTrunc(da, la, db, lb, len, res);
+    Poly product = PolyFromDense(res, len, shift);
+    free(da);
+    free(db);
+    free(res);
+    return product;
+}
+
+/**
+ * Mnoży dwa wielomiany, pomijając jednomiany wyniku stopnia co najmniej
+ * @p n (względem pierwszej zmiennej albo, jeśli @p total jest prawdą,
+ * stopnia łącznego).
+ * Iloczyny jednomianów, które przekroczyłyby ograniczenie, nie są w ogóle
+ * liczone: jednomiany obu czynników przechodzone są rosnąco, a pętla
+ * wewnętrzna kończy się na pierwszym za dużym wykładniku. Przy ograniczeniu
+ * stopnia łącznego współczynniki mnożone są rekurencyjnie z ograniczeniem
+ * zmniejszonym o sumę wykładników.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] n : ograniczenie stopnia
+ * @param[in] total : czy ograniczać stopień łączny
+ * @return obcięty iloczyn `p * q`
+ */
+static Poly PolyMulTruncRec(const Poly *p, const Poly *q, poly_exp_t n, bool total)
+{
+    if (n <= 0 || PolyIsZero(p) || PolyIsZero(q)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        return PolyScaleTrunc(q, p->type.c, n, total);
+    } else if (PolyIsCoeff(q)) {
+        return PolyScaleTrunc(p, q->type.c, n, total);
+    }
+    poly_exp_t min_p, min_q;
+    unsigned count_p, count_q;
+    PolyIsDense(p, &min_p, &count_p);
+    PolyIsDense(q, &min_q, &count_q);
+    if (min_p >= n - min_q) {
+        return PolyZero();
+    }
+    bool coeffs_p, coeffs_q;
+    Mono **monos_p = PolyMonosBelow(p, n - min_q, &count_p, &coeffs_p);
+    Mono **monos_q = PolyMonosBelow(q, n - min_p, &count_q, &coeffs_q);
+    poly_exp_t max_exp = monos_p[count_p - 1]->exp + monos_q[count_q - 1]->exp;
+    if (max_exp > n - 1) {
+        max_exp = n - 1;
+    }
+    Poly product;
+    if (coeffs_p && coeffs_q && count_p >= KARATSUBA_MIN && count_q >= KARATSUBA_MIN
+        && (unsigned long) (monos_p[count_p - 1]->exp - min_p) < 2 * (unsigned long) count_p
+        && (unsigned long) (monos_q[count_q - 1]->exp - min_q) < 2 * (unsigned long) count_q) {
+        product = PolyMulTruncDense(monos_p, count_p, monos_q, count_q, n);
+    } else {
+        MonoAcc acc;
+        if ((unsigned long) (max_exp - min_p - min_q) < 2 * (unsigned long) count_p * count_q) {
+            MonoAccInitDirect(&acc, min_p + min_q, max_exp);
+        } else {
+            MonoAccInitHash(&acc, count_p + count_q);
+        }
+        for (unsigned i = 0; i < count_p; i++) {
+            for (unsigned j = 0; j < count_q && monos_q[j]->exp < n - monos_p[i]->exp; j++) {
+                poly_exp_t exp = monos_p[i]->exp + monos_q[j]->exp;
+                Poly c = total ? PolyMulTruncRec(&monos_p[i]->p, &monos_q[j]->p, n - exp, true)
+                               : PolyMul(&monos_p[i]->p, &monos_q[j]->p);
+                MonoAccAdd(&acc, &c, exp);
+            }
+        }
+        product = MonoAccFinish(&acc);
+    }
+    free(monos_p);
+    free(monos_q);
+    return product;
+}
+
+/**
+ * Mnoży dwa wielomiany jak szeregi potęgowe względem pierwszej zmiennej:
+ * wyznacza tylko jednomiany iloczynu o wykładnikach mniejszych niż @p n.
+ * Iloczyny jednomianów, które przekroczyłyby ograniczenie, nie są w ogóle
+ * liczone, a długie gęste wielomiany mnożone są algorytmem Karatsuby
+ * wyznaczającym tylko niższą połowę iloczynu.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] n : ograniczenie wykładnika
+ * @return `p * q mod x_0^n`
+ */
+Poly PolyMulTrunc(const Poly *p, const Poly *q, poly_exp_t n)
+{
+    return PolyMulTruncRec(p, q, n, false);
+}
+
+/**
+ * Mnoży dwa wielomiany, wyznaczając tylko jednomiany iloczynu o stopniu
+ * łącznym (sumie wykładników wszystkich zmiennych) mniejszym niż @p n.
+ * Iloczyny jednomianów, które przekroczyłyby ograniczenie, nie są w ogóle
+ * liczone.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] n : ograniczenie stopnia łącznego
+ * @return obcięty iloczyn `p * q`
+ */
+Poly PolyMulTruncTotal(const Poly *p, const Poly *q, poly_exp_t n)
+{
+    return PolyMulTruncRec(p, q, n, true);
+}
+
+/** Największa liczba jednomianów, dla której potęga rozwijana jest dwumianowo */
+#define POW_EXPAND_TERMS 8
+
+/** Największy wykładnik potęgi rozwijanej dwumianowo */
+#define POW_EXPAND_MAX 1024
+
+/** Ograniczenie wartości pośrednich rekurencji Millera (2^62) */
+#define MILLER_LIMIT 4611686018427387904.0
+
+/**
+ * Podnosi współczynnik do potęgi (z przepełnieniem modulo 2^64).
+ * @param[in] c : współczynnik
+ * @param[in] n : wykładnik potęgi
+ * @return `c^n`
+ */
+static poly_coeff_t CoeffPow(poly_coeff_t c, unsigned n)
+{
+    unsigned long base = (unsigned long) c, res = 1;
+    while (n > 0) {
+        if (n & 1) {
+            res *= base;
+        }
+        base *= base;
+        n >>= 1;
+    }
+    return (poly_coeff_t) res;
+}
+
+/**
+ * Podnosi wielomian do potęgi szybkim potęgowaniem: bity wykładnika
+ * przechodzone są od najstarszego, wynik jest podnoszony do kwadratu
+ * funkcją PolySquare i mnożony przez @p p przy zapalonych bitach.
+ * @param[in] p : wielomian
+ * @param[in] n : wykładnik potęgi (dodatni)
+ * @return `p^n`
+ */
+static Poly PolyPowBinary(const Poly *p, unsigned n)
+{
+    unsigned bit = 1;
+    while (bit <= n / 2) {
+        bit <<= 1;
+    }
+    Poly res = PolyClone(p);
+    for (bit >>= 1; bit > 0; bit >>= 1) {
+        Poly square = PolySquare(&res);
+        PolyDestroy(&res);
+        res = square;
+        if (n & bit) {
+            Poly product = PolyMul(&res, p);
+            PolyDestroy(&res);
+            res = product;
+        }
+    }
+    return res;
+}
+
+/**
+ * Podnosi do potęgi wielomian o kilku jednomianach, rozwijając go
+ * dwumianowo względem pierwszego jednomianu `l`:
+ * `(l + r)^n = sum C(n, k) l^(n-k) r^k`. Potęgi `r` liczone są kolejnymi
+ * mnożeniami przez `r` (rzadkie czynniki nie rozrastają się jak przy
+ * podnoszeniu do kwadratu), potęgi `l` są jednomianami, a składniki sumowane
+ * są naraz funkcją PolyAddManyWeighted. Symbole Newtona wyznaczane są
+ * z trójkąta Pascala modulo 2^64.
+ * @param[in] p : wielomian o co najmniej dwóch jednomianach
+ * @param[in] n : wykładnik potęgi (co najwyżej POW_EXPAND_MAX)
+ * @return `p^n`
+ */
+static Poly PolyPowExpand(const Poly *p, unsigned n)
+{
+    Mono *lead = p->type.m;
+    Poly rest; // widok reszty listy @p p, nie jest zwalniany
+    rest.tag = COMPLEX;
+    rest.type.m = lead->next;
+    unsigned long *binom = (unsigned long*) calloc(n + 1, sizeof(unsigned long));
+    Poly *lead_pows = (Poly*) malloc(sizeof(Poly) * (n + 1));
+    Poly *terms = (Poly*) malloc(sizeof(Poly) * (n + 1));
+    const Poly **pointers = (const Poly**) malloc(sizeof(Poly*) * (n + 1));
+    assert(binom != NULL && lead_pows != NULL && terms != NULL && pointers != NULL);
+    binom[0] = 1;
+    for (unsigned i = 1; i <= n; i++) {
+        for (unsigned k = i; k > 0; k--) {
+            binom[k] += binom[k - 1];
+        }
+    }
+    lead_pows[0] = PolyFromCoeff(1);
+    for (unsigned k = 1; k <= n; k++) {
+        lead_pows[k] = PolyMul(&lead_pows[k - 1], &lead->p);
+    }
+    Poly rest_pow = PolyFromCoeff(1);
+    for (unsigned k = 0; k <= n; k++) {
+        if (k > 0) {
+            Poly product = PolyMul(&rest_pow, &rest);
+            PolyDestroy(&rest_pow);
+            rest_pow = product;
+        }
+        Poly lead_term = PolyZero();
+        if (!PolyIsZero(&lead_pows[n - k])) {
+            lead_term = PolyFromList(MonoNew(lead_pows[n - k],
+                                             lead->exp * (poly_exp_t) (n - k)));
+            lead_pows[n - k] = PolyZero();
+        }
+        terms[k] = PolyMul(&lead_term, &rest_pow);
+        pointers[k] = &terms[k];
+        PolyDestroy(&lead_term);
+    }
+    Poly res = PolyAddManyWeighted(n + 1, pointers, (const poly_coeff_t*) binom);
+    for (unsigned k = 0; k <= n; k++) {
+        PolyDestroy(&terms[k]);
+        PolyDestroy(&lead_pows[k]);
+    }
+    PolyDestroy(&rest_pow);
+    free(binom);
+    free(lead_pows);
+    free(terms);
+    free(pointers);
+    return res;
+}
+
+/**
+ * Podnosi do potęgi gęsty wielomian jednej zmiennej rekurencją J.C.P.
+ * Millera: dla `a(x)^n = b(x)` (po przesunięciu, tak by `a0 != 0`)
+ * `b0 = a0^n`, `bk = sum_{i=1..min(k,d)} ((n+1) i - k) ai b(k-i) / (k a0)`.
+ * Dzielenie jest dokładne tylko bez przepełnień, dlatego rekurencja jest
+ * stosowana jedynie, gdy oszacowanie `d^2 (n+1) A S^n` wartości pośrednich
+ * (`A` to największy moduł współczynnika, a `S` suma modułów) nie
+ * przekracza 2^62.
+ * @param[in] p : gęsty wielomian jednej zmiennej o stałych współczynnikach
+ * @param[in] n : wykładnik potęgi (dodatni)
+ * @param[in] min_exp : najmniejszy wykładnik @p p
+ * @param[out] res : `p^n`, jeśli rekurencja została zastosowana
+ * @return czy rekurencja została zastosowana
+ */
+static bool PolyPowMiller(const Poly *p, unsigned n, poly_exp_t min_exp, Poly *res)
+{
+    unsigned d = (unsigned) (p->type.m->exp - min_exp);
+    double max_abs = 0, sum_abs = 0;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        double abs = tmp->p.type.c < 0 ? -(double) tmp->p.type.c : (double) tmp->p.type.c;
+        max_abs = abs > max_abs ? abs : max_abs;
+        sum_abs += abs;
+    }
+    double bound = (double) d * d * ((double) n + 1) * max_abs;
+    for (unsigned i = 0; i < n && bound < MILLER_LIMIT; i++) {
+        bound *= sum_abs;
+    }
+    if (bound >= MILLER_LIMIT) {
+        return false;
+    }
+    long *a = (long*) PolyToDense(p, min_exp, d + 1);
+    unsigned len = n * d + 1;
+    long *b = (long*) malloc(sizeof(long) * len);
+    assert(b != NULL);
+    b[0] = (long) CoeffPow(a[0], n);
+    for (unsigned k = 1; k < len; k++) {
+        long sum = 0;
+        for (unsigned i = 1; i <= d && i <= k; i++) {
+            sum += ((long) (n + 1) * i - k) * a[i] * b[k - i];
+        }
+        b[k] = sum / ((long) k * a[0]);
+    }
+    *res = PolyFromDense((unsigned long*) b, len, min_exp * (poly_exp_t) n);
+    free(a);
+    free(b);
+    return true;
+}
+
+/**
+ * Podnosi wielomian do potęgi.
+ * Jednomian podnoszony jest bezpośrednio, gęste krótkie wielomiany jednej
+ * zmiennej rekurencją Millera (jeśli wartości pośrednie na pewno się nie
+ * przepełnią), wielomiany o kilku jednomianach rozwinięciem dwumianowym,
+ * a pozostałe szybkim potęgowaniem przez podnoszenie do kwadratu.
+ * @param[in] p : wielomian
+ * @param[in] n : wykładnik potęgi
+ * @return `p^n` (`p^0 = 1`)
+ */
+Poly PolyPow(const Poly *p, unsigned n)
+{
+    if (n == 0) {
+        return PolyFromCoeff(1);
+    } else if (PolyIsZero(p)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        poly_coeff_t power = CoeffPow(p->type.c, n);
+        return power != 0 ? PolyFromCoeff(power) : PolyZero();
+    } else if (n == 1) {
+        return PolyClone(p);
+    } else if (p->type.m->next == NULL) {
+        Poly power = PolyPow(&p->type.m->p, n);
+        if (PolyIsZero(&power)) {
+            return PolyZero();
+        }
+        return PolyFromList(MonoNew(power, p->type.m->exp * (poly_exp_t) n));
+    }
+    poly_exp_t min_exp;
+    unsigned count;
+    Poly res;
+    if (PolyIsDense(p, &min_exp, &count) && count < KARATSUBA_MIN
+        && PolyPowMiller(p, n, min_exp, &res)) {
+        return res;
+    } else if (count <= POW_EXPAND_TERMS && n <= POW_EXPAND_MAX) {
+        return PolyPowExpand(p, n);
+    }
+    return PolyPowBinary(p, n);
+}
+
+/**
+ * Zwraca przeciwny wielomian.
+ * @param[in] p : wielomian
+ * @return `-p`
+ */
+Poly PolyNeg(const Poly *p)
+{
+    return PolyCloneSigned(p, true);
+}
+
+/**
+ * Odejmuje wielomian od wielomianu.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @return `p - q`
+ */
+Poly PolySub(const Poly *p, const Poly *q)
+{
+    return PolyAddSigned(p, q, true);
+}
+
+/**
+ * Dodaje dwa wielomiany, przejmując je na własność.
+ * Jednomiany argumentów są ponownie wykorzystywane w wyniku.
+ * Po wywołaniu @p p i @p q są zerami.
+ * @param[in,out] p : wielomian
+ * @param[in,out] q : wielomian
+ * @return `p + q`
+ */
+Poly PolyAddOwned(Poly *p, Poly *q)
+{
+    Poly res = *p;
+    *p = PolyZero();
+    PolyAddInPlace(&res, q, false, true);
+    return res;
+}
+
+/**
+ * Mnoży dwa wielomiany, przejmując je na własność.
+ * Jeśli jeden z argumentów jest współczynnikiem, drugi jest mnożony w
+ * miejscu. Po wywołaniu @p p i @p q są zerami.
+ * @param[in,out] p : wielomian
+ * @param[in,out] q : wielomian
+ * @return `p * q`
+ */
+Poly PolyMulOwned(Poly *p, Poly *q)
+{
+    Poly res;
+    if (PolyIsCoeff(q) || PolyIsZero(q)) {
+        res = *p;
+        PolyScaleInPlace(&res, PolyIsZero(q) ? 0 : q->type.c);
+    } else if (PolyIsCoeff(p) || PolyIsZero(p)) {
+        res = *q;
+        PolyScaleInPlace(&res, PolyIsZero(p) ? 0 : p->type.c);
+    } else {
+        res = PolyMul(p, q);
+        PolyDestroy(p);
+        PolyDestroy(q);
+    }
+    *p = PolyZero();
+    *q = PolyZero();
+    return res;
+}
+
+/**
+ * Zwraca przeciwny wielomian, przejmując argument na własność.
+ * Znaki współczynników zmieniane są w miejscu.
+ * Po wywołaniu @p p jest zerem.
+ * @param[in,out] p : wielomian
+ * @return `-p`
+ */
+Poly PolyNegOwned(Poly *p)
+{
+    Poly res = *p;
+    *p = PolyZero();
+    PolyNegInPlace(&res);
+    return res;
+}
+
+/**
+ * Odejmuje wielomian od wielomianu, przejmując oba na własność.
+ * Jednomiany argumentów są ponownie wykorzystywane w wyniku.
+ * Po wywołaniu @p p i @p q są zerami.
+ * @param[in,out] p : wielomian
+ * @param[in,out] q : wielomian
+ * @return `p - q`
+ */
+Poly PolySubOwned(Poly *p, Poly *q)
+{
+    Poly res = *p;
+    *p = PolyZero();
+    PolyAddInPlace(&res, q, true, true);
+    return res;
+}
+
+/**
+ * Dodaje w miejscu wielomian @p q do wielomianu @p p (`p += q`).
+ * Alokowane są tylko jednomiany o wykładnikach, których nie było w @p p.
+ * @param[in,out] p : wielomian
+ * @param[in] q : wielomian
+ */
+void PolyAddTo(Poly *p, const Poly *q)
+{
+    PolyAddInPlace(p, (Poly*) q, false, false);
+}
+
+/**
+ * Odejmuje w miejscu wielomian @p q od wielomianu @p p (`p -= q`).
+ * Alokowane są tylko jednomiany o wykładnikach, których nie było w @p p.
+ * @param[in,out] p : wielomian
+ * @param[in] q : wielomian
+ */
+void PolySubFrom(Poly *p, const Poly *q)
+{
+    PolyAddInPlace(p, (Poly*) q, true, false);
+}
+
+/**
+ * Mnoży w miejscu wielomian przez współczynnik (`p *= c`).
+ * @param[in,out] p : wielomian
+ * @param[in] c : współczynnik
+ */
+void PolyScaleBy(Poly *p, poly_coeff_t c)
+{
+    PolyScaleInPlace(p, c);
+}
+
+/**
+ * Zwraca stopień wielomianu ze względu na zadaną zmienną (-1 dla wielomianu
+ * tożsamościowo równego zeru).
+ * Zmienne indeksowane są od 0.
+ * Zmienna o indeksie 0 oznacza zmienną główną tego wielomianu.
+ * Większe indeksy oznaczają zmienne wielomianów znajdujących się
+ * we współczynnikach.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @return stopień wielomianu @p p z względu na zmienną o indeksie @p var_idx
+ */
+poly_exp_t PolyDegBy(const Poly *p, unsigned var_idx)
+{
+    if (PolyIsZero(p)) {
+        return -1;
+    }
+    else if (var_idx == 0) {
+        return p->type.m->exp;
+    }
+    else {
+        poly_exp_t deg = -2;
+        poly_exp_t y;
+        Mono *helper = p->type.m;
+        while (helper != NULL) {
+            y = PolyDegBy(&helper->p, var_idx - 1);
+            if (y > deg) {
+                deg = y;
+            }
+            helper = helper->next;
+        }
+        return deg;
+    }
+}
+
+/**
+ * Zwraca stopień wielomianu (-1 dla wielomianu tożsamościowo równego zeru).
+ * @param[in] p : wielomian
+ * @return stopień wielomianu @p p
+ */
+poly_exp_t PolyDeg(const Poly *p)
+{
+    if (PolyIsZero(p)) {
+        return -1;
+    }
+    else if (PolyIsCoeff(p)) {
+        return 0;
+    }
+    else {
+        return p->type.m->exp;
+    }
+}
+
+/**
+ * Sprawdza równość dwóch wielomianów.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @return `p = q`
+ */
+bool PolyIsEq(const Poly *p, const Poly *q)
+{
+    if (PolyIsZero(p) || PolyIsZero(q)) {
+        return PolyIsZero(p) && PolyIsZero(q);
+    } else if (PolyIsCoeff(p) || PolyIsCoeff(q)) {
+        if (!(PolyIsCoeff(p) && PolyIsCoeff(q))) {
+            return false;
+        } else {
+            return p->type.c == q->type.c;
+        }
+    } else {
+        bool isEq = true;
+        Mono *tmp_p = p->type.m;
+        Mono *tmp_q = q->type.m;
+        while (tmp_p != NULL && tmp_q != NULL) {
+            if (tmp_p->exp != tmp_q->exp) {
+                return false;
+            } else {
+                isEq = PolyIsEq(&tmp_p->p, &tmp_q->p);
+                if (isEq == false) {                          //warunek chyba ok?
+                    return false;
+                }
+            }
+            tmp_p = tmp_p->next;
+            tmp_q = tmp_q->next;
+        }
+        if (!(tmp_q == NULL && tmp_p == NULL)) {
+            return false;
+        }
+        return isEq;
+    }
+}
+
+/**
+ * Wylicza wartość wielomianu w punkcie @p x.
+ * Wstawia pod pierwszą zmienną wielomianu wartość @p x.
+ * W wyniku może powstać wielomian, jeśli współczynniki są wielomianem
+ * i zmniejszane są indeksy zmiennych w takim wielomianie o jeden.
+ * Formalnie dla wielomianu @f$p(x_0, x_1, x_2, \ldots)@f$ wynikiem jest
+ * wielomian @f$p(x, x_0, x_1, \ldots)@f$.
+ * @param[in] p
+ * @param[in] x
+ * @return @f$p(x, x_0, x_1, \ldots)@f$
+*/
+Poly PolyAt(const Poly *p, poly_coeff_t x)
+{
+    if (PolyIsCoeff(p) || PolyIsZero(p)) {
+        return PolyClone(p);
+    }
+    Poly res = PolyClone(&p->type.m->p);
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        poly_exp_t step = tmp->next != NULL ? tmp->exp - tmp->next->exp : tmp->exp;
+        PolyScaleInPlace(&res, CoeffPow(x, (unsigned) step));
+        if (tmp->next != NULL) {
+            PolyAddInPlace(&res, &tmp->next->p, false, false);
+        }
+    }
+    return res;
+}
+
+/** Długość, od której gęste złożenia liczone są metodą „dziel i zwyciężaj” */
+#define COMPOSE_DENSE_MIN 16
+
+/**
+ * Tablica potęg wielomianu podstawianego pod jedną zmienną.
+ * Wspólna dla wszystkich współczynników składanego wielomianu.
+ */
+typedef struct PowCache
+{
+    const Poly *base; ///< podstawiany wielomian
+    poly_exp_t *exps; ///< wykładniki zapamiętanych potęg
+    Poly *pows;       ///< zapamiętane potęgi
+    unsigned used;    ///< liczba zapamiętanych potęg
+    unsigned size;    ///< pojemność tablic
+} PowCache;
+
+/**
+ * Zwraca potęgę podstawianego wielomianu, licząc ją tylko przy pierwszym
+ * zapytaniu o dany wykładnik.
+ * @param[in,out] cache : tablica potęg
+ * @param[in] exp : wykładnik potęgi
+ * @return potęga należąca do tablicy
+ */
+static const Poly *PowCacheGet(PowCache *cache, poly_exp_t exp)
+{
+    for (unsigned i = 0; i < cache->used; i++) {
+        if (cache->exps[i] == exp) {
+            return &cache->pows[i];
+        }
+    }
+    if (cache->used == cache->size) {
+        cache->size = 2 * cache->size + 4;
+        cache->exps = (poly_exp_t*) realloc(cache->exps, sizeof(poly_exp_t) * cache->size);
+        cache->pows = (Poly*) realloc(cache->pows, sizeof(Poly) * cache->size);
+        assert(cache->exps != NULL && cache->pows != NULL);
+    }
+    cache->exps[cache->used] = exp;
+    cache->pows[cache->used] = PolyPow(cache->base, (unsigned) exp);
+    return &cache->pows[cache->used++];
+}
+
+/**
+ * Składa wielomian schematem Hornera: dla jednomianów o wykładnikach
+ * `e_0 > e_1 > ...` wynik mnożony jest przez potęgę `q[0]^(e_(j-1) - e_j)`
+ * z tablicy @p caches, a następnie dodawany jest rekurencyjnie złożony
+ * współczynnik. Pod zmienne o indeksach co najmniej @p k podstawiane jest
+ * zero.
+ * @param[in] p : wielomian
+ * @param[in] k : liczba podstawianych wielomianów
+ * @param[in,out] caches : tablice potęg podstawianych wielomianów
+ * @return złożenie
+ */
+static Poly PolyComposeHorner(const Poly *p, unsigned k, PowCache caches[])
+{
+    if (PolyIsZero(p)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        return PolyFromCoeff(p->type.c);
+    } else if (k == 0) {
+        Mono *last = p->type.m;
+        while (last->next != NULL) {
+            last = last->next;
+        }
+        return last->exp == 0 ? PolyComposeHorner(&last->p, 0, caches) : PolyZero();
+    }
+    Poly res = PolyComposeHorner(&p->type.m->p, k - 1, caches + 1);
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        poly_exp_t step = tmp->next != NULL ? tmp->exp - tmp->next->exp : tmp->exp;
+        if (step > 0 && !PolyIsZero(&res)) {
+            Poly product = PolyMul(&res, PowCacheGet(&caches[0], step));
+            PolyDestroy(&res);
+            res = product;
+        }
+        if (tmp->next != NULL) {
+            Poly coeff = PolyComposeHorner(&tmp->next->p, k - 1, caches + 1);
+            PolyAddInPlace(&res, &coeff, false, true);
+        }
+    }
+    return res;
+}
+
+/**
+ * Składa gęste wielomiany jednej zmiennej zapisane w tablicach metodą
+ * „dziel i zwyciężaj”: `p(q) = p_lo(q) + q^h p_hi(q)`, gdzie `h` jest
+ * największą potęgą dwójki mniejszą od długości @p p. Iloczyny liczone
+ * są funkcją DenseMul.
+ * @param[in] p : współczynniki wielomianu zewnętrznego
+ * @param[in] n : długość @p p (dodatnia)
+ * @param[in] pows : `pows[i]` to współczynniki `q^(2^i)`, `2^i m + 1` elementów
+ * @param[in] m : stopień `q`
+ * @param[out] res : wynik, `(n - 1) m + 1` współczynników
+ */
+static void DenseCompose(const unsigned long p[], unsigned n, unsigned long *const pows[],
+                         unsigned m, unsigned long res[])
+{
+    if (n == 1) {
+        res[0] = p[0];
+        return;
+    }
+    unsigned level = 0;
+    while ((2u << level) < n) {
+        level++;
+    }
+    unsigned h = 1u << level;
+    unsigned len = (n - 1) * m + 1;
+    unsigned pad = h * m + 1;
+    unsigned long *high = (unsigned long*) calloc(7 * (unsigned long) pad + 256,
+                                                  sizeof(unsigned long));
+    assert(high != NULL);
+    unsigned long *product = high + pad;
+    unsigned long *scratch = product + 2 * pad - 1;
+    DenseCompose(p, h, pows, m, res);
+    for (unsigned i = (h - 1) * m + 1; i < len; i++) {
+        res[i] = 0;
+    }
+    DenseCompose(p + h, n - h, pows, m, high);
+    DenseMul(pows[level], high, pad, product, scratch);
+    for (unsigned i = 0; i < len; i++) {
+        res[i] += product[i];
+    }
+    free(high);
+}
+
+/**
+ * Składa wielomiany jednej zmiennej zapisane w tablicach funkcją
+ * DenseCompose. Potęgi `q^(2^i)` liczone są kolejnymi podniesieniami do
+ * kwadratu funkcją DenseSquare.
+ * @param[in] p : współczynniki wielomianu zewnętrznego
+ * @param[in] n : długość @p p (dodatnia)
+ * @param[in] q : współczynniki wielomianu wewnętrznego
+ * @param[in] m : stopień @p q (dodatni)
+ * @param[out] res : wynik, `(n - 1) m + 1` współczynników
+ */
+static void DenseComposeArray(const unsigned long p[], unsigned n, const unsigned long q[],
+                              unsigned m, unsigned long res[])
+{
+    unsigned levels = 1;
+    while ((2u << (levels - 1)) < n) {
+        levels++;
+    }
+    unsigned long **pows = (unsigned long**) malloc(sizeof(unsigned long*) * levels);
+    assert(pows != NULL);
+    pows[0] = (unsigned long*) malloc(sizeof(unsigned long) * (m + 1));
+    assert(pows[0] != NULL);
+    for (unsigned i = 0; i <= m; i++) {
+        pows[0][i] = q[i];
+    }
+    for (unsigned i = 1; i < levels; i++) {
+        unsigned half = (1u << (i - 1)) * m + 1;
+        unsigned long *square = (unsigned long*) malloc(sizeof(unsigned long) * (6 * half + 64));
+        assert(square != NULL);
+        DenseSquare(pows[i - 1], half, square, square + 2 * half);
+        pows[i] = square;
+    }
+    DenseCompose(p, n, pows, m, res);
+    for (unsigned i = 0; i < levels; i++) {
+        free(pows[i]);
+    }
+    free(pows);
+}
+
+/**
+ * Składa gęsty wielomian jednej zmiennej @p p z gęstym wielomianem jednej
+ * zmiennej @p q na tablicach funkcją DenseComposeArray.
+ * @param[in] p : gęsty wielomian o stałych współczynnikach
+ * @param[in] q : gęsty wielomian o stałych współczynnikach
+ * @return `p(q)`
+ */
+static Poly PolyComposeDense(const Poly *p, const Poly *q)
+{
+    unsigned n = (unsigned) p->type.m->exp + 1;
+    unsigned m = (unsigned) q->type.m->exp;
+    unsigned long *a = PolyToDense(p, 0, n);
+    unsigned long *b = PolyToDense(q, 0, m + 1);
+    unsigned len = (n - 1) * m + 1;
+    unsigned long *res = (unsigned long*) malloc(sizeof(unsigned long) * len);
+    assert(res != NULL);
+    DenseComposeArray(a, n, b, m, res);
+    Poly composed = PolyFromDense(res, len, 0);
+    free(a);
+    free(b);
+    free(res);
+    return composed;
+}
+
+/**
+ * Składa wielomian @p p z wielomianami @p q: pod zmienną `x_i` podstawia
+ * `q[i]` dla `i < k`, a pod pozostałe zmienne zero.
+ * Gęste wielomiany jednej zmiennej składane są na tablicach metodą
+ * „dziel i zwyciężaj”, a pozostałe schematem Hornera z tablicą potęg
+ * każdego podstawianego wielomianu, wspólną dla wszystkich współczynników.
+ * @param[in] p : wielomian
+ * @param[in] k : liczba podstawianych wielomianów
+ * @param[in] q : tablica @p k wielomianów
+ * @return `p(q[0], ..., q[k-1], 0, 0, ...)`
+ */
+Poly PolyCompose(const Poly *p, unsigned k, const Poly q[])
+{
+    if (k > 0 && !PolyIsZero(p) && !PolyIsCoeff(p)
+        && !PolyIsZero(&q[0]) && !PolyIsCoeff(&q[0])) {
+        poly_exp_t p_min, q_min;
+        unsigned p_count, q_count;
+        if (PolyIsDense(p, &p_min, &p_count) && PolyIsDense(&q[0], &q_min, &q_count)
+            && p->type.m->exp >= COMPOSE_DENSE_MIN
+            && (unsigned long) p->type.m->exp < 2 * (unsigned long) p_count
+            && (unsigned long) q[0].type.m->exp < 2 * (unsigned long) q_count) {
+            return PolyComposeDense(p, &q[0]);
+        }
+    }
+    PowCache *caches = (PowCache*) calloc(k + 1, sizeof(PowCache));
+    assert(caches != NULL);
+    for (unsigned i = 0; i < k; i++) {
+        caches[i].base = &q[i];
+    }
+    Poly res = PolyComposeHorner(p, k, caches);
+    for (unsigned i = 0; i < k; i++) {
+        for (unsigned j = 0; j < caches[i].used; j++) {
+            PolyDestroy(&caches[i].pows[j]);
+        }
+        free(caches[i].exps);
+        free(caches[i].pows);
+    }
+    free(caches);
+    return res;
+}
+
+/** Długość ilorazu i dzielnika, od której dzielenie liczone jest metodą Newtona */
+#define DIV_NEWTON_MIN 64
+
+/**
+ * Wyznacza odwrotność nieparzystego współczynnika modulo 2^64 iteracją
+ * Newtona `x <- x (2 - c x)` (każdy krok podwaja liczbę poprawnych bitów,
+ * a `c` jest swoją odwrotnością modulo 8).
+ * @param[in] c : nieparzysty współczynnik
+ * @return `c^(-1)` modulo 2^64
+ */
+static poly_coeff_t CoeffInverse(poly_coeff_t c)
+{
+    unsigned long a = (unsigned long) c, x = a;
+    for (int i = 0; i < 5; i++) {
+        x *= 2 - a * x;
+    }
+    return (poly_coeff_t) x;
+}
+
+/**
+ * Odwraca szereg potęgowy modulo `x^k` iteracją Newtona `g <- g (2 - f g)`.
+ * Po kroku z `len` poprawnymi współczynnikami `f g = 1 + x^len h`, więc
+ * nowe współczynniki `g` od `len` do `2 len - 1` to `-(g h)`. Oba iloczyny
+ * liczone są tylko do potrzebnej długości funkcją DenseMulTrunc.
+ * @param[in] f : współczynniki szeregu (`f[0]` nieparzysty)
+ * @param[in] nf : długość @p f
+ * @param[in] k : liczba wyznaczanych współczynników (dodatnia)
+ * @param[out] g : `f^(-1)` modulo `x^k`, @p k współczynników
+ */
+static void DenseInverse(const unsigned long f[], unsigned nf, unsigned k, unsigned long g[])
+{
+    unsigned long *product = (unsigned long*) malloc(sizeof(unsigned long) * 2 * k);
+    assert(product != NULL);
+    g[0] = (unsigned long) CoeffInverse((poly_coeff_t) f[0]);
+    for (unsigned len = 1; len < k;) {
+        unsigned next = 2 * len < k ? 2 * len : k;
+        unsigned nf_next = nf < next ? nf : next;
+        DenseMulTrunc(f, nf_next, g, len, next, product);
+        unsigned long *h = product + len;
+        unsigned nh = next - len;
+        unsigned long *correction = (unsigned long*) malloc(sizeof(unsigned long) * nh);
+        assert(correction != NULL);
+        DenseMulTrunc(g, len, h, nh, nh, correction);
+        for (unsigned i = 0; i < nh; i++) {
+            g[len + i] = -correction[i];
+        }
+        free(correction);
+        len = next;
+    }
+    free(product);
+}
+
+/**
+ * Dzieli z resztą gęste wielomiany jednej zmiennej zapisane w tablicach
+ * (od wykładnika 0). Przy krótkim ilorazie albo dzielniku dzielenie jest
+ * szkolne, a w przeciwnym razie iloraz wyznaczany jest z odwróconych
+ * tablic: `rev(quot) = rev(p) rev(q)^(-1)` modulo `x^(n - m)`.
+ * @param[in] p : współczynniki dzielnej
+ * @param[in] n : długość @p p
+ * @param[in] q : współczynniki dzielnika (`q[m - 1]` nieparzysty)
+ * @param[in] m : długość @p q (nie większa niż @p n)
+ * @param[out] quot : iloraz, `n - m + 1` współczynników
+ * @param[out] rem : reszta, `m - 1` współczynników
+ */
+static void DenseDivRem(const unsigned long p[], unsigned n, const unsigned long q[],
+                        unsigned m, unsigned long quot[], unsigned long rem[])
+{
+    unsigned k = n - m + 1;
+    if (k < DIV_NEWTON_MIN || m < DIV_NEWTON_MIN) {
+        unsigned long inverse = (unsigned long) CoeffInverse((poly_coeff_t) q[m - 1]);
+        unsigned long *r = (unsigned long*) malloc(sizeof(unsigned long) * n);
+        assert(r != NULL);
+        for (unsigned i = 0; i < n; i++) {
+            r[i] = p[i];
+        }
+        for (unsigned i = k; i-- > 0;) {
+            unsigned long c = r[i + m - 1] * inverse;
+            quot[i] = c;
+            for (unsigned j = 0; j < m; j++) {
+                r[i + j] -= c * q[j];
+            }
+        }
+        for (unsigned i = 0; i + 1 < m; i++) {
+            rem[i] = r[i];
+        }
+        free(r);
+        return;
+    }
+    unsigned long *rev = (unsigned long*) malloc(sizeof(unsigned long) * (2 * k + m));
+    assert(rev != NULL);
+    unsigned long *inverse = rev + k;
+    unsigned long *rev_q = inverse + k;
+    for (unsigned i = 0; i < m; i++) {
+        rev_q[i] = q[m - 1 - i];
+    }
+    DenseInverse(rev_q, m, k, inverse);
+    for (unsigned i = 0; i < k; i++) {
+        rev[i] = p[n - 1 - i];
+    }
+    unsigned long *product = (unsigned long*) malloc(sizeof(unsigned long) * (n + k));
+    assert(product != NULL);
+    DenseMulAny(rev, k, inverse, k, product);
+    for (unsigned i = 0; i < k; i++) {
+        quot[i] = product[k - 1 - i];
+    }
+    DenseMulAny(q, m, quot, k, product);
+    for (unsigned i = 0; i + 1 < m; i++) {
+        rem[i] = p[i] - product[i];
+    }
+    free(product);
+    free(rev);
+}
+
+/**
+ * Dzieli z resztą wielomiany jednej zmiennej o stałych, gęsto ułożonych
+ * od wykładnika 0 współczynnikach funkcją DenseDivRem.
+ * @param[in] p : dzielna
+ * @param[in] q : dzielnik stopnia nie większego niż stopień @p p
+ * @param[out] quot : iloraz
+ * @param[out] rem : reszta
+ */
+static void PolyDivRemDense(const Poly *p, const Poly *q, Poly *quot, Poly *rem)
+{
+    unsigned n = (unsigned) p->type.m->exp + 1;
+    unsigned m = (unsigned) q->type.m->exp + 1;
+    unsigned long *a = PolyToDense(p, 0, n);
+    unsigned long *b = PolyToDense(q, 0, m);
+    unsigned long *res = (unsigned long*) malloc(sizeof(unsigned long) * n);
+    assert(res != NULL);
+    DenseDivRem(a, n, b, m, res, res + n - m + 1);
+    *quot = PolyFromDense(res, n - m + 1, 0);
+    *rem = PolyFromDense(res + n - m + 1, m - 1, 0);
+    free(a);
+    free(b);
+    free(res);
+}
+
+/**
+ * Dzieli z resztą wielomiany szkolnie na listach jednomianów: od reszty
+ * odejmowany jest iloczyn dzielnika i jednomianu, który skraca jej
+ * wiodący jednomian.
+ * @param[in] p : dzielna
+ * @param[in] q : dzielnik o nieparzystym stałym wiodącym współczynniku
+ * @param[out] quot : iloraz
+ * @param[out] rem : reszta
+ */
+static void PolyDivRemSparse(const Poly *p, const Poly *q, Poly *quot, Poly *rem)
+{
+    poly_coeff_t inverse = CoeffInverse(q->type.m->p.type.c);
+    poly_exp_t deg_q = q->type.m->exp;
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    *rem = PolyClone(p);
+    while (!PolyIsZero(rem) && !PolyIsCoeff(rem) && rem->type.m->exp >= deg_q) {
+        Poly c = PolyScaleCoeff(&rem->type.m->p, inverse);
+        Poly term = PolyFromList(MonoNew(c, rem->type.m->exp - deg_q));
+        Poly product = PolyMul(&term, q);
+        PolyAddInPlace(rem, &product, true, true);
+        wanderer->next = term.tag == COMPLEX ? term.type.m : MonoNew(term, 0);
+        wanderer = wanderer->next;
+    }
+    *quot = PolyFromList(doll.next);
+}
+
+/**
+ * Dzieli z resztą wielomian @p p przez wielomian @p q względem pierwszej
+ * zmiennej: `p = quot * q + rem`, gdzie stopień @p rem względem pierwszej
+ * zmiennej jest mniejszy niż stopień @p q. Współczynniki traktowane są
+ * jak liczby modulo 2^64 (tak jak przy przepełnieniu), więc dzielenie jest
+ * możliwe, gdy wiodący współczynnik @p q jest nieparzystą liczbą.
+ * Gęste wielomiany jednej zmiennej dzielone są na tablicach: krótkie
+ * szkolnie, a długie metodą Newtona, w pozostałych przypadkach dzielenie
+ * jest szkolne na listach jednomianów.
+ * @param[in] p : dzielna
+ * @param[in] q : dzielnik
+ * @param[out] quot : iloraz (zero, jeśli dzielenie nie jest możliwe)
+ * @param[out] rem : reszta (zero, jeśli dzielenie nie jest możliwe)
+ * @return czy dzielenie było możliwe
+ */
+bool PolyDivRem(const Poly *p, const Poly *q, Poly *quot, Poly *rem)
+{
+    *quot = PolyZero();
+    *rem = PolyZero();
+    if (PolyIsZero(q)) {
+        return false;
+    } else if (PolyIsCoeff(q)) {
+        if (q->type.c % 2 == 0) {
+            return false;
+        }
+        *quot = PolyScaleCoeff(p, CoeffInverse(q->type.c));
+        return true;
+    } else if (!PolyIsCoeff(&q->type.m->p) || q->type.m->p.type.c % 2 == 0) {
+        return false;
+    } else if (PolyIsZero(p) || PolyIsCoeff(p) || p->type.m->exp < q->type.m->exp) {
+        *rem = PolyClone(p);
+        return true;
+    }
+    poly_exp_t min_p, min_q;
+    unsigned count_p, count_q;
+    if (PolyIsDense(p, &min_p, &count_p) && PolyIsDense(q, &min_q, &count_q)
+        && (unsigned long) p->type.m->exp < 2 * (unsigned long) count_p
+        && (unsigned long) q->type.m->exp < 2 * (unsigned long) count_q) {
+        PolyDivRemDense(p, q, quot, rem);
+    } else {
+        PolyDivRemSparse(p, q, quot, rem);
+    }
+    return true;
+}
+
+/** Liczba punktów, w których PolyDivides porównuje wartości przed dzieleniem */
+#define DIVIDES_EVAL_POINTS 4
+
+/** Ograniczenie wartości, przy którym obliczenie w punkcie jest dokładne (2^62) */
+#define EVAL_EXACT_LIMIT 4611686018427387904.0
+
+/**
+ * Dzieli dokładnie wielomian przez niezerowy współczynnik: każdy
+ * współczynnik @p p musi dzielić się przez @p d bez reszty.
+ * @param[in] p : wielomian
+ * @param[in] d : niezerowy współczynnik
+ * @param[out] quot : iloraz (nieokreślony, jeśli dzielenie się nie udało)
+ * @return czy @p d dzieli @p p
+ */
+static bool PolyDivExactCoeff(const Poly *p, poly_coeff_t d, Poly *quot)
+{
+    if (PolyIsZero(p)) {
+        *quot = PolyZero();
+        return true;
+    } else if (PolyIsCoeff(p)) {
+        if (d == -1) {
+            *quot = PolyFromCoeff(-p->type.c);
+            return true;
+        } else if (p->type.c % d != 0) {
+            return false;
+        }
+        *quot = PolyFromCoeff(p->type.c / d);
+        return true;
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly c;
+        if (!PolyDivExactCoeff(&tmp->p, d, &c)) {
+            Poly partial = PolyFromList(doll.next);
+            PolyDestroy(&partial);
+            return false;
+        }
+        wanderer->next = MonoNew(c, tmp->exp);
+        wanderer = wanderer->next;
+    }
+    *quot = PolyFromList(doll.next);
+    return true;
+}
+
+/** Element kopca iloczynów w dzieleniu dokładnym */
+typedef struct DivHeapEntry
+{
+    poly_exp_t exp; ///< wykładnik iloczynu
+    unsigned i;     ///< indeks jednomianu dzielnika
+    unsigned j;     ///< indeks jednomianu ilorazu
+} DivHeapEntry;
+
+/**
+ * Wstawia element do kopca (największy wykładnik na szczycie).
+ * @param[in,out] heap : kopiec
+ * @param[in,out] size : liczba elementów kopca
+ * @param[in] entry : wstawiany element
+ */
+static void DivHeapPush(DivHeapEntry heap[], unsigned *size, DivHeapEntry entry)
+{
+    unsigned i = (*size)++;
+    while (i > 0 && heap[(i - 1) / 2].exp < entry.exp) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = entry;
+}
+
+/**
+ * Zdejmuje szczyt kopca.
+ * @param[in,out] heap : niepusty kopiec
+ * @param[in,out] size : liczba elementów kopca
+ * @return element o największym wykładniku
+ */
+static DivHeapEntry DivHeapPop(DivHeapEntry heap[], unsigned *size)
+{
+    DivHeapEntry top = heap[0];
+    DivHeapEntry moved = heap[--(*size)];
+    unsigned i = 0;
+    while (2 * i + 1 < *size) {
+        unsigned child = 2 * i + 1;
+        if (child + 1 < *size && heap[child + 1].exp > heap[child].exp) {
+            child++;
+        }
+        if (heap[child].exp <= moved.exp) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (*size > 0) {
+        heap[i] = moved;
+    }
+    return top;
+}
+
+/**
+ * Dzieli dokładnie wielomian przez wielomian metodą Johnsona: jednomiany
+ * reszty nie są zapisywane, tylko wyznaczane po kolei (od największego
+ * wykładnika) z jednomianów @p p i iloczynów `q_i * quot_j` trzymanych
+ * w kopcu, po jednym na każdy jednomian ilorazu. Współczynniki przy
+ * pierwszej zmiennej dzielone są rekurencyjnie. Dzielenie jest przerywane
+ * przy pierwszym jednomianie reszty, którego nie da się skrócić.
+ * @param[in] p : dzielna
+ * @param[in] q : niezerowy dzielnik
+ * @param[out] quot : iloraz (nieokreślony, jeśli dzielenie się nie udało)
+ * @return czy @p q dzieli @p p
+ */
+static bool PolyDivExactHeap(const Poly *p, const Poly *q, Poly *quot)
+{
+    if (PolyIsZero(p)) {
+        *quot = PolyZero();
+        return true;
+    } else if (PolyIsCoeff(q)) {
+        return PolyDivExactCoeff(p, q->type.c, quot);
+    } else if (PolyIsCoeff(p) || p->type.m->exp < q->type.m->exp) {
+        return false;
+    }
+    unsigned count_q = 0;
+    for (Mono *tmp = q->type.m; tmp != NULL; tmp = tmp->next) {
+        count_q++;
+    }
+    Mono **monos_q = (Mono**) malloc(sizeof(Mono*) * count_q);
+    assert(monos_q != NULL);
+    count_q = 0;
+    for (Mono *tmp = q->type.m; tmp != NULL; tmp = tmp->next) {
+        monos_q[count_q++] = tmp;
+    }
+    unsigned count = 0, size = 0, capacity = 16;
+    Mono *quot_monos = (Mono*) malloc(sizeof(Mono) * capacity);
+    DivHeapEntry *heap = (DivHeapEntry*) malloc(sizeof(DivHeapEntry) * capacity);
+    assert(quot_monos != NULL && heap != NULL);
+    poly_exp_t deg_q = monos_q[0]->exp;
+    const Mono *next_p = p->type.m;
+    bool divides = true;
+    while (divides && (next_p != NULL || size > 0)) {
+        poly_exp_t exp = next_p != NULL ? next_p->exp : heap[0].exp;
+        if (size > 0 && heap[0].exp > exp) {
+            exp = heap[0].exp;
+        }
+        Poly c = PolyZero();
+        if (next_p != NULL && next_p->exp == exp) {
+            c = PolyClone(&next_p->p);
+            next_p = next_p->next;
+        }
+        poly_coeff_t coeff_sum = 0;
+        while (size > 0 && heap[0].exp == exp) {
+            DivHeapEntry top = DivHeapPop(heap, &size);
+            const Poly *factor_q = &monos_q[top.i]->p, *factor_quot = &quot_monos[top.j].p;
+            if (PolyIsCoeff(factor_q) && PolyIsCoeff(factor_quot)) {
+                coeff_sum -= factor_q->type.c * factor_quot->type.c;
+            } else {
+                Poly product = PolyMul(factor_q, factor_quot);
+                PolyAddInPlace(&c, &product, true, true);
+            }
+            if (top.i + 1 < count_q) {
+                top.i++;
+                top.exp = monos_q[top.i]->exp + quot_monos[top.j].exp;
+                DivHeapPush(heap, &size, top);
+            }
+        }
+        PolyAddCoeffInPlace(&c, coeff_sum);
+        if (PolyIsZero(&c)) {
+            continue;
+        }
+        Poly t;
+        divides = exp >= deg_q && PolyDivExactHeap(&c, &monos_q[0]->p, &t);
+        PolyDestroy(&c);
+        if (!divides) {
+            break;
+        }
+        if (count == capacity) {
+            capacity *= 2;
+            quot_monos = (Mono*) realloc(quot_monos, sizeof(Mono) * capacity);
+            heap = (DivHeapEntry*) realloc(heap, sizeof(DivHeapEntry) * capacity);
+            assert(quot_monos != NULL && heap != NULL);
+        }
+        quot_monos[count].p = t;
+        quot_monos[count].exp = exp - deg_q;
+        if (count_q > 1) {
+            DivHeapEntry entry = {monos_q[1]->exp + exp - deg_q, 1, count};
+            DivHeapPush(heap, &size, entry);
+        }
+        count++;
+    }
+    if (divides) {
+        Mono doll;
+        doll.next = NULL;
+        Mono *wanderer = &doll;
+        for (unsigned j = 0; j < count; j++) {
+            wanderer->next = MonoNew(quot_monos[j].p, quot_monos[j].exp);
+            wanderer = wanderer->next;
+        }
+        *quot = PolyFromList(doll.next);
+    } else {
+        for (unsigned j = 0; j < count; j++) {
+            PolyDestroy(&quot_monos[j].p);
+        }
+    }
+    free(monos_q);
+    free(quot_monos);
+    free(heap);
+    return divides;
+}
+
+/**
+ * Zwraca liczbę zmiennych, od których może zależeć wielomian (głębokość
+ * zagnieżdżenia współczynników).
+ * @param[in] p : wielomian
+ * @return głębokość @p p
+ */
+static unsigned PolyDepth(const Poly *p)
+{
+    unsigned depth = 0;
+    if (!PolyIsZero(p) && !PolyIsCoeff(p)) {
+        for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+            unsigned sub = PolyDepth(&tmp->p) + 1;
+            depth = sub > depth ? sub : depth;
+        }
+    }
+    return depth;
+}
+
+/**
+ * Wyznacza stopnie wielomianu względem kolejnych zmiennych, zwiększając
+ * @p degs (`degs[i]` to stopień względem `x_i`).
+ * @param[in] p : wielomian
+ * @param[in,out] degs : tablica stopni, co najmniej głębokość @p p
+ */
+static void PolyDegrees(const Poly *p, poly_exp_t degs[])
+{
+    if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        return;
+    }
+    degs[0] = p->type.m->exp > degs[0] ? p->type.m->exp : degs[0];
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        PolyDegrees(&tmp->p, degs + 1);
+    }
+}
+
+/**
+ * Podnosi liczbę zmiennoprzecinkową do potęgi.
+ * @param[in] x : podstawa
+ * @param[in] n : wykładnik
+ * @return `x^n`
+ */
+static double DoublePow(double x, unsigned n)
+{
+    double res = 1;
+    while (n > 0) {
+        if (n & 1) {
+            res *= x;
+        }
+        x *= x;
+        n >>= 1;
+    }
+    return res;
+}
+
+/**
+ * Wylicza wartość wielomianu w punkcie schematem Hornera, razem
+ * z ograniczeniem jej modułu (wartością wielomianu o modułach
+ * współczynników w punkcie o modułach współrzędnych). Wynik jest dokładny,
+ * jeśli ograniczenie jest mniejsze niż EVAL_EXACT_LIMIT.
+ * @param[in] p : wielomian
+ * @param[in] point : współrzędne punktu, co najmniej głębokość @p p
+ * @param[out] bound : ograniczenie modułu wyniku
+ * @return wartość @p p w punkcie (modulo 2^64)
+ */
+static poly_coeff_t PolyEvalBounded(const Poly *p, const poly_coeff_t point[], double *bound)
+{
+    if (PolyIsZero(p)) {
+        *bound = 0;
+        return 0;
+    } else if (PolyIsCoeff(p)) {
+        *bound = p->type.c < 0 ? -(double) p->type.c : (double) p->type.c;
+        return p->type.c;
+    }
+    double abs_x = point[0] < 0 ? -(double) point[0] : (double) point[0];
+    unsigned long value = 0;
+    *bound = 0;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        double coeff_bound;
+        unsigned long coeff = (unsigned long) PolyEvalBounded(&tmp->p, point + 1, &coeff_bound);
+        poly_exp_t step = tmp->next != NULL ? tmp->exp - tmp->next->exp : tmp->exp;
+        value = (value + coeff) * (unsigned long) CoeffPow(point[0], (unsigned) step);
+        *bound = (*bound + coeff_bound) * DoublePow(abs_x, (unsigned) step);
+    }
+    return (poly_coeff_t) value;
+}
+
+/**
+ * Sprawdza szybkie warunki konieczne podzielności @p p przez @p q:
+ * stopnie względem każdej zmiennej oraz podzielność wartości w kilku
+ * punktach (zerowym, jedynkowym i pseudolosowych), jeśli wartości
+ * da się policzyć dokładnie.
+ * @param[in] p : dzielna
+ * @param[in] q : niezerowy dzielnik
+ * @return czy @p q może dzielić @p p
+ */
+static bool PolyMayDivide(const Poly *p, const Poly *q)
+{
+    if (PolyIsZero(p)) {
+        return true;
+    }
+    unsigned depth_p = PolyDepth(p), depth_q = PolyDepth(q);
+    if (depth_q > depth_p) {
+        return false;
+    }
+    poly_exp_t *degs = (poly_exp_t*) calloc(2 * (unsigned long) depth_p + 1, sizeof(poly_exp_t));
+    poly_coeff_t *point = (poly_coeff_t*) calloc((unsigned long) depth_p + 1, sizeof(poly_coeff_t));
+    assert(degs != NULL && point != NULL);
+    PolyDegrees(p, degs);
+    PolyDegrees(q, degs + depth_p);
+    bool may_divide = true;
+    for (unsigned i = 0; i < depth_q && may_divide; i++) {
+        may_divide = degs[depth_p + i] <= degs[i];
+    }
+    unsigned long seed = 0x9E3779B97F4A7C15UL;
+    for (unsigned k = 0; k < DIVIDES_EVAL_POINTS && may_divide; k++) {
+        for (unsigned i = 0; i < depth_p; i++) {
+            seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+            point[i] = k < 2 ? (poly_coeff_t) k : (poly_coeff_t) (seed >> 61) - 3;
+        }
+        double bound_p, bound_q;
+        poly_coeff_t value_p = PolyEvalBounded(p, point, &bound_p);
+        poly_coeff_t value_q = PolyEvalBounded(q, point, &bound_q);
+        if (bound_p >= EVAL_EXACT_LIMIT || bound_q >= EVAL_EXACT_LIMIT) {
+            continue;
+        } else if (value_q == 0) {
+            may_divide = value_p == 0;
+        } else {
+            may_divide = value_p % value_q == 0;
+        }
+    }
+    free(degs);
+    free(point);
+    return may_divide;
+}
+
+/**
+ * Dzieli dokładnie wielomian @p p przez wielomian @p q, który go dzieli
+ * (w pierścieniu wielomianów o współczynnikach całkowitych).
+ * Najpierw sprawdzane są szybkie warunki konieczne (stopnie i wartości
+ * w kilku punktach), a potem dzielenie wykonuje funkcja PolyDivExactHeap,
+ * przerywając je przy pierwszym jednomianie, którego nie da się skrócić.
+ * @param[in] p : dzielna
+ * @param[in] q : dzielnik
+ * @param[out] quot : iloraz (zero, jeśli @p q nie dzieli @p p)
+ * @return czy @p q dzieli @p p
+ */
+bool PolyDivExact(const Poly *p, const Poly *q, Poly *quot)
+{
+    *quot = PolyZero();
+    if (PolyIsZero(q) || !PolyMayDivide(p, q)) {
+        return false;
+    } else if (!PolyDivExactHeap(p, q, quot)) {
+        *quot = PolyZero();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Sprawdza, czy wielomian @p q dzieli wielomian @p p (w pierścieniu
+ * wielomianów o współczynnikach całkowitych). Zero dzieli tylko zero.
+ * @param[in] q : dzielnik
+ * @param[in] p : dzielna
+ * @return czy `p = q * t` dla pewnego wielomianu `t`
+ */
+bool PolyDivides(const Poly *q, const Poly *p)
+{
+    if (PolyIsZero(q)) {
+        return PolyIsZero(p);
+    } else if (!PolyMayDivide(p, q)) {
+        return false;
+    }
+    Poly quot;
+    bool divides = PolyDivExactHeap(p, q, &quot);
+    if (divides) {
+        PolyDestroy(&quot);
+    }
+    return divides;
+}
+
+/** Liczby pierwsze mniejsze niż 2^31, modulo których liczone są obrazy NWD */
+static const unsigned long gcd_primes[] = {
+        2147483647, 2147483629, 2147483587, 2147483579, 2147483563, 2147483549,
+        2147483543, 2147483497, 2147483489, 2147483477, 2147483423, 2147483399
+};
+
+/** Liczba liczb pierwszych w gcd_primes */
+#define GCD_PRIMES (sizeof(gcd_primes) / sizeof(gcd_primes[0]))
+
+/** Największy iloczyn modułów łączonych chińskim twierdzeniem o resztach */
+#define CRT_MODULUS_MAX (1UL << 62)
+
+/** Liczba prób heurystycznego NWD */
+#define GCDHEU_TRIES 6
+
+static Poly PolyGcdRec(const Poly *p, const Poly *q);
+
+/**
+ * Wyznacza nieujemny NWD dwóch współczynników.
+ * @param[in] a : współczynnik
+ * @param[in] b : współczynnik
+ * @return `gcd(|a|, |b|)`
+ */
+static poly_coeff_t CoeffGcd(poly_coeff_t a, poly_coeff_t b)
+{
+    unsigned long x = a < 0 ? -(unsigned long) a : (unsigned long) a;
+    unsigned long y = b < 0 ? -(unsigned long) b : (unsigned long) b;
+    while (y != 0) {
+        unsigned long r = x % y;
+        x = y;
+        y = r;
+    }
+    return (poly_coeff_t) x;
+}
+
+/**
+ * Wyznacza NWD wszystkich współczynników liczbowych wielomianu.
+ * @param[in] p : wielomian
+ * @return nieujemny NWD współczynników (0 dla zera)
+ */
+static poly_coeff_t PolyIntContent(const Poly *p)
+{
+    if (PolyIsZero(p)) {
+        return 0;
+    } else if (PolyIsCoeff(p)) {
+        return CoeffGcd(p->type.c, 0);
+    }
+    poly_coeff_t content = 0;
+    for (Mono *tmp = p->type.m; tmp != NULL && content != 1; tmp = tmp->next) {
+        content = CoeffGcd(content, PolyIntContent(&tmp->p));
+    }
+    return content;
+}
+
+/**
+ * Zwraca wiodący współczynnik liczbowy wielomianu w porządku
+ * leksykograficznym (`x_0 > x_1 > ...`), czyli współczynnik na końcu
+ * łańcucha pierwszych jednomianów.
+ * @param[in] p : niezerowy wielomian
+ * @return wiodący współczynnik
+ */
+static poly_coeff_t PolyLeadInt(const Poly *p)
+{
+    while (!PolyIsCoeff(p)) {
+        p = &p->type.m->p;
+    }
+    return p->type.c;
+}
+
+/**
+ * Zmienia w miejscu znak wielomianu, jeśli jego wiodący współczynnik
+ * liczbowy jest ujemny.
+ * @param[in,out] p : wielomian
+ */
+static void PolyNormalizeSign(Poly *p)
+{
+    if (!PolyIsZero(p) && PolyLeadInt(p) < 0) {
+        PolyNegInPlace(p);
+    }
+}
+
+/**
+ * Zwraca największy moduł współczynnika wielomianu.
+ * @param[in] p : wielomian
+ * @return największy moduł współczynnika
+ */
+static unsigned long PolyMaxNorm(const Poly *p)
+{
+    if (PolyIsZero(p)) {
+        return 0;
+    } else if (PolyIsCoeff(p)) {
+        return p->type.c < 0 ? -(unsigned long) p->type.c : (unsigned long) p->type.c;
+    }
+    unsigned long norm = 0;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        unsigned long sub = PolyMaxNorm(&tmp->p);
+        norm = sub > norm ? sub : norm;
+    }
+    return norm;
+}
+
+/**
+ * Zanurza wielomian zmiennych `x_0, x_1, ...` jako współczynnik przy
+ * `x^0` o @p levels poziomów wyżej (przesuwa indeksy zmiennych).
+ * Przejmuje na własność @p p.
+ * @param[in] p : wielomian
+ * @param[in] levels : liczba poziomów
+ * @return zanurzony wielomian
+ */
+static Poly PolyWrap(Poly p, unsigned levels)
+{
+    for (unsigned i = 0; i < levels && !PolyIsZero(&p); i++) {
+        p = PolyFromList(MonoNew(p, 0));
+    }
+    return p;
+}
+
+/**
+ * Zwraca stopień wielomianu względem pierwszej zmiennej.
+ * @param[in] p : wielomian
+ * @return stopień (-1 dla zera)
+ */
+static poly_exp_t PolyDegMain(const Poly *p)
+{
+    if (PolyIsZero(p)) {
+        return -1;
+    }
+    return PolyIsCoeff(p) ? 0 : p->type.m->exp;
+}
+
+/**
+ * Porównuje leksykograficznie ciągi wykładników.
+ * @param[in] a : ciąg wykładników
+ * @param[in] b : ciąg wykładników
+ * @param[in] n : długość ciągów
+ * @return -1, 0 albo 1, gdy @p a jest odpowiednio mniejszy, równy, większy
+ */
+static int ExpsCompare(const poly_exp_t a[], const poly_exp_t b[], unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Wyznacza ciąg wykładników jednomianu wiodącego w porządku
+ * leksykograficznym względem @p levels pierwszych zmiennych.
+ * @param[in] p : niezerowy wielomian
+ * @param[in] levels : liczba zmiennych
+ * @param[out] exps : wykładniki, @p levels elementów
+ */
+static void PolyLeadExps(const Poly *p, unsigned levels, poly_exp_t exps[])
+{
+    for (unsigned i = 0; i < levels; i++) {
+        if (PolyIsCoeff(p)) {
+            exps[i] = 0;
+        } else {
+            exps[i] = p->type.m->exp;
+            p = &p->type.m->p;
+        }
+    }
+}
+
+/**
+ * Mnoży liczby modulo @p mod (mniejsze niż 2^32).
+ * @param[in] a : liczba
+ * @param[in] b : liczba
+ * @param[in] mod : moduł
+ * @return `a * b mod mod`
+ */
+static inline unsigned long ModMul(unsigned long a, unsigned long b, unsigned long mod)
+{
+    return a * b % mod;
+}
+
+/**
+ * Podnosi liczbę do potęgi modulo @p mod.
+ * @param[in] a : liczba mniejsza niż @p mod
+ * @param[in] n : wykładnik
+ * @param[in] mod : moduł
+ * @return `a^n mod mod`
+ */
+static unsigned long ModPow(unsigned long a, unsigned long n, unsigned long mod)
+{
+    unsigned long res = 1 % mod;
+    for (; n > 0; n >>= 1) {
+        if (n & 1) {
+            res = ModMul(res, a, mod);
+        }
+        a = ModMul(a, a, mod);
+    }
+    return res;
+}
+
+/**
+ * Wyznacza odwrotność modulo liczba pierwsza @p mod z małego twierdzenia
+ * Fermata.
+ * @param[in] a : liczba niepodzielna przez @p mod
+ * @param[in] mod : liczba pierwsza
+ * @return `a^(-1) mod mod`
+ */
+static unsigned long ModInverse(unsigned long a, unsigned long mod)
+{
+    return ModPow(a, mod - 2, mod);
+}
+
+/** Liczba podstaw testu Millera–Rabina */
+#define PRIME_BASES 3
+
+/**
+ * Sprawdza, czy liczba jest pierwsza, deterministycznym testem
+ * Millera–Rabina. Podstawy 2, 7 i 61 rozstrzygają test dla wszystkich
+ * liczb mniejszych niż 4 759 123 141, a więc dla modułów mniejszych
+ * niż 2^32.
+ * @param[in] n : liczba mniejsza niż 2^32
+ * @return czy @p n jest liczbą pierwszą
+ */
+static bool IsPrime(unsigned long n)
+{
+    static const unsigned long bases[PRIME_BASES] = {2, 7, 61};
+    if (n < 2) {
+        return false;
+    }
+    for (unsigned i = 0; i < PRIME_BASES; i++) {
+        if (n % bases[i] == 0) {
+            return n == bases[i];
+        }
+    }
+    unsigned long d = n - 1;
+    unsigned r = 0;
+    while (d % 2 == 0) {
+        d /= 2;
+        r++;
+    }
+    for (unsigned i = 0; i < PRIME_BASES; i++) {
+        unsigned long x = ModPow(bases[i], d, n);
+        if (x == 1) {
+            continue;
+        }
+        for (unsigned j = 1; j < r && x != n - 1; j++) {
+            x = ModMul(x, x, n);
+        }
+        if (x != n - 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Redukuje współczynnik do przedziału `[0, mod)`.
+ * @param[in] c : współczynnik
+ * @param[in] mod : moduł
+ * @return `c mod mod`
+ */
+static inline unsigned long CoeffMod(poly_coeff_t c, unsigned long mod)
+{
+    long r = c % (long) mod;
+    return (unsigned long) (r < 0 ? r + (long) mod : r);
+}
+
+/**
+ * Zwraca długość tablicy współczynników bez zer na końcu.
+ * @param[in] a : tablica współczynników
+ * @param[in] n : długość tablicy
+ * @return długość bez zer wiodących (0 dla zera)
+ */
+static unsigned UniTrim(const unsigned long a[], unsigned n)
+{
+    while (n > 0 && a[n - 1] == 0) {
+        n--;
+    }
+    return n;
+}
+
+/**
+ * Zapisuje w tablicy wielomian jednej zmiennej o zredukowanych stałych
+ * współczynnikach (albo stałą).
+ * @param[in] leaf : wielomian
+ * @param[out] n : długość tablicy
+ * @return zaalokowana tablica (co najmniej jeden element)
+ */
+static unsigned long *UniFromLeaf(const Poly *leaf, unsigned *n)
+{
+    if (PolyIsZero(leaf) || PolyIsCoeff(leaf)) {
+        unsigned long *a = (unsigned long*) calloc(1, sizeof(unsigned long));
+        assert(a != NULL);
+        a[0] = PolyIsZero(leaf) ? 0 : (unsigned long) leaf->type.c;
+        *n = a[0] != 0;
+        return a;
+    }
+    *n = (unsigned) leaf->type.m->exp + 1;
+    return PolyToDense(leaf, 0, *n);
+}
+
+/**
+ * Dzieli z resztą wielomiany jednej zmiennej modulo liczba pierwsza.
+ * Reszta zapisywana jest w miejscu dzielnej.
+ * @param[in,out] a : dzielna, a po wywołaniu reszta
+ * @param[in] na : długość @p a
+ * @param[in] b : niezerowy dzielnik bez zer na końcu
+ * @param[in] nb : długość @p b
+ * @param[out] quot : iloraz, `na - nb + 1` elementów, albo NULL
+ * @param[in] mod : liczba pierwsza
+ * @return długość reszty
+ */
+static unsigned UniDivRem(unsigned long a[], unsigned na, const unsigned long b[],
+                          unsigned nb, unsigned long quot[], unsigned long mod)
+{
+    unsigned long inverse = ModInverse(b[nb - 1], mod);
+    na = UniTrim(a, na);
+    if (quot != NULL) {
+        for (unsigned i = 0; i + nb <= na; i++) {
+            quot[i] = 0;
+        }
+    }
+    while (na >= nb) {
+        unsigned long c = ModMul(a[na - 1], inverse, mod);
+        unsigned shift = na - nb;
+        if (quot != NULL) {
+            quot[shift] = c;
+        }
+        for (unsigned j = 0; j < nb; j++) {
+            a[shift + j] = (a[shift + j] + mod - ModMul(b[j], c, mod)) % mod;
+        }
+        na = UniTrim(a, na);
+    }
+    return na;
+}
+
+/**
+ * Mnoży wielomiany jednej zmiennej modulo @p mod.
+ * @param[in] a : tablica współczynników
+ * @param[in] na : długość @p a
+ * @param[in] b : tablica współczynników
+ * @param[in] nb : długość @p b
+ * @param[out] n : długość wyniku
+ * @param[in] mod : moduł
+ * @return zaalokowana tablica współczynników iloczynu
+ */
+static unsigned long *UniMul(const unsigned long a[], unsigned na, const unsigned long b[],
+                             unsigned nb, unsigned *n, unsigned long mod)
+{
+    *n = na > 0 && nb > 0 ? na + nb - 1 : 0;
+    unsigned long *res = (unsigned long*) calloc(*n + 1, sizeof(unsigned long));
+    assert(res != NULL);
+    for (unsigned i = 0; i < na; i++) {
+        for (unsigned j = 0; j < nb; j++) {
+            res[i + j] = (res[i + j] + ModMul(a[i], b[j], mod)) % mod;
+        }
+    }
+    return res;
+}
+
+/**
+ * Wylicza wartość wielomianu jednej zmiennej modulo @p mod.
+ * @param[in] a : tablica współczynników
+ * @param[in] n : długość @p a
+ * @param[in] x : punkt
+ * @param[in] mod : moduł
+ * @return `a(x) mod mod`
+ */
+static unsigned long UniEval(const unsigned long a[], unsigned n, unsigned long x,
+                             unsigned long mod)
+{
+    unsigned long value = 0;
+    for (unsigned i = n; i-- > 0;) {
+        value = (ModMul(value, x, mod) + a[i]) % mod;
+    }
+    return value;
+}
+
+/**
+ * Długość, od której NWD wielomianów jednej zmiennej modulo liczba
+ * pierwsza liczony jest algorytmem „połowicznego NWD” (dla krótszych
+ * algorytm Euklidesa jest szybszy)
+ */
+#define GCD_HALF_MIN 2048
+
+/** Długość, poniżej której połowiczny NWD liczony jest algorytmem Euklidesa */
+#define HGCD_MIN 128
+
+/** Wielomian jednej zmiennej o współczynnikach modulo liczba pierwsza */
+typedef struct ModPoly
+{
+    unsigned long *c; ///< współczynniki od wykładnika 0
+    unsigned n;       ///< liczba współczynników bez zer na końcu
+} ModPoly;
+
+/**
+ * Tworzy wielomian o @p n zerowych współczynnikach.
+ * @param[in] n : liczba współczynników
+ * @return wielomian
+ */
+static ModPoly ModPolyAlloc(unsigned n)
+{
+    ModPoly res;
+    res.c = (unsigned long*) calloc((unsigned long) n + 1, sizeof(unsigned long));
+    assert(res.c != NULL);
+    res.n = n;
+    return res;
+}
+
+/**
+ * Tworzy wielomian ze współczynników `a[k], ..., a[n - 1]`, czyli
+ * iloraz z dzielenia przez `x^k`.
+ * @param[in] a : wielomian
+ * @param[in] k : liczba pomijanych współczynników
+ * @return `a div x^k`
+ */
+static ModPoly ModPolyShift(const ModPoly *a, unsigned k)
+{
+    ModPoly res = ModPolyAlloc(a->n > k ? a->n - k : 0);
+    for (unsigned i = 0; i < res.n; i++) {
+        res.c[i] = a->c[k + i];
+    }
+    return res;
+}
+
+/**
+ * Mnoży wielomiany modulo liczba pierwsza mniejsza niż 2^32.
+ * Krótkie wielomiany mnożone są szkolnie, a długie funkcją DenseMulAny
+ * (Karatsuba) po rozbiciu współczynników na połówki 16-bitowe:
+ * sumy iloczynów połówek mieszczą się w 64 bitach, więc trzy iloczyny
+ * `lo * lo`, `hi * hi` i `(lo + hi) * (lo + hi)` są dokładne.
+ * @param[in] a : wielomian
+ * @param[in] b : wielomian
+ * @param[in] mod : moduł
+ * @return `a * b`
+ */
+static ModPoly ModPolyMul(const ModPoly *a, const ModPoly *b, unsigned long mod)
+{
+    if (a->n == 0 || b->n == 0) {
+        return ModPolyAlloc(0);
+    } else if (a->n < KARATSUBA_MIN || b->n < KARATSUBA_MIN) {
+        ModPoly res;
+        res.c = UniMul(a->c, a->n, b->c, b->n, &res.n, mod);
+        res.n = UniTrim(res.c, res.n);
+        return res;
+    }
+    unsigned n = a->n + b->n - 1;
+    unsigned long *split = (unsigned long*) malloc(
+            sizeof(unsigned long) * (2 * ((unsigned long) a->n + b->n) + 3 * (unsigned long) n));
+    assert(split != NULL);
+    unsigned long *low_a = split, *high_a = low_a + a->n;
+    unsigned long *low_b = high_a + a->n, *high_b = low_b + b->n;
+    unsigned long *low = high_b + b->n, *high = low + n, *mid = high + n;
+    for (unsigned i = 0; i < a->n; i++) {
+        low_a[i] = a->c[i] & 0xffff;
+        high_a[i] = a->c[i] >> 16;
+    }
+    for (unsigned i = 0; i < b->n; i++) {
+        low_b[i] = b->c[i] & 0xffff;
+        high_b[i] = b->c[i] >> 16;
+    }
+    DenseMulAny(low_a, a->n, low_b, b->n, low);
+    DenseMulAny(high_a, a->n, high_b, b->n, high);
+    for (unsigned i = 0; i < a->n; i++) {
+        low_a[i] += high_a[i];
+    }
+    for (unsigned i = 0; i < b->n; i++) {
+        low_b[i] += high_b[i];
+    }
+    DenseMulAny(low_a, a->n, low_b, b->n, mid);
+    unsigned long shift16 = (1UL << 16) % mod, shift32 = (1UL << 32) % mod;
+    ModPoly res = ModPolyAlloc(n);
+    for (unsigned i = 0; i < n; i++) {
+        unsigned long cross = (mid[i] - low[i] - high[i]) % mod;
+        res.c[i] = (low[i] % mod + ModMul(cross, shift16, mod)
+                    + ModMul(high[i] % mod, shift32, mod)) % mod;
+    }
+    res.n = UniTrim(res.c, n);
+    free(split);
+    return res;
+}
+
+/**
+ * Dodaje albo odejmuje wielomiany modulo @p mod.
+ * @param[in] a : wielomian
+ * @param[in] b : wielomian
+ * @param[in] negate : czy odejmować
+ * @param[in] mod : moduł
+ * @return `a + b` albo `a - b`
+ */
+static ModPoly ModPolyAdd(const ModPoly *a, const ModPoly *b, bool negate, unsigned long mod)
+{
+    ModPoly res = ModPolyAlloc(a->n > b->n ? a->n : b->n);
+    for (unsigned i = 0; i < res.n; i++) {
+        unsigned long x = i < a->n ? a->c[i] : 0, y = i < b->n ? b->c[i] : 0;
+        res.c[i] = (x + (negate && y != 0 ? mod - y : y)) % mod;
+    }
+    res.n = UniTrim(res.c, res.n);
+    return res;
+}
+
+/**
+ * Dzieli z resztą wielomiany modulo liczba pierwsza (szkolnie; w
+ * algorytmie Euklidesa ilorazy mają zwykle stopień 1).
+ * @param[in] a : dzielna
+ * @param[in] b : niezerowy dzielnik
+ * @param[out] quot : iloraz
+ * @param[out] rem : reszta
+ * @param[in] mod : liczba pierwsza
+ */
+static void ModPolyDivRem(const ModPoly *a, const ModPoly *b, ModPoly *quot, ModPoly *rem,
+                          unsigned long mod)
+{
+    unsigned nq = a->n >= b->n ? a->n - b->n + 1 : 0;
+    *rem = ModPolyShift(a, 0);
+    *quot = ModPolyAlloc(nq);
+    rem->n = UniDivRem(rem->c, rem->n, b->c, b->n, nq > 0 ? quot->c : NULL, mod);
+    quot->n = UniTrim(quot->c, nq);
+}
+
+/**
+ * Ustawia macierz 2x2 wielomianów (zapisaną wierszami) na jednostkową.
+ * @param[out] m : macierz
+ */
+static void ModMatrixIdentity(ModPoly m[4])
+{
+    for (int i = 0; i < 4; i++) {
+        m[i] = ModPolyAlloc(i == 0 || i == 3);
+        m[i].c[0] = i == 0 || i == 3;
+    }
+}
+
+/**
+ * Usuwa z pamięci macierz 2x2 wielomianów.
+ * @param[in] m : macierz
+ */
+static void ModMatrixFree(ModPoly m[4])
+{
+    for (int i = 0; i < 4; i++) {
+        free(m[i].c);
+    }
+}
+
+/**
+ * Wylicza `(c, d) = m (a, b)` dla macierzy 2x2 wielomianów.
+ * @param[in] m : macierz
+ * @param[in] a : wielomian
+ * @param[in] b : wielomian
+ * @param[out] c : `m[0] a + m[1] b`
+ * @param[out] d : `m[2] a + m[3] b`
+ * @param[in] mod : moduł
+ */
+static void ModMatrixApply(const ModPoly m[4], const ModPoly *a, const ModPoly *b,
+                           ModPoly *c, ModPoly *d, unsigned long mod)
+{
+    ModPoly *out[2] = {c, d};
+    for (int i = 0; i < 2; i++) {
+        ModPoly x = ModPolyMul(&m[2 * i], a, mod), y = ModPolyMul(&m[2 * i + 1], b, mod);
+        *out[i] = ModPolyAdd(&x, &y, false, mod);
+        free(x.c);
+        free(y.c);
+    }
+}
+
+/**
+ * Mnoży macierze 2x2 wielomianów.
+ * @param[in] a : macierz
+ * @param[in] b : macierz
+ * @param[out] res : `a b`
+ * @param[in] mod : moduł
+ */
+static void ModMatrixMul(const ModPoly a[4], const ModPoly b[4], ModPoly res[4],
+                         unsigned long mod)
+{
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            ModPoly x = ModPolyMul(&a[2 * i], &b[j], mod);
+            ModPoly y = ModPolyMul(&a[2 * i + 1], &b[2 + j], mod);
+            res[2 * i + j] = ModPolyAdd(&x, &y, false, mod);
+            free(x.c);
+            free(y.c);
+        }
+    }
+}
+
+/**
+ * Mnoży w miejscu macierz z lewej strony przez macierz kroku algorytmu
+ * Euklidesa `[[0, 1], [1, -quot]]`.
+ * @param[in,out] m : macierz
+ * @param[in] quot : iloraz z kroku
+ * @param[in] mod : moduł
+ */
+static void ModMatrixStep(ModPoly m[4], const ModPoly *quot, unsigned long mod)
+{
+    for (int j = 0; j < 2; j++) {
+        ModPoly product = ModPolyMul(quot, &m[2 + j], mod);
+        ModPoly next = ModPolyAdd(&m[j], &product, true, mod);
+        free(m[j].c);
+        free(product.c);
+        m[j] = m[2 + j];
+        m[2 + j] = next;
+    }
+}
+
+/**
+ * Uzupełnia wynik mnożenia macierzy przez górne części wielomianów do
+ * wyniku dla całych wielomianów: `m (a, b) = m (a div x^k, b div x^k) x^k
+ * + m (a mod x^k, b mod x^k)`.
+ * @param[in] m : macierz
+ * @param[in] a : wielomian
+ * @param[in] b : wielomian
+ * @param[in] k : wykładnik podziału
+ * @param[in,out] c : `m[0] (a div x^k) + m[1] (b div x^k)`, a po wywołaniu
+ * `m[0] a + m[1] b`
+ * @param[in,out] d : `m[2] (a div x^k) + m[3] (b div x^k)`, a po wywołaniu
+ * `m[2] a + m[3] b`
+ * @param[in] mod : moduł
+ */
+static void ModMatrixApplyLow(const ModPoly m[4], const ModPoly *a, const ModPoly *b,
+                              unsigned k, ModPoly *c, ModPoly *d, unsigned long mod)
+{
+    ModPoly low_a = {a->c, UniTrim(a->c, a->n < k ? a->n : k)};
+    ModPoly low_b = {b->c, UniTrim(b->c, b->n < k ? b->n : k)};
+    ModPoly low[2];
+    ModPoly *high[2] = {c, d};
+    ModMatrixApply(m, &low_a, &low_b, &low[0], &low[1], mod);
+    for (int i = 0; i < 2; i++) {
+        unsigned n = high[i]->n > 0 ? high[i]->n + k : 0;
+        ModPoly res = ModPolyAlloc(n > low[i].n ? n : low[i].n);
+        for (unsigned j = 0; j < high[i]->n; j++) {
+            res.c[j + k] = high[i]->c[j];
+        }
+        for (unsigned j = 0; j < low[i].n; j++) {
+            res.c[j] = (res.c[j] + low[i].c[j]) % mod;
+        }
+        res.n = UniTrim(res.c, res.n);
+        free(high[i]->c);
+        free(low[i].c);
+        *high[i] = res;
+    }
+}
+
+/**
+ * Połowiczny NWD: wyznacza macierz `m` przejścia algorytmu Euklidesa od
+ * pary `(a, b)` do pary kolejnych reszt `(c, d) = m (a, b)` takich, że
+ * `deg c >= h > deg d`, gdzie `h = ceil(deg a / 2)`. Macierz dla górnych
+ * połówek współczynników jest macierzą dla całych wielomianów, więc
+ * wystarczają dwa wywołania rekurencyjne na wielomianach o połowę
+ * krótszych i jedno dzielenie, a reszty dla górnych połówek zwrócone przez
+ * wywołania rekurencyjne trzeba tylko uzupełnić o dolne połówki.
+ * Krótkie wielomiany przetwarzane są algorytmem Euklidesa.
+ * @param[in] a : wielomian
+ * @param[in] b : wielomian stopnia mniejszego niż @p a
+ * @param[out] m : macierz przejścia
+ * @param[out] c : reszta stopnia co najmniej `h`
+ * @param[out] d : reszta stopnia mniejszego niż `h`
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32
+ */
+static void ModHalfGcd(const ModPoly *a, const ModPoly *b, ModPoly m[4],
+                       ModPoly *c, ModPoly *d, unsigned long mod)
+{
+    unsigned half = a->n / 2;
+    ModMatrixIdentity(m);
+    *c = ModPolyShift(a, 0);
+    *d = ModPolyShift(b, 0);
+    if (d->n <= half) {
+        return;
+    } else if (a->n < HGCD_MIN) {
+        while (d->n > half) {
+            ModPoly quot, rem;
+            ModPolyDivRem(c, d, &quot, &rem, mod);
+            ModMatrixStep(m, &quot, mod);
+            free(c->c);
+            free(quot.c);
+            *c = *d;
+            *d = rem;
+        }
+        return;
+    }
+    free(c->c);
+    free(d->c);
+    ModMatrixFree(m);
+    ModPoly a_high = ModPolyShift(a, half), b_high = ModPolyShift(b, half);
+    ModHalfGcd(&a_high, &b_high, m, c, d, mod);
+    ModMatrixApplyLow(m, a, b, half, c, d, mod);
+    free(a_high.c);
+    free(b_high.c);
+    if (d->n <= half) {
+        return;
+    }
+    ModPoly quot, rem, r[4];
+    ModPolyDivRem(c, d, &quot, &rem, mod);
+    ModMatrixStep(m, &quot, mod);
+    unsigned k = 2 * half - (d->n - 1);
+    ModPoly c_high = ModPolyShift(d, k), d_high = ModPolyShift(&rem, k);
+    ModPoly next_c, next_d;
+    ModHalfGcd(&c_high, &d_high, r, &next_c, &next_d, mod);
+    ModMatrixApplyLow(r, d, &rem, k, &next_c, &next_d, mod);
+    ModPoly product[4];
+    ModMatrixMul(r, m, product, mod);
+    ModMatrixFree(m);
+    ModMatrixFree(r);
+    for (int i = 0; i < 4; i++) {
+        m[i] = product[i];
+    }
+    free(c->c);
+    free(d->c);
+    *c = next_c;
+    *d = next_d;
+    free(quot.c);
+    free(rem.c);
+    free(c_high.c);
+    free(d_high.c);
+}
+
+/**
+ * Wyznacza unormowany NWD wielomianów modulo liczba pierwsza wraz ze
+ * współczynnikami Bézouta. Długie wielomiany skracane są połowicznym NWD,
+ * a pozostałe kroki to kroki algorytmu Euklidesa.
+ * @param[in] a : wielomian
+ * @param[in] b : wielomian
+ * @param[out] cofactors : macierz, której pierwszy wiersz `(s, t)` spełnia
+ * `s a + t b = NWD`, albo NULL
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32
+ * @return NWD o wiodącym współczynniku 1 (zero dla dwóch zer)
+ */
+static ModPoly ModGcdExt(const ModPoly *a, const ModPoly *b, ModPoly cofactors[4],
+                         unsigned long mod)
+{
+    bool swap = a->n < b->n;
+    ModPoly x = ModPolyShift(swap ? b : a, 0), y = ModPolyShift(swap ? a : b, 0);
+    ModPoly total[4];
+    ModMatrixIdentity(total);
+    if (swap) {
+        ModPoly tmp = total[0];
+        total[0] = total[1];
+        total[1] = tmp;
+        tmp = total[2];
+        total[2] = total[3];
+        total[3] = tmp;
+    }
+    while (y.n > 0) {
+        if (x.n > y.n && x.n >= GCD_HALF_MIN) {
+            ModPoly m[4], next_x, next_y;
+            ModHalfGcd(&x, &y, m, &next_x, &next_y, mod);
+            free(x.c);
+            free(y.c);
+            x = next_x;
+            y = next_y;
+            if (cofactors != NULL) {
+                ModPoly product[4];
+                ModMatrixMul(m, total, product, mod);
+                ModMatrixFree(total);
+                for (int i = 0; i < 4; i++) {
+                    total[i] = product[i];
+                }
+            }
+            ModMatrixFree(m);
+            if (y.n == 0) {
+                break;
+            }
+        }
+        ModPoly quot, rem;
+        ModPolyDivRem(&x, &y, &quot, &rem, mod);
+        if (cofactors != NULL) {
+            ModMatrixStep(total, &quot, mod);
+        }
+        free(x.c);
+        free(quot.c);
+        x = y;
+        y = rem;
+    }
+    if (x.n > 0) {
+        unsigned long inverse = ModInverse(x.c[x.n - 1], mod);
+        ModPoly *scaled[3] = {&x, &total[0], &total[1]};
+        for (int i = 0; i < 3; i++) {
+            for (unsigned j = 0; j < scaled[i]->n; j++) {
+                scaled[i]->c[j] = ModMul(scaled[i]->c[j], inverse, mod);
+            }
+        }
+    }
+    if (cofactors != NULL) {
+        for (int i = 0; i < 4; i++) {
+            cofactors[i] = total[i];
+        }
+    } else {
+        ModMatrixFree(total);
+    }
+    free(y.c);
+    return x;
+}
+
+/**
+ * Wyznacza unormowany NWD wielomianów jednej zmiennej modulo liczba
+ * pierwsza algorytmem Euklidesa, a dla długich wielomianów funkcją
+ * ModGcdExt.
+ * @param[in] a : tablica współczynników
+ * @param[in] na : długość @p a
+ * @param[in] b : tablica współczynników
+ * @param[in] nb : długość @p b
+ * @param[out] n : długość wyniku (0, jeśli oba wielomiany są zerami)
+ * @param[in] mod : liczba pierwsza
+ * @return zaalokowana tablica współczynników NWD o wiodącym współczynniku 1
+ */
+static unsigned long *UniGcd(const unsigned long a[], unsigned na, const unsigned long b[],
+                             unsigned nb, unsigned *n, unsigned long mod)
+{
+    unsigned long *x = (unsigned long*) malloc(sizeof(unsigned long) * (na + 1));
+    unsigned long *y = (unsigned long*) malloc(sizeof(unsigned long) * (nb + 1));
+    assert(x != NULL && y != NULL);
+    for (unsigned i = 0; i < na; i++) {
+        x[i] = a[i];
+    }
+    for (unsigned i = 0; i < nb; i++) {
+        y[i] = b[i];
+    }
+    na = UniTrim(x, na);
+    nb = UniTrim(y, nb);
+    if (na >= GCD_HALF_MIN && nb >= GCD_HALF_MIN) {
+        ModPoly mod_a = {x, na}, mod_b = {y, nb};
+        ModPoly gcd = ModGcdExt(&mod_a, &mod_b, NULL, mod);
+        free(x);
+        free(y);
+        *n = gcd.n;
+        return gcd.c;
+    }
+    while (nb > 0) {
+        na = UniDivRem(x, na, y, nb, NULL, mod);
+        unsigned long *swap = x;
+        x = y;
+        y = swap;
+        unsigned swap_n = na;
+        na = nb;
+        nb = swap_n;
+    }
+    if (na > 0) {
+        unsigned long inverse = ModInverse(x[na - 1], mod);
+        for (unsigned i = 0; i < na; i++) {
+            x[i] = ModMul(x[i], inverse, mod);
+        }
+    }
+    free(y);
+    *n = na;
+    return x;
+}
+
+/**
+ * Redukuje współczynniki wielomianu modulo @p mod do przedziału
+ * `[0, mod)`, pomijając jednomiany, które stały się zerami.
+ * @param[in] p : wielomian
+ * @param[in] mod : moduł
+ * @return zredukowany wielomian
+ */
+static Poly PolyMod(const Poly *p, unsigned long mod)
+{
+    if (PolyIsZero(p)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        unsigned long r = CoeffMod(p->type.c, mod);
+        return r != 0 ? PolyFromCoeff((poly_coeff_t) r) : PolyZero();
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly c = PolyMod(&tmp->p, mod);
+        if (!PolyIsZero(&c)) {
+            wanderer->next = MonoNew(c, tmp->exp);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Mnoży zredukowany wielomian przez liczbę modulo @p mod.
+ * @param[in] p : zredukowany wielomian
+ * @param[in] c : liczba z przedziału `[0, mod)`
+ * @param[in] mod : moduł
+ * @return `c * p mod mod`
+ */
+static Poly PolyModScale(const Poly *p, unsigned long c, unsigned long mod)
+{
+    Poly scaled = PolyScaleCoeff(p, (poly_coeff_t) c);
+    Poly res = PolyMod(&scaled, mod);
+    PolyDestroy(&scaled);
+    return res;
+}
+
+/*
+ * Wielomiany modulo liczba pierwsza traktowane są poniżej jako wielomiany
+ * zmiennych `x_0, ..., x_(l-1)`, których współczynnikami („liśćmi”) są
+ * wielomiany jednej zmiennej `x_l`, leżące @p level poziomów zagnieżdżenia
+ * niżej. Stała napotkana wyżej jest liściem stopnia 0.
+ */
+
+/**
+ * Wyznacza NWD wszystkich liści wielomianu modulo @p mod.
+ * @param[in] p : zredukowany wielomian
+ * @param[in] level : głębokość liści
+ * @param[in,out] acc : tablica dotychczasowego NWD
+ * @param[in,out] n : długość @p acc
+ * @param[in] mod : liczba pierwsza
+ */
+static void ModLeafGcd(const Poly *p, unsigned level, unsigned long **acc, unsigned *n,
+                       unsigned long mod)
+{
+    if (*n == 1 || PolyIsZero(p)) {
+        return;
+    } else if (level == 0 || PolyIsCoeff(p)) {
+        unsigned n_leaf, n_gcd;
+        unsigned long *leaf = UniFromLeaf(p, &n_leaf);
+        unsigned long *gcd = UniGcd(*acc, *n, leaf, n_leaf, &n_gcd, mod);
+        free(leaf);
+        free(*acc);
+        *acc = gcd;
+        *n = n_gcd;
+        return;
+    }
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        ModLeafGcd(&tmp->p, level - 1, acc, n, mod);
+    }
+}
+
+/**
+ * Mnoży albo dzieli dokładnie wszystkie liście wielomianu przez wielomian
+ * jednej zmiennej `x_l` modulo @p mod.
+ * @param[in] p : zredukowany wielomian
+ * @param[in] level : głębokość liści
+ * @param[in] a : tablica współczynników czynnika
+ * @param[in] na : długość @p a (dodatnia)
+ * @param[in] divide : czy dzielić zamiast mnożyć
+ * @param[in] mod : liczba pierwsza
+ * @return wynik
+ */
+static Poly ModLeafMulDiv(const Poly *p, unsigned level, const unsigned long a[], unsigned na,
+                          bool divide, unsigned long mod)
+{
+    if (PolyIsZero(p)) {
+        return PolyZero();
+    } else if (level == 0 || PolyIsCoeff(p)) {
+        unsigned n_leaf, n;
+        unsigned long *leaf = UniFromLeaf(p, &n_leaf);
+        unsigned long *res;
+        if (divide) {
+            n = n_leaf >= na ? n_leaf - na + 1 : 0;
+            res = (unsigned long*) calloc(n + 1, sizeof(unsigned long));
+            assert(res != NULL);
+            if (n > 0) {
+                UniDivRem(leaf, n_leaf, a, na, res, mod);
+            }
+        } else {
+            res = UniMul(leaf, n_leaf, a, na, &n, mod);
+        }
+        Poly leaf_res = PolyWrap(PolyFromDense(res, n, 0), level);
+        free(leaf);
+        free(res);
+        return leaf_res;
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly c = ModLeafMulDiv(&tmp->p, level - 1, a, na, divide, mod);
+        if (!PolyIsZero(&c)) {
+            wanderer->next = MonoNew(c, tmp->exp);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Podstawia @p x pod zmienną `x_l` liści wielomianu modulo @p mod.
+ * @param[in] p : zredukowany wielomian
+ * @param[in] level : głębokość liści
+ * @param[in] x : punkt
+ * @param[in] mod : liczba pierwsza
+ * @return wielomian zmiennych `x_0, ..., x_(l-1)`
+ */
+static Poly ModLeafEval(const Poly *p, unsigned level, unsigned long x, unsigned long mod)
+{
+    if (PolyIsZero(p)) {
+        return PolyZero();
+    } else if (level == 0 || PolyIsCoeff(p)) {
+        unsigned n;
+        unsigned long *leaf = UniFromLeaf(p, &n);
+        unsigned long value = UniEval(leaf, n, x, mod);
+        free(leaf);
+        return value != 0 ? PolyFromCoeff((poly_coeff_t) value) : PolyZero();
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly c = ModLeafEval(&tmp->p, level - 1, x, mod);
+        if (!PolyIsZero(&c)) {
+            wanderer->next = MonoNew(c, tmp->exp);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Zwraca największy stopień liścia wielomianu.
+ * @param[in] p : zredukowany wielomian
+ * @param[in] level : głębokość liści
+ * @return stopień względem `x_l`
+ */
+static poly_exp_t ModLeafDeg(const Poly *p, unsigned level)
+{
+    if (level == 0 || PolyIsCoeff(p) || PolyIsZero(p)) {
+        return PolyIsZero(p) || PolyIsCoeff(p) ? 0 : p->type.m->exp;
+    }
+    poly_exp_t deg = 0;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        poly_exp_t sub = ModLeafDeg(&tmp->p, level - 1);
+        deg = sub > deg ? sub : deg;
+    }
+    return deg;
+}
+
+/**
+ * Zwraca wiodący liść wielomianu w porządku leksykograficznym względem
+ * `x_0, ..., x_(l-1)`.
+ * @param[in] p : niezerowy wielomian
+ * @param[in] level : głębokość liści
+ * @return wiodący liść
+ */
+static const Poly *ModLeafLead(const Poly *p, unsigned level)
+{
+    while (level > 0 && !PolyIsCoeff(p)) {
+        p = &p->type.m->p;
+        level--;
+    }
+    return p;
+}
+
+/**
+ * Dzieli wielomian przez NWD jego liści.
+ * @param[in] p : zredukowany wielomian
+ * @param[in] level : głębokość liści
+ * @param[out] content : NWD liści (zaalokowana tablica)
+ * @param[out] n : długość @p content
+ * @param[in] mod : liczba pierwsza
+ * @return część pierwotna @p p
+ */
+static Poly ModPrimitive(const Poly *p, unsigned level, unsigned long **content, unsigned *n,
+                         unsigned long mod)
+{
+    *content = (unsigned long*) calloc(1, sizeof(unsigned long));
+    assert(*content != NULL);
+    *n = 0;
+    ModLeafGcd(p, level, content, n, mod);
+    return ModLeafMulDiv(p, level, *content, *n, true, mod);
+}
+
+/**
+ * Wyznacza NWD wielomianów @p vars zmiennych modulo liczba pierwsza
+ * algorytmem Browna: NWD zawartości (NWD liści, wielomianów ostatniej
+ * zmiennej) liczony jest osobno, a NWD części pierwotnych odtwarzany jest
+ * interpolacją Newtona względem ostatniej zmiennej z NWD obrazów w
+ * kolejnych punktach, liczonych rekurencyjnie. Obraz ma wiodący
+ * współczynnik równy wartości NWD wiodących liści, a obrazy o zbyt dużym
+ * jednomianie wiodącym (pechowe punkty) są pomijane.
+ * @param[in] a : niezerowy zredukowany wielomian
+ * @param[in] b : niezerowy zredukowany wielomian
+ * @param[in] vars : liczba zmiennych
+ * @param[in] mod : liczba pierwsza
+ * @return NWD o wiodącym współczynniku 1
+ */
+static Poly PolyGcdMod(const Poly *a, const Poly *b, unsigned vars, unsigned long mod)
+{
+    if (PolyIsCoeff(a) || PolyIsCoeff(b)) {
+        return PolyFromCoeff(1);
+    } else if (vars == 1) {
+        unsigned na, nb, n;
+        unsigned long *ua = UniFromLeaf(a, &na);
+        unsigned long *ub = UniFromLeaf(b, &nb);
+        unsigned long *gcd = UniGcd(ua, na, ub, nb, &n, mod);
+        Poly res = PolyFromDense(gcd, n, 0);
+        free(ua);
+        free(ub);
+        free(gcd);
+        return res;
+    }
+    unsigned level = vars - 1;
+    unsigned long *content_a, *content_b;
+    unsigned n_ca, n_cb, n_content, n_la, n_lb, n_lead;
+    Poly prim_a = ModPrimitive(a, level, &content_a, &n_ca, mod);
+    Poly prim_b = ModPrimitive(b, level, &content_b, &n_cb, mod);
+    unsigned long *content = UniGcd(content_a, n_ca, content_b, n_cb, &n_content, mod);
+    unsigned long *lead_a = UniFromLeaf(ModLeafLead(&prim_a, level), &n_la);
+    unsigned long *lead_b = UniFromLeaf(ModLeafLead(&prim_b, level), &n_lb);
+    unsigned long *lead = UniGcd(lead_a, n_la, lead_b, n_lb, &n_lead, mod);
+    poly_exp_t deg_a = ModLeafDeg(&prim_a, level), deg_b = ModLeafDeg(&prim_b, level);
+    unsigned long bound = (unsigned long) (deg_a < deg_b ? deg_a : deg_b) + n_lead - 1;
+    poly_exp_t *exps = (poly_exp_t*) calloc(2 * (unsigned long) level, sizeof(poly_exp_t));
+    unsigned long *basis = (unsigned long*) calloc(1, sizeof(unsigned long));
+    assert(exps != NULL && basis != NULL);
+    poly_exp_t *best = exps + level;
+    unsigned n_basis = 1;
+    basis[0] = 1;
+    unsigned long points = 0;
+    Poly interp = PolyZero();
+    for (unsigned long x = 1; x < mod && points <= bound; x++) {
+        if (UniEval(lead_a, n_la, x, mod) == 0 || UniEval(lead_b, n_lb, x, mod) == 0) {
+            continue;
+        }
+        Poly eval_a = ModLeafEval(&prim_a, level, x, mod);
+        Poly eval_b = ModLeafEval(&prim_b, level, x, mod);
+        Poly image = PolyGcdMod(&eval_a, &eval_b, level, mod);
+        PolyDestroy(&eval_a);
+        PolyDestroy(&eval_b);
+        PolyLeadExps(&image, level, exps);
+        int cmp = points == 0 ? -1 : ExpsCompare(exps, best, level);
+        if (cmp > 0) {
+            PolyDestroy(&image);
+            continue;
+        } else if (cmp < 0) {
+            PolyDestroy(&interp);
+            interp = PolyZero();
+            n_basis = 1;
+            basis[0] = 1;
+            points = 0;
+            for (unsigned i = 0; i < level; i++) {
+                best[i] = exps[i];
+            }
+        }
+        Poly scaled = PolyModScale(&image, UniEval(lead, n_lead, x, mod), mod);
+        Poly value = ModLeafEval(&interp, level, x, mod);
+        Poly diff_raw = PolySub(&scaled, &value);
+        Poly diff = PolyMod(&diff_raw, mod);
+        unsigned long weight = ModInverse(UniEval(basis, n_basis, x, mod), mod);
+        for (unsigned i = 0; i < n_basis; i++) {
+            basis[i] = ModMul(basis[i], weight, mod);
+        }
+        Poly lift = ModLeafMulDiv(&diff, level, basis, n_basis, false, mod);
+        Poly sum = PolyAdd(&interp, &lift);
+        PolyDestroy(&interp);
+        interp = PolyMod(&sum, mod);
+        unsigned long linear[2] = {mod - x, 1};
+        unsigned n_next;
+        unsigned long *next = UniMul(basis, n_basis, linear, 2, &n_next, mod);
+        free(basis);
+        basis = next;
+        n_basis = n_next;
+        points++;
+        PolyDestroy(&image);
+        PolyDestroy(&scaled);
+        PolyDestroy(&value);
+        PolyDestroy(&diff_raw);
+        PolyDestroy(&diff);
+        PolyDestroy(&lift);
+        PolyDestroy(&sum);
+    }
+    unsigned long *interp_content;
+    unsigned n_ic;
+    Poly prim = ModPrimitive(&interp, level, &interp_content, &n_ic, mod);
+    Poly gcd = ModLeafMulDiv(&prim, level, content, n_content, false, mod);
+    Poly res = PolyModScale(&gcd, ModInverse((unsigned long) PolyLeadInt(&gcd), mod), mod);
+    PolyDestroy(&prim_a);
+    PolyDestroy(&prim_b);
+    PolyDestroy(&interp);
+    PolyDestroy(&prim);
+    PolyDestroy(&gcd);
+    free(content_a);
+    free(content_b);
+    free(content);
+    free(lead_a);
+    free(lead_b);
+    free(lead);
+    free(exps);
+    free(basis);
+    free(interp_content);
+    return res;
+}
+
+/**
+ * Łączy reszty chińskim twierdzeniem o resztach. Wynik ma postać
+ * `r1 + m1 v`, gdzie `v` jest symetryczną resztą modulo @p m2, więc jest
+ * symetryczną resztą modulo `m1 * m2` (dla nieparzystych modułów),
+ * a gdy `m1 * m2` nie mieści się w 64 bitach, jest jej wartością modulo 2^64.
+ * @param[in] r1 : reszta modulo @p m1 w postaci symetrycznej
+ * @param[in] m1 : nieparzysty moduł
+ * @param[in] r2 : reszta modulo @p m2 z przedziału `[0, m2)`
+ * @param[in] m2 : liczba pierwsza niedzieląca @p m1
+ * @return reszta modulo `m1 * m2` w postaci symetrycznej
+ */
+static poly_coeff_t CoeffCrt(poly_coeff_t r1, unsigned long m1, unsigned long r2, unsigned long m2)
+{
+    unsigned long diff = (r2 + m2 - CoeffMod(r1, m2)) % m2;
+    unsigned long u = ModMul(diff, ModInverse(m1 % m2, m2), m2);
+    long v = u > m2 / 2 ? (long) u - (long) m2 : (long) u;
+    return (poly_coeff_t) ((unsigned long) r1 + m1 * (unsigned long) v);
+}
+
+/**
+ * Zwraca listę jednomianów wielomianu; stała zapisywana jest w @p tmp jako
+ * jednomian o wykładniku 0.
+ * @param[in] p : wielomian
+ * @param[out] tmp : miejsce na jednomian stałej
+ * @return lista jednomianów (NULL dla zera)
+ */
+static const Mono *PolyTerms(const Poly *p, Mono *tmp)
+{
+    if (PolyIsZero(p)) {
+        return NULL;
+    } else if (PolyIsCoeff(p)) {
+        tmp->p = *p;
+        tmp->exp = 0;
+        tmp->next = NULL;
+        return tmp;
+    }
+    return p->type.m;
+}
+
+/**
+ * Łączy współczynnik po współczynniku wielomian o resztach modulo @p m1
+ * z wielomianem o resztach modulo @p m2.
+ * @param[in] p : wielomian o współczynnikach w postaci symetrycznej
+ * @param[in] m1 : moduł
+ * @param[in] q : zredukowany wielomian
+ * @param[in] m2 : liczba pierwsza
+ * @return wielomian o resztach modulo `m1 * m2` w postaci symetrycznej
+ */
+static Poly PolyCrt(const Poly *p, unsigned long m1, const Poly *q, unsigned long m2)
+{
+    bool const_p = PolyIsZero(p) || PolyIsCoeff(p);
+    bool const_q = PolyIsZero(q) || PolyIsCoeff(q);
+    if (const_p && const_q) {
+        poly_coeff_t c = CoeffCrt(PolyIsZero(p) ? 0 : p->type.c, m1,
+                                  PolyIsZero(q) ? 0 : (unsigned long) q->type.c, m2);
+        return c != 0 ? PolyFromCoeff(c) : PolyZero();
+    }
+    Mono tmp_p, tmp_q;
+    const Mono *mono_p = PolyTerms(p, &tmp_p), *mono_q = PolyTerms(q, &tmp_q);
+    Poly zero = PolyZero();
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    while (mono_p != NULL || mono_q != NULL) {
+        poly_exp_t exp = mono_p == NULL ? mono_q->exp
+                         : mono_q == NULL ? mono_p->exp
+                         : (mono_p->exp > mono_q->exp ? mono_p->exp : mono_q->exp);
+        const Poly *sub_p = &zero, *sub_q = &zero;
+        if (mono_p != NULL && mono_p->exp == exp) {
+            sub_p = &mono_p->p;
+            mono_p = mono_p->next;
+        }
+        if (mono_q != NULL && mono_q->exp == exp) {
+            sub_q = &mono_q->p;
+            mono_q = mono_q->next;
+        }
+        Poly c = PolyCrt(sub_p, m1, sub_q, m2);
+        if (!PolyIsZero(&c)) {
+            wanderer->next = MonoNew(c, exp);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Wyznacza NWD współczynników wielomianu względem pierwszej zmiennej
+ * (wielomianów pozostałych zmiennych).
+ * @param[in] p : wielomian niebędący współczynnikiem
+ * @return zawartość @p p
+ */
+static Poly PolyContentMain(const Poly *p)
+{
+    Poly content = PolyZero();
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly next = PolyGcdRec(&content, &tmp->p);
+        PolyDestroy(&content);
+        content = next;
+        if (PolyIsCoeff(&content) && content.type.c == 1) {
+            break;
+        }
+    }
+    return content;
+}
+
+/**
+ * Dzieli wielomian przez jego zawartość względem pierwszej zmiennej
+ * i ustala dodatni znak wiodącego współczynnika.
+ * @param[in] p : wielomian niebędący współczynnikiem
+ * @param[in] content : zawartość @p p
+ * @return część pierwotna @p p
+ */
+static Poly PolyPrimitiveMain(const Poly *p, const Poly *content)
+{
+    Poly divisor = PolyWrap(PolyClone(content), 1);
+    Poly prim;
+    bool divides = PolyDivExactHeap(p, &divisor, &prim);
+    assert(divides);
+    (void) divides;
+    PolyDestroy(&divisor);
+    PolyNormalizeSign(&prim);
+    return prim;
+}
+
+/**
+ * Zwraca część pierwotną wielomianu względem pierwszej zmiennej.
+ * @param[in] p : wielomian
+ * @return część pierwotna @p p o dodatnim wiodącym współczynniku
+ */
+static Poly PolyPrimitive(const Poly *p)
+{
+    if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        return PolyIsZero(p) ? PolyZero() : PolyFromCoeff(1);
+    }
+    Poly content = PolyContentMain(p);
+    Poly prim = PolyPrimitiveMain(p, &content);
+    PolyDestroy(&content);
+    return prim;
+}
+
+/**
+ * Zwraca wielomian, którego współczynniki są symetrycznymi resztami
+ * współczynników @p p modulo @p m (z przedziału `(-m/2, m/2]`).
+ * @param[in] p : wielomian
+ * @param[in] m : moduł większy od 1
+ * @return wielomian reszt
+ */
+static Poly PolySymMod(const Poly *p, poly_coeff_t m)
+{
+    if (PolyIsZero(p)) {
+        return PolyZero();
+    } else if (PolyIsCoeff(p)) {
+        poly_coeff_t r = p->type.c % m;
+        r = r < 0 ? r + m : r;
+        r = r > m / 2 ? r - m : r;
+        return r != 0 ? PolyFromCoeff(r) : PolyZero();
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly c = PolySymMod(&tmp->p, m);
+        if (!PolyIsZero(&c)) {
+            wanderer->next = MonoNew(c, tmp->exp);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Heurystyczny NWD (Char, Geddes, Gonnet): wartości wielomianów
+ * w punkcie `x_0 = xi` mają NWD (liczony rekurencyjnie dla pozostałych
+ * zmiennych), którego rozwinięcie przy podstawie `xi` o symetrycznych
+ * cyfrach daje kandydata na NWD. Kandydat jest przyjmowany, jeśli jego
+ * część pierwotna dzieli oba wielomiany. Stosowany tylko, gdy wartości
+ * da się policzyć dokładnie.
+ * @param[in] a : wielomian pierwotny względem pierwszej zmiennej
+ * @param[in] b : wielomian pierwotny względem pierwszej zmiennej
+ * @param[out] gcd : NWD, jeśli heurystyka się powiodła
+ * @return czy heurystyka się powiodła
+ */
+static bool PolyGcdHeuristic(const Poly *a, const Poly *b, Poly *gcd)
+{
+    unsigned depth_a = PolyDepth(a), depth_b = PolyDepth(b);
+    unsigned depth = depth_a > depth_b ? depth_a : depth_b;
+    poly_coeff_t *point = (poly_coeff_t*) malloc(sizeof(poly_coeff_t) * (depth + 1));
+    assert(point != NULL);
+    for (unsigned i = 0; i <= depth; i++) {
+        point[i] = 1;
+    }
+    unsigned long norm_a = PolyMaxNorm(a), norm_b = PolyMaxNorm(b);
+    double xi = 2.0 * (double) (norm_a < norm_b ? norm_a : norm_b) + 29;
+    bool found = false;
+    for (int t = 0; t < GCDHEU_TRIES && !found; t++, xi = xi * 73794 / 27011) {
+        double bound_a, bound_b;
+        if (xi >= EVAL_EXACT_LIMIT) {
+            break;
+        }
+        point[0] = (poly_coeff_t) xi;
+        PolyEvalBounded(a, point, &bound_a);
+        PolyEvalBounded(b, point, &bound_b);
+        if (bound_a >= EVAL_EXACT_LIMIT || bound_b >= EVAL_EXACT_LIMIT) {
+            break;
+        }
+        Poly value_a = PolyAt(a, point[0]), value_b = PolyAt(b, point[0]);
+        Poly rest = PolyGcdRec(&value_a, &value_b);
+        PolyDestroy(&value_a);
+        PolyDestroy(&value_b);
+        Mono *list = NULL;
+        for (poly_exp_t i = 0; !PolyIsZero(&rest); i++) {
+            Poly digit = PolySymMod(&rest, point[0]);
+            PolyAddInPlace(&rest, &digit, true, false);
+            Poly next;
+            PolyDivExactCoeff(&rest, point[0], &next);
+            PolyDestroy(&rest);
+            rest = next;
+            if (PolyIsZero(&digit)) {
+                continue;
+            }
+            Mono *m = MonoNew(digit, i);
+            m->next = list;
+            list = m;
+        }
+        Poly candidate = PolyFromList(list);
+        *gcd = PolyPrimitive(&candidate);
+        PolyDestroy(&candidate);
+        found = PolyDegMain(gcd) > 0 && PolyDivides(gcd, a) && PolyDivides(gcd, b);
+        if (!found) {
+            PolyDestroy(gcd);
+        }
+    }
+    free(point);
+    return found;
+}
+
+/**
+ * Modularny NWD (Brown): NWD obrazów modulo kolejne liczby pierwsze
+ * (liczone funkcją PolyGcdMod i przeskalowane do wiodącego współczynnika
+ * równego NWD wiodących współczynników) łączone są chińskim twierdzeniem
+ * o resztach. Obrazy o zbyt dużym jednomianie wiodącym (pechowe liczby
+ * pierwsze) są pomijane. Kandydat jest sprawdzany dzieleniem, gdy przestaje
+ * się zmieniać albo gdy iloczyn modułów osiąga CRT_MODULUS_MAX.
+ * @param[in] a : wielomian pierwotny względem pierwszej zmiennej
+ * @param[in] b : wielomian pierwotny względem pierwszej zmiennej
+ * @param[out] gcd : NWD, jeśli udało się go wyznaczyć
+ * @return czy udało się wyznaczyć NWD
+ */
+static bool PolyGcdModular(const Poly *a, const Poly *b, Poly *gcd)
+{
+    unsigned depth_a = PolyDepth(a), depth_b = PolyDepth(b);
+    unsigned vars = depth_a > depth_b ? depth_a : depth_b;
+    poly_coeff_t lead_a = PolyLeadInt(a), lead_b = PolyLeadInt(b);
+    poly_coeff_t lead = CoeffGcd(lead_a, lead_b);
+    poly_exp_t *exps = (poly_exp_t*) calloc(2 * (unsigned long) vars, sizeof(poly_exp_t));
+    assert(exps != NULL);
+    poly_exp_t *best = exps + vars;
+    Poly crt = PolyZero();
+    unsigned long modulus = 1;
+    bool found = false;
+    for (unsigned k = 0; k < GCD_PRIMES && !found; k++) {
+        unsigned long mod = gcd_primes[k];
+        if (CoeffMod(lead_a, mod) == 0 || CoeffMod(lead_b, mod) == 0) {
+            continue;
+        }
+        Poly mod_a = PolyMod(a, mod), mod_b = PolyMod(b, mod);
+        Poly image = PolyGcdMod(&mod_a, &mod_b, vars, mod);
+        PolyDestroy(&mod_a);
+        PolyDestroy(&mod_b);
+        if (PolyIsCoeff(&image)) {
+            *gcd = PolyFromCoeff(1);
+            found = true;
+            break;
+        }
+        PolyLeadExps(&image, vars, exps);
+        int cmp = modulus == 1 ? -1 : ExpsCompare(exps, best, vars);
+        if (cmp > 0) {
+            PolyDestroy(&image);
+            continue;
+        } else if (cmp < 0 || modulus > CRT_MODULUS_MAX / mod) {
+            PolyDestroy(&crt);
+            crt = PolyZero();
+            modulus = 1;
+            for (unsigned i = 0; i < vars; i++) {
+                best[i] = exps[i];
+            }
+        }
+        Poly scaled = PolyModScale(&image, CoeffMod(lead, mod), mod);
+        Poly combined = PolyCrt(&crt, modulus, &scaled, mod);
+        modulus *= mod;
+        bool stable = PolyIsEq(&combined, &crt);
+        PolyDestroy(&crt);
+        PolyDestroy(&image);
+        PolyDestroy(&scaled);
+        crt = combined;
+        if (stable || modulus > CRT_MODULUS_MAX / gcd_primes[0]) {
+            *gcd = PolyPrimitive(&crt);
+            found = PolyDivides(gcd, a) && PolyDivides(gcd, b);
+            if (!found) {
+                PolyDestroy(gcd);
+            }
+        }
+    }
+    PolyDestroy(&crt);
+    free(exps);
+    return found;
+}
+
+/**
+ * Wyznacza pseudoresztę z dzielenia względem pierwszej zmiennej:
+ * wiodący jednomian reszty jest skracany po pomnożeniu jej przez wiodący
+ * współczynnik dzielnika.
+ * @param[in] p : dzielna
+ * @param[in] q : dzielnik stopnia dodatniego względem pierwszej zmiennej
+ * @return pseudoreszta
+ */
+static Poly PolyPseudoRem(const Poly *p, const Poly *q)
+{
+    Poly rem = PolyClone(p);
+    Poly lead = PolyWrap(PolyClone(&q->type.m->p), 1);
+    poly_exp_t deg_q = q->type.m->exp;
+    while (PolyDegMain(&rem) >= deg_q) {
+        Poly term = PolyFromList(MonoNew(PolyClone(&rem.type.m->p), rem.type.m->exp - deg_q));
+        Poly scaled = PolyMul(&rem, &lead);
+        Poly product = PolyMul(&term, q);
+        PolyDestroy(&rem);
+        rem = PolySub(&scaled, &product);
+        PolyDestroy(&term);
+        PolyDestroy(&scaled);
+        PolyDestroy(&product);
+    }
+    PolyDestroy(&lead);
+    return rem;
+}
+
+/**
+ * Wyznacza NWD pierwotnymi ciągami reszt (algorytm Euklidesa na
+ * pseudoresztach, z których usuwana jest zawartość). Używany, gdy metoda
+ * modularna nie dała wyniku.
+ * @param[in] a : wielomian pierwotny względem pierwszej zmiennej
+ * @param[in] b : wielomian pierwotny względem pierwszej zmiennej
+ * @return NWD
+ */
+static Poly PolyGcdPrs(const Poly *a, const Poly *b)
+{
+    Poly x = PolyClone(PolyDegMain(a) >= PolyDegMain(b) ? a : b);
+    Poly y = PolyClone(PolyDegMain(a) >= PolyDegMain(b) ? b : a);
+    while (PolyDegMain(&y) > 0) {
+        Poly rem = PolyPseudoRem(&x, &y);
+        PolyDestroy(&x);
+        x = y;
+        y = PolyPrimitive(&rem);
+        if (!PolyIsZero(&rem) && PolyDegMain(&rem) == 0) {
+            PolyDestroy(&y);
+            y = PolyFromCoeff(1);
+        }
+        PolyDestroy(&rem);
+    }
+    if (!PolyIsZero(&y)) {
+        PolyDestroy(&x);
+        x = PolyFromCoeff(1);
+    }
+    PolyNormalizeSign(&x);
+    return x;
+}
+
+/**
+ * Wyznacza NWD wielomianów: NWD zawartości względem pierwszej zmiennej
+ * liczony jest rekurencyjnie, a NWD części pierwotnych heurystycznie,
+ * modularnie albo (w ostateczności) ciągami reszt.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @return NWD o dodatnim wiodącym współczynniku
+ */
+static Poly PolyGcdRec(const Poly *p, const Poly *q)
+{
+    if (PolyIsZero(p) || PolyIsZero(q)) {
+        Poly gcd = PolyClone(PolyIsZero(p) ? q : p);
+        PolyNormalizeSign(&gcd);
+        return gcd;
+    } else if (PolyIsCoeff(p) || PolyIsCoeff(q)) {
+        return PolyFromCoeff(CoeffGcd(PolyIntContent(p), PolyIntContent(q)));
+    }
+    Poly content_p = PolyContentMain(p), content_q = PolyContentMain(q);
+    Poly content = PolyGcdRec(&content_p, &content_q);
+    Poly gcd;
+    if (p->type.m->exp == 0 || q->type.m->exp == 0) {
+        gcd = PolyFromCoeff(1);
+    } else {
+        Poly prim_p = PolyPrimitiveMain(p, &content_p);
+        Poly prim_q = PolyPrimitiveMain(q, &content_q);
+        if (!PolyGcdHeuristic(&prim_p, &prim_q, &gcd)
+            && !PolyGcdModular(&prim_p, &prim_q, &gcd)) {
+            gcd = PolyGcdPrs(&prim_p, &prim_q);
+        }
+        PolyDestroy(&prim_p);
+        PolyDestroy(&prim_q);
+    }
+    Poly wrapped = PolyWrap(content, 1);
+    Poly res = PolyMul(&gcd, &wrapped);
+    PolyNormalizeSign(&res);
+    PolyDestroy(&content_p);
+    PolyDestroy(&content_q);
+    PolyDestroy(&wrapped);
+    PolyDestroy(&gcd);
+    return res;
+}
+
+/**
+ * Wyznacza największy wspólny dzielnik dwóch wielomianów (w pierścieniu
+ * wielomianów o współczynnikach całkowitych).
+ * Zawartości względem pierwszej zmiennej (NWD współczynników) liczone są
+ * rekurencyjnie, a NWD części pierwotnych najpierw heurystycznie z wartości
+ * w punkcie (dla małych danych), potem modularnie (obrazy modulo liczby
+ * pierwsze, interpolacja względem kolejnych zmiennych i chińskie
+ * twierdzenie o resztach), a w ostateczności pierwotnymi ciągami reszt.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @return NWD o dodatnim wiodącym współczynniku (zero dla dwóch zer)
+ */
+Poly PolyGcd(const Poly *p, const Poly *q)
+{
+    return PolyGcdRec(p, q);
+}
+
+/**
+ * Zapisuje wielomian jednej zmiennej o stałych współczynnikach jako
+ * wielomian modulo @p mod.
+ * @param[in] p : wielomian
+ * @param[out] res : wielomian modulo @p mod
+ * @param[in] mod : moduł
+ * @return czy @p p zależy tylko od pierwszej zmiennej
+ */
+static bool ModPolyFromPoly(const Poly *p, ModPoly *res, unsigned long mod)
+{
+    if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        *res = ModPolyAlloc(1);
+        res->c[0] = PolyIsZero(p) ? 0 : CoeffMod(p->type.c, mod);
+        res->n = UniTrim(res->c, 1);
+        return true;
+    }
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        if (!PolyIsCoeff(&tmp->p)) {
+            return false;
+        }
+    }
+    *res = ModPolyAlloc((unsigned) p->type.m->exp + 1);
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        res->c[tmp->exp] = CoeffMod(tmp->p.type.c, mod);
+    }
+    res->n = UniTrim(res->c, res->n);
+    return true;
+}
+
+/**
+ * Wyznacza NWD wielomianów jednej zmiennej `x_0` o współczynnikach modulo
+ * liczba pierwsza wraz ze współczynnikami Bézouta.
+ * Długie wielomiany przetwarzane są algorytmem „połowicznego NWD”
+ * o złożoności bliskiej mnożeniu, a nie kwadratowej.
+ * Współczynniki wyników należą do przedziału `[0, mod)`.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] gcd : NWD o wiodącym współczynniku 1 (zero dla dwóch zer)
+ * @param[out] s : wielomian, dla którego `s p + t q = gcd` modulo @p mod
+ * @param[out] t : wielomian, dla którego `s p + t q = gcd` modulo @p mod
+ * @return czy wielomiany zależą tylko od `x_0`, a moduł jest poprawny
+ * (w przeciwnym razie wyniki są zerami)
+ */
+bool PolyGcdExtMod(const Poly *p, const Poly *q, poly_coeff_t mod,
+                   Poly *gcd, Poly *s, Poly *t)
+{
+    *gcd = PolyZero();
+    *s = PolyZero();
+    *t = PolyZero();
+    ModPoly a, b;
+    if (mod < 2 || (unsigned long) mod > 0xffffffffUL || !IsPrime((unsigned long) mod)
+        || !ModPolyFromPoly(p, &a, mod)) {
+        return false;
+    } else if (!ModPolyFromPoly(q, &b, mod)) {
+        free(a.c);
+        return false;
+    }
+    ModPoly cofactors[4];
+    ModPoly res = ModGcdExt(&a, &b, cofactors, mod);
+    *gcd = PolyFromDense(res.c, res.n, 0);
+    *s = PolyFromDense(cofactors[0].c, cofactors[0].n, 0);
+    *t = PolyFromDense(cofactors[1].c, cofactors[1].n, 0);
+    ModMatrixFree(cofactors);
+    free(a.c);
+    free(b.c);
+    free(res.c);
+    return true;
+}
+
+/** Liczba liczb pierwszych, z których obrazów składany jest wypadkowy */
+#define RESULTANT_PRIMES 3
+
+/**
+ * Zwraca stopień wielomianu względem zmiennej `x_var`.
+ * @param[in] p : wielomian
+ * @param[in] var : indeks zmiennej
+ * @return stopień (-1 dla zera)
+ */
+static poly_exp_t PolyDegVar(const Poly *p, unsigned var)
+{
+    if (PolyIsZero(p)) {
+        return -1;
+    } else if (PolyIsCoeff(p)) {
+        return 0;
+    }
+    poly_exp_t deg = 0;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        poly_exp_t sub = var == 0 ? tmp->exp : PolyDegVar(&tmp->p, var - 1);
+        deg = sub > deg ? sub : deg;
+    }
+    return deg;
+}
+
+/**
+ * Podstawia @p x pod zmienną `x_var` zredukowanego wielomianu modulo
+ * @p mod. Indeksy pozostałych zmiennych się nie zmieniają.
+ * @param[in] p : zredukowany wielomian
+ * @param[in] var : indeks zmiennej
+ * @param[in] x : punkt
+ * @param[in] mod : moduł
+ * @return wielomian niezależny od `x_var`
+ */
+static Poly PolyModEvalVar(const Poly *p, unsigned var, unsigned long x, unsigned long mod)
+{
+    if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        return PolyClone(p);
+    } else if (var == 0) {
+        Poly sum = PolyZero();
+        for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+            Poly term = PolyScaleCoeff(&tmp->p, (poly_coeff_t) ModPow(x, tmp->exp, mod));
+            Poly term_mod = PolyMod(&term, mod);
+            PolyAddInPlace(&sum, &term_mod, false, true);
+            PolyDestroy(&term);
+            PolyDestroy(&term_mod);
+        }
+        Poly res = PolyMod(&sum, mod);
+        PolyDestroy(&sum);
+        return PolyWrap(res, 1);
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly c = PolyModEvalVar(&tmp->p, var - 1, x, mod);
+        if (!PolyIsZero(&c)) {
+            wanderer->next = MonoNew(c, tmp->exp);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Wyznacza wypadkową wielomianów jednej zmiennej modulo liczba pierwsza
+ * algorytmem Euklidesa: dla `m = deg a >= n = deg b` i reszty `r` z
+ * dzielenia `a` przez `b` stopnia `k` zachodzi
+ * `res(a, b) = (-1)^(mn) lc(b)^(m - k) res(b, r)`.
+ * Tablice są niszczone.
+ * @param[in,out] a : tablica współczynników
+ * @param[in] na : długość @p a
+ * @param[in,out] b : tablica współczynników
+ * @param[in] nb : długość @p b
+ * @param[in] mod : liczba pierwsza
+ * @return wypadkowa (0, jeśli któryś z wielomianów jest zerem)
+ */
+static unsigned long UniResultant(unsigned long a[], unsigned na, unsigned long b[],
+                                  unsigned nb, unsigned long mod)
+{
+    unsigned long res = 1;
+    na = UniTrim(a, na);
+    nb = UniTrim(b, nb);
+    while (na > 0 && nb > 0) {
+        if (na == 1 || nb == 1) {
+            unsigned long c = na == 1 ? a[0] : b[0];
+            return ModMul(res, ModPow(c, (na == 1 ? nb : na) - 1, mod), mod);
+        } else if (na < nb) {
+            unsigned long *swap = a;
+            a = b;
+            b = swap;
+            unsigned swap_n = na;
+            na = nb;
+            nb = swap_n;
+            if ((na - 1) % 2 == 1 && (nb - 1) % 2 == 1) {
+                res = (mod - res) % mod;
+            }
+        }
+        unsigned m = na - 1, n = nb - 1;
+        unsigned long lead = b[nb - 1];
+        unsigned nr = UniDivRem(a, na, b, nb, NULL, mod);
+        if (nr == 0) {
+            return 0;
+        }
+        res = ModMul(res, ModPow(lead, m - (nr - 1), mod), mod);
+        if (m % 2 == 1 && n % 2 == 1) {
+            res = (mod - res) % mod;
+        }
+        unsigned long *swap = a;
+        a = b;
+        b = swap;
+        na = nb;
+        nb = nr;
+    }
+    return 0;
+}
+
+/**
+ * Zwraca wielomian jednej zmiennej `x_var`, w który zamienia się
+ * wielomian po podstawieniu stałych pod pozostałe zmienne.
+ * @param[in] p : wielomian zależny tylko od `x_var`
+ * @param[in] var : indeks zmiennej
+ * @param[out] n : długość tablicy
+ * @return zaalokowana tablica współczynników
+ */
+static unsigned long *UniFromVar(const Poly *p, unsigned var, unsigned *n)
+{
+    for (unsigned i = 0; i < var && !PolyIsZero(p) && !PolyIsCoeff(p); i++) {
+        p = &p->type.m->p;
+    }
+    return UniFromLeaf(p, n);
+}
+
+/**
+ * Wyznacza modulo liczba pierwsza wypadkową (albo wyróżnik, gdy @p q jest
+ * NULL) względem `x_var`: pod ostatnią z pozostałych zmiennych podstawiane
+ * są kolejne punkty, obrazy liczone są rekurencyjnie, a wynik odtwarzany
+ * jest interpolacją Newtona. Punkty, w których spada stopień względem
+ * `x_var`, są pomijane, bo wypadkowa wartości nie jest w nich wartością
+ * wypadkowej.
+ * @param[in] p : zredukowany wielomian
+ * @param[in] q : zredukowany wielomian albo NULL
+ * @param[in] var : indeks eliminowanej zmiennej
+ * @param[in] others : rosnące indeksy pozostałych zmiennych
+ * @param[in] count : liczba pozostałych zmiennych
+ * @param[in] bounds : ograniczenia stopni wyniku względem pozostałych zmiennych
+ * @param[in] mod : liczba pierwsza
+ * @return obraz wyniku
+ */
+static Poly PolyResultantMod(const Poly *p, const Poly *q, unsigned var, const unsigned others[],
+                             unsigned count, const poly_exp_t bounds[], unsigned long mod)
+{
+    if (count == 0) {
+        unsigned na, nb = 0;
+        unsigned long *a = UniFromVar(p, var, &na), *b;
+        unsigned long res, sign = 1, inverse = 1;
+        if (q != NULL) {
+            b = UniFromVar(q, var, &nb);
+        } else {
+            // Wyróżnik: (-1)^(n(n-1)/2) res(a, a') / lc(a).
+            b = (unsigned long*) calloc(na + 1, sizeof(unsigned long));
+            assert(b != NULL);
+            for (unsigned i = 1; i < na; i++) {
+                b[i - 1] = ModMul(a[i], i % mod, mod);
+            }
+            nb = na > 0 ? na - 1 : 0;
+            unsigned long n = na > 0 ? na - 1 : 0;
+            sign = n * (n - 1) / 2 % 2 == 1 ? mod - 1 : 1;
+            inverse = na > 0 ? ModInverse(a[na - 1], mod) : 0;
+        }
+        res = ModMul(ModMul(UniResultant(a, na, b, nb, mod), sign, mod), inverse, mod);
+        free(a);
+        free(b);
+        return res != 0 ? PolyFromCoeff((poly_coeff_t) res) : PolyZero();
+    }
+    unsigned j = others[count - 1];
+    poly_exp_t deg_p = PolyDegVar(p, var), deg_q = q != NULL ? PolyDegVar(q, var) : 0;
+    unsigned long *basis = (unsigned long*) calloc(1, sizeof(unsigned long));
+    assert(basis != NULL);
+    unsigned n_basis = 1;
+    basis[0] = 1;
+    Poly interp = PolyZero();
+    long points = 0;
+    for (unsigned long x = 0; x < mod && points <= bounds[count - 1]; x++) {
+        Poly eval_p = PolyModEvalVar(p, j, x, mod);
+        Poly eval_q = q != NULL ? PolyModEvalVar(q, j, x, mod) : PolyZero();
+        if (PolyDegVar(&eval_p, var) != deg_p
+            || (q != NULL && PolyDegVar(&eval_q, var) != deg_q)) {
+            PolyDestroy(&eval_p);
+            PolyDestroy(&eval_q);
+            continue;
+        }
+        Poly image = PolyResultantMod(&eval_p, q != NULL ? &eval_q : NULL, var,
+                                      others, count - 1, bounds, mod);
+        Poly value = PolyModEvalVar(&interp, j, x, mod);
+        Poly diff_raw = PolySub(&image, &value);
+        Poly diff = PolyMod(&diff_raw, mod);
+        unsigned long weight = ModInverse(UniEval(basis, n_basis, x, mod), mod);
+        for (unsigned i = 0; i < n_basis; i++) {
+            basis[i] = ModMul(basis[i], weight, mod);
+        }
+        Poly basis_poly = PolyWrap(PolyFromDense(basis, n_basis, 0), j);
+        Poly lift_raw = PolyMul(&diff, &basis_poly);
+        Poly lift = PolyMod(&lift_raw, mod);
+        PolyAddInPlace(&interp, &lift, false, true);
+        Poly next_interp = PolyMod(&interp, mod);
+        PolyDestroy(&interp);
+        interp = next_interp;
+        unsigned long linear[2] = {(mod - x) % mod, 1};
+        unsigned n_next;
+        unsigned long *next = UniMul(basis, n_basis, linear, 2, &n_next, mod);
+        free(basis);
+        basis = next;
+        n_basis = n_next;
+        points++;
+        PolyDestroy(&eval_p);
+        PolyDestroy(&eval_q);
+        PolyDestroy(&image);
+        PolyDestroy(&value);
+        PolyDestroy(&diff_raw);
+        PolyDestroy(&diff);
+        PolyDestroy(&basis_poly);
+        PolyDestroy(&lift_raw);
+        PolyDestroy(&lift);
+    }
+    free(basis);
+    return interp;
+}
+
+/**
+ * Wyznacza wypadkową (albo wyróżnik, gdy @p q jest NULL) z obrazów
+ * modulo RESULTANT_PRIMES liczb pierwszych, dla których nie spada stopień
+ * względem `x_var`, łącząc je chińskim twierdzeniem o resztach.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian albo NULL
+ * @param[in] var : indeks eliminowanej zmiennej
+ * @return wypadkowa albo wyróżnik
+ */
+static Poly PolyResultantCrt(const Poly *p, const Poly *q, unsigned var)
+{
+    unsigned depth_p = PolyDepth(p), depth_q = q != NULL ? PolyDepth(q) : 0;
+    unsigned depth = depth_p > depth_q ? depth_p : depth_q;
+    poly_exp_t *degs = (poly_exp_t*) calloc(2 * (unsigned long) depth + 1, sizeof(poly_exp_t));
+    unsigned *others = (unsigned*) malloc(sizeof(unsigned) * (depth + 1));
+    poly_exp_t *bounds = (poly_exp_t*) malloc(sizeof(poly_exp_t) * (depth + 1));
+    assert(degs != NULL && others != NULL && bounds != NULL);
+    poly_exp_t *degs_q = degs + depth;
+    PolyDegrees(p, degs);
+    if (q != NULL) {
+        PolyDegrees(q, degs_q);
+    }
+    poly_exp_t deg_p = PolyDegVar(p, var), deg_q = q != NULL ? PolyDegVar(q, var) : 0;
+    unsigned count = 0;
+    for (unsigned i = 0; i < depth; i++) {
+        if (i != var) {
+            others[count] = i;
+            // deg res <= deg_var(p) deg_i(q) + deg_var(q) deg_i(p),
+            // deg disc <= (2 deg_var(p) - 2) deg_i(p).
+            bounds[count++] = q != NULL ? deg_p * degs_q[i] + deg_q * degs[i]
+                                        : (2 * deg_p - 2) * degs[i];
+        }
+    }
+    Poly res = PolyZero();
+    unsigned long modulus = 1;
+    for (unsigned k = 0, used = 0; k < GCD_PRIMES && used < RESULTANT_PRIMES; k++) {
+        unsigned long mod = gcd_primes[k];
+        Poly mod_p = PolyMod(p, mod);
+        Poly mod_q = q != NULL ? PolyMod(q, mod) : PolyZero();
+        if (PolyDegVar(&mod_p, var) == deg_p
+            && (q == NULL || PolyDegVar(&mod_q, var) == deg_q)) {
+            Poly image = PolyResultantMod(&mod_p, q != NULL ? &mod_q : NULL, var,
+                                          others, count, bounds, mod);
+            Poly combined = PolyCrt(&res, modulus, &image, mod);
+            PolyDestroy(&res);
+            PolyDestroy(&image);
+            res = combined;
+            if (++used < RESULTANT_PRIMES) {
+                modulus *= mod;
+            }
+        }
+        PolyDestroy(&mod_p);
+        PolyDestroy(&mod_q);
+    }
+    free(degs);
+    free(others);
+    free(bounds);
+    return res;
+}
+
+/**
+ * Wyznacza wypadkową wielomianów względem zmiennej `x_var_idx` (wyznacznik
+ * macierzy Sylvestera), czyli wielomian pozostałych zmiennych, który
+ * zeruje się dokładnie tam, gdzie wielomiany mają wspólny pierwiastek.
+ * Zamiast rachunków na wielomianach wielu zmiennych (w których
+ * współczynniki pośrednie gwałtownie rosną) pod pozostałe zmienne
+ * podstawiane są punkty, wypadkowe wartości liczone są algorytmem
+ * Euklidesa modulo liczby pierwsze, a wynik odtwarzany jest interpolacją
+ * i chińskim twierdzeniem o resztach.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] var_idx : indeks eliminowanej zmiennej
+ * @return wypadkowa (dokładna modulo 2^64, o ile współczynniki dokładnego
+ * wyniku mają wartości bezwzględne mniejsze niż 2^92); zero, jeśli któryś
+ * z wielomianów jest zerem
+ */
+Poly PolyResultant(const Poly *p, const Poly *q, unsigned var_idx)
+{
+    if (PolyIsZero(p) || PolyIsZero(q)) {
+        return PolyZero();
+    }
+    return PolyResultantCrt(p, q, var_idx);
+}
+
+/**
+ * Wyznacza wyróżnik wielomianu względem zmiennej `x_var_idx`:
+ * `(-1)^(n(n-1)/2) res(p, p') / lc(p)`, gdzie `n` jest stopniem, a `p'`
+ * pochodną względem tej zmiennej. Liczony jest tak jak wypadkowa, a
+ * dzielenie przez wiodący współczynnik odbywa się w obrazach.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @return wyróżnik (dokładny modulo 2^64, o ile współczynniki dokładnego
+ * wyniku mają wartości bezwzględne mniejsze niż 2^92); zero dla wielomianów
+ * stopnia mniejszego niż 1
+ */
+Poly PolyDiscriminant(const Poly *p, unsigned var_idx)
+{
+    if (PolyDegVar(p, var_idx) < 1) {
+        return PolyZero();
+    }
+    return PolyResultantCrt(p, NULL, var_idx);
+}
+
+/**
+ * Różniczkuje wielomian względem zmiennej `x_var`.
+ * Każdy jednomian odwiedzany jest raz: współczynniki przy różniczkowanej
+ * zmiennej są od razu kopiowane z pomnożeniem przez wykładnik, a jednomiany,
+ * które się wyzerowały, są pomijane.
+ * @param[in] p : wielomian
+ * @param[in] var : indeks zmiennej
+ * @return pochodna
+ */
+static Poly PolyDerivativeRec(const Poly *p, unsigned var)
+{
+    if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        return PolyZero();
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly c;
+        poly_exp_t exp = tmp->exp;
+        if (var > 0) {
+            c = PolyDerivativeRec(&tmp->p, var - 1);
+        } else if (exp > 0) {
+            c = PolyScaleCoeff(&tmp->p, exp);
+            exp--;
+        } else {
+            break;
+        }
+        if (!PolyIsZero(&c)) {
+            wanderer->next = MonoNew(c, exp);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Całkuje wielomian względem zmiennej `x_var` (ze stałą całkowania zero).
+ * Współczynnik niezależny od tej zmiennej mnożony jest przez `x_var`, a
+ * współczynniki przy jej potędze `x_var^e` dzielone dokładnie przez `e + 1`.
+ * @param[in] p : wielomian
+ * @param[in] var : indeks zmiennej
+ * @param[out] res : całka (zero, jeśli nie ma współczynników całkowitych)
+ * @return czy całka ma współczynniki całkowite
+ */
+static bool PolyIntegralRec(const Poly *p, unsigned var, Poly *res)
+{
+    if (PolyIsZero(p)) {
+        *res = PolyZero();
+        return true;
+    } else if (PolyIsCoeff(p)) {
+        Poly inner;
+        if (var == 0) {
+            *res = PolyFromList(MonoNew(PolyFromCoeff(p->type.c), 1));
+        } else {
+            PolyIntegralRec(p, var - 1, &inner);
+            *res = PolyFromList(MonoNew(inner, 0));
+        }
+        return true;
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly c;
+        bool ok = var > 0 ? PolyIntegralRec(&tmp->p, var - 1, &c)
+                          : PolyDivExactCoeff(&tmp->p, tmp->exp + 1, &c);
+        if (!ok) {
+            Poly partial = PolyFromList(doll.next);
+            PolyDestroy(&partial);
+            *res = PolyZero();
+            return false;
+        }
+        wanderer->next = MonoNew(c, var > 0 ? tmp->exp : tmp->exp + 1);
+        wanderer = wanderer->next;
+    }
+    *res = PolyFromList(doll.next);
+    return true;
+}
+
+/**
+ * Wyznacza pochodne wielomianu względem zmiennych `x_0, ..., x_(count-1)`
+ * w jednym przejściu: pochodne współczynnika jednomianu liczone są jednym
+ * wywołaniem rekurencyjnym i dopisywane na koniec list jednomianów
+ * odpowiednich wyników.
+ * @param[in] p : wielomian
+ * @param[in] count : liczba zmiennych
+ * @param[out] grad : tablica @p count pochodnych
+ */
+static void PolyGradientRec(const Poly *p, unsigned count, Poly grad[])
+{
+    if (count == 0) {
+        return;
+    } else if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        for (unsigned i = 0; i < count; i++) {
+            grad[i] = PolyZero();
+        }
+        return;
+    }
+    Mono *dolls = (Mono*) malloc(count * sizeof(Mono));
+    assert(dolls != NULL);
+    Mono **tails = (Mono**) malloc(count * sizeof(Mono*));
+    assert(tails != NULL);
+    Poly *inner = NULL;
+    if (count > 1) {
+        inner = (Poly*) malloc((count - 1) * sizeof(Poly));
+        assert(inner != NULL);
+    }
+    for (unsigned i = 0; i < count; i++) {
+        dolls[i].next = NULL;
+        tails[i] = &dolls[i];
+    }
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        if (tmp->exp > 0) {
+            Poly c = PolyScaleCoeff(&tmp->p, tmp->exp);
+            if (!PolyIsZero(&c)) {
+                tails[0]->next = MonoNew(c, tmp->exp - 1);
+                tails[0] = tails[0]->next;
+            }
+        }
+        PolyGradientRec(&tmp->p, count - 1, inner);
+        for (unsigned i = 1; i < count; i++) {
+            if (!PolyIsZero(&inner[i - 1])) {
+                tails[i]->next = MonoNew(inner[i - 1], tmp->exp);
+                tails[i] = tails[i]->next;
+            }
+        }
+    }
+    for (unsigned i = 0; i < count; i++) {
+        grad[i] = PolyFromList(dolls[i].next);
+    }
+    free(dolls);
+    free(tails);
+    free(inner);
+}
+
+/**
+ * Wyznacza pochodną cząstkową wielomianu względem zmiennej `x_var_idx`.
+ * Wielomian przechodzony jest raz, bez kopii pośrednich.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @return pochodna
+ */
+Poly PolyDerivative(const Poly *p, unsigned var_idx)
+{
+    return PolyDerivativeRec(p, var_idx);
+}
+
+/**
+ * Wyznacza całkę nieoznaczoną wielomianu względem zmiennej `x_var_idx`
+ * (ze stałą całkowania zero, czyli bez wyrazów niezależnych od `x_var_idx`).
+ * Całka ma współczynniki całkowite tylko wtedy, gdy współczynniki przy
+ * `x_var_idx^e` dzielą się przez `e + 1`.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @param[out] res : całka (zero, jeśli nie ma współczynników całkowitych)
+ * @return czy całka ma współczynniki całkowite
+ */
+bool PolyIntegral(const Poly *p, unsigned var_idx, Poly *res)
+{
+    return PolyIntegralRec(p, var_idx, res);
+}
+
+/**
+ * Wyznacza gradient wielomianu, czyli pochodne cząstkowe względem zmiennych
+ * `x_0, ..., x_(count-1)`, w jednym przejściu wielomianu.
+ * @param[in] p : wielomian
+ * @param[in] count : liczba zmiennych
+ * @param[out] grad : tablica @p count pochodnych (`grad[i]` jest pochodną
+ * względem `x_i`)
+ */
+void PolyGradient(const Poly *p, unsigned count, Poly grad[])
+{
+    PolyGradientRec(p, count, grad);
+}
+
+/**
+ * Wylicza wartość wielomianu w punkcie i dodaje do tablic pochodnych jego
+ * pochodne (i drugie pochodne) względem zmiennych od `x_level` pomnożone
+ * przez @p scale. Wielomian względem `x_level` liczony jest schematem Hornera
+ * po różnicach wykładników (jak w PolyEvalBounded) na trójkach
+ * (wartość, pierwsza, druga pochodna), czyli w arytmetyce liczb dualnych
+ * drugiego rzędu. Współczynniki stałe dodawane są bez wywołania
+ * rekurencyjnego; pozostałe liczone są z mnożnikiem `scale * x_level^e`, więc
+ * pochodne po głębszych zmiennych trafiają od razu do wyniku.
+ * Zmienne o indeksach co najmniej @p count mają wartość zero.
+ * @param[in] p : wielomian
+ * @param[in] level : indeks zmiennej głównej @p p
+ * @param[in] count : liczba współrzędnych punktu
+ * @param[in] point : współrzędne punktu
+ * @param[in] scale : mnożnik pochodnych
+ * @param[in,out] grad : pochodne
+ * @param[in,out] hess_diag : drugie pochodne albo NULL
+ * @return wartość @p p w punkcie (modulo 2^64)
+ */
+static poly_coeff_t PolyEvalGradRec(const Poly *p, unsigned level, unsigned count,
+                                    const poly_coeff_t point[], unsigned long scale,
+                                    poly_coeff_t grad[], poly_coeff_t hess_diag[])
+{
+    if (PolyIsZero(p)) {
+        return 0;
+    } else if (PolyIsCoeff(p)) {
+        return p->type.c;
+    }
+    Mono *tmp = p->type.m;
+    if (level >= count) {
+        while (tmp->next != NULL) {
+            tmp = tmp->next;
+        }
+        return tmp->exp == 0 ? PolyEvalGradRec(&tmp->p, level + 1, count, point, scale,
+                                               grad, hess_diag) : 0;
+    }
+    unsigned long x = (unsigned long) point[level];
+    unsigned long value = 0, first = 0, second = 0;
+    for (; tmp != NULL; tmp = tmp->next) {
+        if (PolyIsCoeff(&tmp->p)) {
+            value += (unsigned long) tmp->p.type.c;
+        } else if (!PolyIsZero(&tmp->p)) {
+            unsigned long sub_scale = 0;
+            if (level + 1 < count) {
+                sub_scale = scale * (unsigned long) CoeffPow(point[level], (unsigned) tmp->exp);
+            }
+            value += (unsigned long) PolyEvalGradRec(&tmp->p, level + 1, count, point,
+                                                     sub_scale, grad, hess_diag);
+        }
+        unsigned long step = (unsigned long) (tmp->next != NULL ? tmp->exp - tmp->next->exp
+                                                                : tmp->exp);
+        if (step == 0) {
+            continue;
+        }
+        // Mnożenie przez g = x^step: (v, d, s) * (g, g', g'').
+        unsigned long pow2 = 0, pow1 = 1;
+        if (step >= 2) {
+            pow2 = (unsigned long) CoeffPow(point[level], (unsigned) (step - 2));
+            pow1 = pow2 * x;
+        }
+        unsigned long g = pow1 * x, g1 = step * pow1, g2 = step * (step - 1) * pow2;
+        second = second * g + 2 * first * g1 + value * g2;
+        first = first * g + value * g1;
+        value *= g;
+    }
+    grad[level] = (poly_coeff_t) ((unsigned long) grad[level] + scale * first);
+    if (hess_diag != NULL) {
+        hess_diag[level] = (poly_coeff_t) ((unsigned long) hess_diag[level] + scale * second);
+    }
+    return (poly_coeff_t) value;
+}
+
+/**
+ * Wylicza w jednym przejściu wielomianu jego wartość w punkcie, gradient
+ * i opcjonalnie przekątną hesjanu, bez budowania wielomianów pochodnych.
+ * Zmienne o indeksach co najmniej @p count mają wartość zero.
+ * Obliczenia odbywają się modulo 2^64 (tak jak przy przepełnieniu).
+ * @param[in] p : wielomian
+ * @param[in] count : liczba współrzędnych punktu
+ * @param[in] point : współrzędne punktu `x_0, ..., x_(count-1)`
+ * @param[out] grad : tablica @p count pochodnych cząstkowych w punkcie
+ * @param[out] hess_diag : tablica @p count drugich pochodnych cząstkowych
+ * `d^2 p / d x_i^2` w punkcie albo NULL, jeśli nie są potrzebne
+ * @return wartość @p p w punkcie
+ */
+poly_coeff_t PolyEvalGrad(const Poly *p, unsigned count, const poly_coeff_t point[],
+                          poly_coeff_t grad[], poly_coeff_t hess_diag[])
+{
+    for (unsigned i = 0; i < count; i++) {
+        grad[i] = 0;
+        if (hess_diag != NULL) {
+            hess_diag[i] = 0;
+        }
+    }
+    return PolyEvalGradRec(p, 0, count, point, 1, grad, hess_diag);
+}
+
+/** Operacje na szeregach potęgowych modulo liczba pierwsza */
+typedef enum SeriesOp {SERIES_INV, SERIES_LOG, SERIES_EXP, SERIES_SQRT} SeriesOp;
+
+/**
+ * Zapisuje w tablicy współczynniki wielomianu jednej zmiennej przy
+ * `x^0, ..., x^(n-1)`, modulo @p mod albo (dla @p mod równego zeru)
+ * modulo 2^64.
+ * @param[in] p : wielomian
+ * @param[in] n : liczba współczynników (dodatnia)
+ * @param[in] mod : moduł albo zero
+ * @param[out] count : długość tablicy (od 1 do @p n)
+ * @return zaalokowana tablica albo NULL, jeśli @p p zależy nie tylko od `x_0`
+ */
+static unsigned long *PolySeriesCoeffs(const Poly *p, unsigned n, unsigned long mod,
+                                       unsigned *count)
+{
+    unsigned long *a;
+    if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        a = (unsigned long*) malloc(sizeof(unsigned long));
+        assert(a != NULL);
+        a[0] = PolyIsZero(p) ? 0 : (mod != 0 ? CoeffMod(p->type.c, mod) : (unsigned long) p->type.c);
+        *count = 1;
+        return a;
+    }
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        if (!PolyIsCoeff(&tmp->p)) {
+            return NULL;
+        }
+    }
+    *count = (unsigned) p->type.m->exp < n ? (unsigned) p->type.m->exp + 1 : n;
+    a = (unsigned long*) calloc(*count, sizeof(unsigned long));
+    assert(a != NULL);
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        if ((unsigned) tmp->exp < *count) {
+            a[tmp->exp] = mod != 0 ? CoeffMod(tmp->p.type.c, mod) : (unsigned long) tmp->p.type.c;
+        }
+    }
+    return a;
+}
+
+/**
+ * Mnoży wielomiany modulo liczba pierwsza mniejsza niż 2^32, wyznaczając
+ * tylko @p n najniższych współczynników iloczynu. Krótkie wielomiany
+ * mnożone są szkolnie, a długie tak jak w ModPolyMul, po rozbiciu
+ * współczynników na połówki 16-bitowe, ale funkcją DenseMulTrunc.
+ * @param[in] a : współczynniki
+ * @param[in] na : długość @p a
+ * @param[in] b : współczynniki
+ * @param[in] nb : długość @p b
+ * @param[in] n : liczba wyznaczanych współczynników
+ * @param[out] res : wynik, @p n współczynników
+ * @param[in] mod : moduł
+ */
+static void ModSeriesMul(const unsigned long a[], unsigned na, const unsigned long b[],
+                         unsigned nb, unsigned n, unsigned long res[], unsigned long mod)
+{
+    na = na < n ? na : n;
+    nb = nb < n ? nb : n;
+    if (na < KARATSUBA_MIN || nb < KARATSUBA_MIN) {
+        for (unsigned i = 0; i < n; i++) {
+            res[i] = 0;
+        }
+        for (unsigned i = 0; i < na; i++) {
+            for (unsigned j = 0; j < nb && i + j < n; j++) {
+                res[i + j] = (res[i + j] + ModMul(a[i], b[j], mod)) % mod;
+            }
+        }
+        return;
+    }
+    unsigned long *split = (unsigned long*) malloc(
+            sizeof(unsigned long) * (2 * ((unsigned long) na + nb) + 3 * (unsigned long) n));
+    assert(split != NULL);
+    unsigned long *low_a = split, *high_a = low_a + na;
+    unsigned long *low_b = high_a + na, *high_b = low_b + nb;
+    unsigned long *low = high_b + nb, *high = low + n, *mid = high + n;
+    for (unsigned i = 0; i < na; i++) {
+        low_a[i] = a[i] & 0xffff;
+        high_a[i] = a[i] >> 16;
+    }
+    for (unsigned i = 0; i < nb; i++) {
+        low_b[i] = b[i] & 0xffff;
+        high_b[i] = b[i] >> 16;
+    }
+    DenseMulTrunc(low_a, na, low_b, nb, n, low);
+    DenseMulTrunc(high_a, na, high_b, nb, n, high);
+    for (unsigned i = 0; i < na; i++) {
+        low_a[i] += high_a[i];
+    }
+    for (unsigned i = 0; i < nb; i++) {
+        low_b[i] += high_b[i];
+    }
+    DenseMulTrunc(low_a, na, low_b, nb, n, mid);
+    unsigned long shift16 = (1UL << 16) % mod, shift32 = (1UL << 32) % mod;
+    for (unsigned i = 0; i < n; i++) {
+        unsigned long cross = (mid[i] - low[i] - high[i]) % mod;
+        res[i] = (low[i] % mod + ModMul(cross, shift16, mod)
+                  + ModMul(high[i] % mod, shift32, mod)) % mod;
+    }
+    free(split);
+}
+
+/**
+ * Odwraca szereg potęgowy modulo liczba pierwsza i `x^k` iteracją Newtona
+ * `g <- g (2 - f g)`, tak jak DenseInverse.
+ * @param[in] f : współczynniki szeregu (`f[0]` niezerowy)
+ * @param[in] nf : długość @p f
+ * @param[in] k : liczba wyznaczanych współczynników (dodatnia)
+ * @param[out] g : `f^(-1)`, @p k współczynników
+ * @param[in] mod : moduł
+ */
+static void ModSeriesInv(const unsigned long f[], unsigned nf, unsigned k, unsigned long g[],
+                         unsigned long mod)
+{
+    unsigned long *product = (unsigned long*) malloc(sizeof(unsigned long) * 2 * k);
+    assert(product != NULL);
+    unsigned long *correction = product + k;
+    g[0] = ModInverse(f[0], mod);
+    for (unsigned len = 1; len < k;) {
+        unsigned next = 2 * len < k ? 2 * len : k;
+        ModSeriesMul(f, nf, g, len, next, product, mod);
+        unsigned nh = next - len;
+        ModSeriesMul(g, len, product + len, nh, nh, correction, mod);
+        for (unsigned i = 0; i < nh; i++) {
+            g[len + i] = (mod - correction[i]) % mod;
+        }
+        len = next;
+    }
+    free(product);
+}
+
+/**
+ * Wyznacza logarytm szeregu potęgowego modulo liczba pierwsza i `x^k`
+ * jako całkę z `f' / f`: jedno odwrócenie i jedno mnożenie.
+ * Odwrotności liczb `1, ..., k - 1` liczone są rekurencją
+ * `1/i = -(mod / i) * 1/(mod % i)`.
+ * @param[in] f : współczynniki szeregu (`f[0] = 1`)
+ * @param[in] nf : długość @p f
+ * @param[in] k : liczba wyznaczanych współczynników (od 1 do @p mod)
+ * @param[out] g : `log f`, @p k współczynników
+ * @param[in] mod : moduł
+ */
+static void ModSeriesLog(const unsigned long f[], unsigned nf, unsigned k, unsigned long g[],
+                         unsigned long mod)
+{
+    g[0] = 0;
+    if (k == 1) {
+        return;
+    }
+    unsigned long *buffer = (unsigned long*) malloc(sizeof(unsigned long) * 3 * (unsigned long) k);
+    assert(buffer != NULL);
+    unsigned long *derivative = buffer, *inverse = buffer + k, *quot = buffer + 2 * k;
+    unsigned nd = nf - 1 < k - 1 ? nf - 1 : k - 1;
+    for (unsigned i = 0; i < nd; i++) {
+        derivative[i] = ModMul(f[i + 1], i + 1, mod);
+    }
+    ModSeriesInv(f, nf, k - 1, inverse, mod);
+    ModSeriesMul(derivative, nd, inverse, k - 1, k - 1, quot, mod);
+    // inverse[i] jest teraz odwrotnością i.
+    inverse[1] = 1;
+    for (unsigned i = 2; i < k; i++) {
+        inverse[i] = ModMul(mod - mod / i, inverse[mod % i], mod);
+    }
+    for (unsigned i = 1; i < k; i++) {
+        g[i] = ModMul(quot[i - 1], inverse[i], mod);
+    }
+    free(buffer);
+}
+
+/**
+ * Wyznacza eksponentę szeregu potęgowego modulo liczba pierwsza i `x^k`
+ * iteracją Newtona `g <- g (1 - log g + f)`, podwajającą liczbę poprawnych
+ * współczynników.
+ * @param[in] f : współczynniki szeregu (`f[0] = 0`)
+ * @param[in] nf : długość @p f
+ * @param[in] k : liczba wyznaczanych współczynników (od 1 do @p mod)
+ * @param[out] g : `exp f`, @p k współczynników
+ * @param[in] mod : moduł
+ */
+static void ModSeriesExp(const unsigned long f[], unsigned nf, unsigned k, unsigned long g[],
+                         unsigned long mod)
+{
+    unsigned long *step = (unsigned long*) malloc(sizeof(unsigned long) * 2 * (unsigned long) k);
+    assert(step != NULL);
+    unsigned long *log = step + k;
+    g[0] = 1;
+    for (unsigned len = 1; len < k;) {
+        unsigned next = 2 * len < k ? 2 * len : k;
+        ModSeriesLog(g, len, next, log, mod);
+        for (unsigned i = 0; i < next; i++) {
+            step[i] = ((i < nf ? f[i] : 0) + mod - log[i] + (i == 0)) % mod;
+        }
+        ModSeriesMul(g, len, step, next, next, log, mod);
+        for (unsigned i = 0; i < next; i++) {
+            g[i] = log[i];
+        }
+        len = next;
+    }
+    free(step);
+}
+
+/**
+ * Wyznacza pierwiastek kwadratowy modulo nieparzysta liczba pierwsza
+ * algorytmem Tonellego-Shanksa.
+ * @param[in] a : liczba
+ * @param[in] mod : moduł
+ * @param[out] root : mniejszy z dwóch pierwiastków
+ * @return czy @p a jest resztą kwadratową
+ */
+static bool ModSqrt(unsigned long a, unsigned long mod, unsigned long *root)
+{
+    if (a == 0) {
+        *root = 0;
+        return true;
+    } else if (ModPow(a, (mod - 1) / 2, mod) != 1) {
+        return false;
+    }
+    unsigned long q = mod - 1, z = 2;
+    unsigned s = 0;
+    while (q % 2 == 0) {
+        q /= 2;
+        s++;
+    }
+    while (ModPow(z, (mod - 1) / 2, mod) != mod - 1) {
+        z++;
+    }
+    unsigned long c = ModPow(z, q, mod), t = ModPow(a, q, mod), r = ModPow(a, (q + 1) / 2, mod);
+    while (t != 1) {
+        unsigned i = 0;
+        for (unsigned long square = t; square != 1; square = ModMul(square, square, mod)) {
+            i++;
+        }
+        unsigned long b = c;
+        for (unsigned j = i + 1; j < s; j++) {
+            b = ModMul(b, b, mod);
+        }
+        s = i;
+        c = ModMul(b, b, mod);
+        t = ModMul(t, c, mod);
+        r = ModMul(r, b, mod);
+    }
+    *root = r <= mod - r ? r : mod - r;
+    return true;
+}
+
+/**
+ * Wyznacza pierwiastek kwadratowy szeregu potęgowego modulo nieparzysta
+ * liczba pierwsza i `x^k` iteracją Newtona `g <- (g + f / g) / 2`.
+ * @param[in] f : współczynniki szeregu
+ * @param[in] nf : długość @p f
+ * @param[in] k : liczba wyznaczanych współczynników (dodatnia)
+ * @param[out] g : pierwiastek, @p k współczynników
+ * @param[in] root : pierwiastek z `f[0]` (niezerowy)
+ * @param[in] mod : moduł
+ */
+static void ModSeriesSqrt(const unsigned long f[], unsigned nf, unsigned k, unsigned long g[],
+                          unsigned long root, unsigned long mod)
+{
+    unsigned long *inverse = (unsigned long*) malloc(sizeof(unsigned long) * 2 * (unsigned long) k);
+    assert(inverse != NULL);
+    unsigned long *quot = inverse + k;
+    unsigned long half = (mod + 1) / 2;
+    g[0] = root;
+    for (unsigned len = 1; len < k;) {
+        unsigned next = 2 * len < k ? 2 * len : k;
+        ModSeriesInv(g, len, next, inverse, mod);
+        ModSeriesMul(f, nf, inverse, next, next, quot, mod);
+        for (unsigned i = 0; i < next; i++) {
+            g[i] = ModMul(((i < len ? g[i] : 0) + quot[i]) % mod, half, mod);
+        }
+        len = next;
+    }
+    free(inverse);
+}
+
+/**
+ * Wykonuje operację na szeregu potęgowym modulo liczba pierwsza po
+ * sprawdzeniu argumentów.
+ * @param[in] p : wielomian
+ * @param[in] n : liczba wyznaczanych współczynników
+ * @param[in] mod : moduł
+ * @param[in] op : operacja
+ * @param[out] res : wynik (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+static bool PolySeriesMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, SeriesOp op, Poly *res)
+{
+    *res = PolyZero();
+    unsigned nf;
+    unsigned long *f;
+    if (n < 1 || mod < 2 || (unsigned long) mod > 0xffffffffUL || !IsPrime((unsigned long) mod)
+        || ((op == SERIES_LOG || op == SERIES_EXP) && n > mod)
+        || (f = PolySeriesCoeffs(p, (unsigned) n, (unsigned long) mod, &nf)) == NULL) {
+        return false;
+    }
+    unsigned long root = 0;
+    bool ok;
+    switch (op) {
+        case SERIES_INV:
+            ok = f[0] != 0;
+            break;
+        case SERIES_LOG:
+            ok = f[0] == 1;
+            break;
+        case SERIES_EXP:
+            ok = f[0] == 0;
+            break;
+        default:
+            ok = f[0] != 0 && mod != 2 && ModSqrt(f[0], (unsigned long) mod, &root);
+            break;
+    }
+    if (ok) {
+        unsigned long *g = (unsigned long*) malloc(sizeof(unsigned long) * (unsigned) n);
+        assert(g != NULL);
+        switch (op) {
+            case SERIES_INV:
+                ModSeriesInv(f, nf, (unsigned) n, g, (unsigned long) mod);
+                break;
+            case SERIES_LOG:
+                ModSeriesLog(f, nf, (unsigned) n, g, (unsigned long) mod);
+                break;
+            case SERIES_EXP:
+                ModSeriesExp(f, nf, (unsigned) n, g, (unsigned long) mod);
+                break;
+            default:
+                ModSeriesSqrt(f, nf, (unsigned) n, g, root, (unsigned long) mod);
+                break;
+        }
+        *res = PolyFromDense(g, (unsigned) n, 0);
+        free(g);
+    }
+    free(f);
+    return ok;
+}
+
+/**
+ * Odwraca szereg potęgowy względem `x_0` modulo `x_0^n`: wyznacza `g`,
+ * dla którego `p g = 1 mod x_0^n`, iteracją Newtona podwajającą liczbę
+ * poprawnych współczynników (koszt rzędu kilku mnożeń).
+ * Współczynniki traktowane są jak liczby modulo 2^64 (tak jak przy
+ * przepełnieniu), dlatego wyraz wolny @p p musi być nieparzysty (dla 1
+ * i -1 wynik jest zwykłym odwrotnym szeregiem o współczynnikach całkowitych).
+ * @param[in] p : wielomian zależny tylko od `x_0`
+ * @param[in] n : liczba wyznaczanych współczynników (dodatnia)
+ * @param[out] res : odwrotność (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesInv(const Poly *p, poly_exp_t n, Poly *res)
+{
+    *res = PolyZero();
+    unsigned nf;
+    unsigned long *f;
+    if (n < 1 || (f = PolySeriesCoeffs(p, (unsigned) n, 0, &nf)) == NULL) {
+        return false;
+    } else if (f[0] % 2 == 0) {
+        free(f);
+        return false;
+    }
+    unsigned long *g = (unsigned long*) malloc(sizeof(unsigned long) * (unsigned) n);
+    assert(g != NULL);
+    DenseInverse(f, nf, (unsigned) n, g);
+    *res = PolyFromDense(g, (unsigned) n, 0);
+    free(f);
+    free(g);
+    return true;
+}
+
+/**
+ * Odwraca szereg potęgowy względem `x_0` modulo `x_0^n` i liczba pierwsza
+ * iteracją Newtona. Współczynniki wyniku należą do przedziału `[0, mod)`.
+ * @param[in] p : wielomian zależny tylko od `x_0`, o wyrazie wolnym
+ * niepodzielnym przez @p mod
+ * @param[in] n : liczba wyznaczanych współczynników (dodatnia)
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] res : odwrotność (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesInvMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res)
+{
+    return PolySeriesMod(p, n, mod, SERIES_INV, res);
+}
+
+/**
+ * Wyznacza logarytm szeregu potęgowego względem `x_0` modulo `x_0^n`
+ * i liczba pierwsza jako całkę z `p' / p`. Współczynniki wyniku należą do
+ * przedziału `[0, mod)`.
+ * @param[in] p : wielomian zależny tylko od `x_0`, o wyrazie wolnym
+ * przystającym do 1
+ * @param[in] n : liczba wyznaczanych współczynników (od 1 do @p mod)
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] res : logarytm (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesLogMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res)
+{
+    return PolySeriesMod(p, n, mod, SERIES_LOG, res);
+}
+
+/**
+ * Wyznacza eksponentę szeregu potęgowego względem `x_0` modulo `x_0^n`
+ * i liczba pierwsza iteracją Newtona. Współczynniki wyniku należą do
+ * przedziału `[0, mod)`.
+ * @param[in] p : wielomian zależny tylko od `x_0`, o wyrazie wolnym
+ * podzielnym przez @p mod
+ * @param[in] n : liczba wyznaczanych współczynników (od 1 do @p mod)
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] res : eksponenta (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesExpMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res)
+{
+    return PolySeriesMod(p, n, mod, SERIES_EXP, res);
+}
+
+/**
+ * Wyznacza pierwiastek kwadratowy szeregu potęgowego względem `x_0` modulo
+ * `x_0^n` i nieparzysta liczba pierwsza iteracją Newtona. Wyraz wolny
+ * wyniku jest mniejszym z dwóch pierwiastków wyrazu wolnego @p p, a
+ * współczynniki należą do przedziału `[0, mod)`.
+ * @param[in] p : wielomian zależny tylko od `x_0`, o wyrazie wolnym będącym
+ * niezerową resztą kwadratową modulo @p mod
+ * @param[in] n : liczba wyznaczanych współczynników (dodatnia)
+ * @param[in] mod : nieparzysta liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] res : pierwiastek (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesSqrtMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res)
+{
+    return PolySeriesMod(p, n, mod, SERIES_SQRT, res);
+}
+
+/** Długość tablicy, od której przesunięcie liczone jest metodą „dziel i zwyciężaj” */
+#define SHIFT_DENSE_MIN 128
+
+/**
+ * Przesuwa w miejscu wielomian zapisany w tablicy (`c(x) <- c(x + a)`)
+ * schematem Hornera: po `i` przebiegach `c[i..n-1]` są współczynnikami
+ * ilorazu z dzielenia przez `(x - a)^i`.
+ * @param[in,out] c : tablica współczynników
+ * @param[in] n : długość tablicy
+ * @param[in] a : przesunięcie
+ */
+static void DenseShiftHorner(unsigned long c[], unsigned n, unsigned long a)
+{
+    for (unsigned i = 0; i + 1 < n; i++) {
+        for (unsigned j = n - 1; j-- > i;) {
+            c[j] += a * c[j + 1];
+        }
+    }
+}
+
+/**
+ * Przesuwa wielomian względem `x_0`, którego współczynniki są wielomianami,
+ * tym samym schematem Hornera co DenseShiftHorner: współczynniki mnożone są
+ * przez @p a i dodawane w miejscu.
+ * @param[in] p : wielomian niebędący współczynnikiem
+ * @param[in] a : przesunięcie (niezerowe)
+ * @return `p(x_0 + a, x_1, ...)`
+ */
+static Poly PolyShiftHorner(const Poly *p, poly_coeff_t a)
+{
+    unsigned n = (unsigned) p->type.m->exp + 1;
+    Poly *c = (Poly*) malloc(sizeof(Poly) * n);
+    assert(c != NULL);
+    for (unsigned i = 0; i < n; i++) {
+        c[i] = PolyZero();
+    }
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        c[tmp->exp] = PolyClone(&tmp->p);
+    }
+    for (unsigned i = 0; i + 1 < n; i++) {
+        for (unsigned j = n - 1; j-- > i;) {
+            if (!PolyIsZero(&c[j + 1])) {
+                Poly scaled = PolyScaleCoeff(&c[j + 1], a);
+                PolyAddInPlace(&c[j], &scaled, false, true);
+                PolyDestroy(&scaled);
+            }
+        }
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (unsigned i = n; i-- > 0;) {
+        if (!PolyIsZero(&c[i])) {
+            wanderer->next = MonoNew(c[i], (poly_exp_t) i);
+            wanderer = wanderer->next;
+        }
+    }
+    free(c);
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Przesuwa w miejscu wielomian jednej zmiennej zapisany w tablicy
+ * (`c(x) <- c(x + a)`): krótki schematem Hornera, a długi jako złożenie
+ * z `x + a` funkcją DenseComposeArray, czyli kosztem rzędu `log n` mnożeń.
+ * @param[in,out] c : tablica współczynników
+ * @param[in] n : długość tablicy (dodatnia)
+ * @param[in] a : przesunięcie
+ */
+static void DenseShift(unsigned long c[], unsigned n, unsigned long a)
+{
+    if (n < SHIFT_DENSE_MIN) {
+        DenseShiftHorner(c, n, a);
+        return;
+    }
+    const unsigned long q[2] = {a, 1};
+    unsigned long *shifted = (unsigned long*) malloc(sizeof(unsigned long) * n);
+    assert(shifted != NULL);
+    DenseComposeArray(c, n, q, 1, shifted);
+    for (unsigned i = 0; i < n; i++) {
+        c[i] = shifted[i];
+    }
+    free(shifted);
+}
+
+/**
+ * Przesuwa względem `x_0` wielomian zadany tablicą współczynników przy
+ * kolejnych potęgach `x_0`, dzieląc go na plastry jednej zmiennej.
+ * Tablica stałych przesuwana jest funkcją DenseShift. W przeciwnym razie
+ * listy jednomianów współczynników łączone są kopcem (jak
+ * w PolyAddManyWeighted), a ich współczynniki przy tej samej potędze
+ * zmiennej głównej tworzą plaster przesuwany rekurencyjnie. Przesunięte
+ * plastry dołączane są do wyników malejąco po wykładnikach, więc każdy
+ * jednomian w pozostałych zmiennych przesuwany jest na tablicy.
+ * @param[in] c : współczynniki przy `x_0^0, ..., x_0^(n-1)` (NULL oznacza
+ * zero)
+ * @param[in] n : długość tablicy (dodatnia)
+ * @param[in] a : przesunięcie
+ * @param[out] res : współczynniki przesuniętego wielomianu
+ */
+static void PolyShiftSlices(const Poly *const c[], unsigned n, unsigned long a, Poly res[])
+{
+    bool flat = true;
+    for (unsigned i = 0; i < n && flat; i++) {
+        flat = c[i] == NULL || PolyIsZero(c[i]) || PolyIsCoeff(c[i]);
+    }
+    if (flat) {
+        unsigned long *v = (unsigned long*) malloc(sizeof(unsigned long) * n);
+        assert(v != NULL);
+        for (unsigned i = 0; i < n; i++) {
+            v[i] = c[i] != NULL && PolyIsCoeff(c[i]) ? (unsigned long) c[i]->type.c : 0;
+        }
+        DenseShift(v, n, a);
+        for (unsigned i = 0; i < n; i++) {
+            res[i] = v[i] != 0 ? PolyFromCoeff((poly_coeff_t) v[i]) : PolyZero();
+        }
+        free(v);
+        return;
+    }
+    Mono *consts = (Mono*) malloc(sizeof(Mono) * n);
+    MergeHead *heap = (MergeHead*) malloc(sizeof(MergeHead) * n);
+    const Poly **slice = (const Poly**) malloc(sizeof(Poly*) * n);
+    Poly *shifted = (Poly*) malloc(sizeof(Poly) * n);
+    PolyBuilder *builders = (PolyBuilder*) malloc(sizeof(PolyBuilder) * n);
+    assert(consts != NULL && heap != NULL && slice != NULL && shifted != NULL
+           && builders != NULL);
+    unsigned size = 0;
+    for (unsigned i = 0; i < n; i++) {
+        PolyBuilderInit(&builders[i]);
+        slice[i] = NULL;
+        const Mono *terms = c[i] != NULL ? PolyTerms(c[i], &consts[i]) : NULL;
+        if (terms != NULL) {
+            heap[size].m = terms;
+            heap[size].index = i;
+            size++;
+        }
+    }
+    for (unsigned i = size / 2; i-- > 0;) {
+        MergeHeapSiftDown(heap, size, i);
+    }
+    while (size > 0) {
+        poly_exp_t exp = heap[0].m->exp;
+        unsigned len = 0;
+        while (size > 0 && heap[0].m->exp == exp) {
+            slice[heap[0].index] = &heap[0].m->p;
+            if (heap[0].index >= len) {
+                len = heap[0].index + 1;
+            }
+            heap[0].m = heap[0].m->next;
+            if (heap[0].m == NULL) {
+                heap[0] = heap[--size];
+            }
+            if (size > 0) {
+                MergeHeapSiftDown(heap, size, 0);
+            }
+        }
+        PolyShiftSlices(slice, len, a, shifted);
+        for (unsigned i = 0; i < len; i++) {
+            PolyBuilderAppend(&builders[i], exp, &shifted[i]);
+            slice[i] = NULL;
+        }
+    }
+    for (unsigned i = 0; i < n; i++) {
+        res[i] = PolyBuilderFinish(&builders[i]);
+    }
+    free(consts);
+    free(heap);
+    free(slice);
+    free(shifted);
+    free(builders);
+}
+
+/**
+ * Przesuwa wielomian względem `x_0`. Wielomian jednej zmiennej o stałych
+ * współczynnikach przesuwany jest na tablicy funkcją DenseShift, a wielomian
+ * wielu zmiennych dzielony na plastry jednej zmiennej funkcją
+ * PolyShiftSlices; tylko krótkie wielomiany wielu zmiennych przesuwane są
+ * schematem Hornera na współczynnikach. Wynik jest gęsty niezależnie od
+ * rzadkości @p p, więc rzadkie wielomiany też trafiają na tablicę.
+ * @param[in] p : wielomian
+ * @param[in] a : przesunięcie (niezerowe)
+ * @return `p(x_0 + a, x_1, ...)`
+ */
+static Poly PolyShiftMain(const Poly *p, poly_coeff_t a)
+{
+    if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        return PolyClone(p);
+    }
+    unsigned n = (unsigned) p->type.m->exp + 1;
+    bool coeffs_only = true;
+    for (Mono *tmp = p->type.m; tmp != NULL && coeffs_only; tmp = tmp->next) {
+        coeffs_only = PolyIsCoeff(&tmp->p);
+    }
+    if (coeffs_only) {
+        unsigned long *c = PolyToDense(p, 0, n);
+        DenseShift(c, n, (unsigned long) a);
+        Poly res = PolyFromDense(c, n, 0);
+        free(c);
+        return res;
+    } else if (n < SHIFT_DENSE_MIN) {
+        return PolyShiftHorner(p, a);
+    }
+    const Poly **c = (const Poly**) malloc(sizeof(Poly*) * n);
+    Poly *shifted = (Poly*) malloc(sizeof(Poly) * n);
+    assert(c != NULL && shifted != NULL);
+    for (unsigned i = 0; i < n; i++) {
+        c[i] = NULL;
+    }
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        c[tmp->exp] = &tmp->p;
+    }
+    PolyShiftSlices(c, n, (unsigned long) a, shifted);
+    PolyBuilder b;
+    PolyBuilderInit(&b);
+    for (unsigned i = n; i-- > 0;) {
+        PolyBuilderAppend(&b, (poly_exp_t) i, &shifted[i]);
+    }
+    free(c);
+    free(shifted);
+    return PolyBuilderFinish(&b);
+}
+
+/**
+ * Przesuwa wielomian względem zmiennej `x_var`: współczynniki jednomianów
+ * przesuwane są rekurencyjnie aż do zmiennej `x_var`, a niezależne od niej
+ * kopiowane.
+ * @param[in] p : wielomian
+ * @param[in] var : indeks zmiennej
+ * @param[in] a : przesunięcie (niezerowe)
+ * @return `p` z `x_var + a` w miejscu `x_var`
+ */
+static Poly PolyShiftRec(const Poly *p, unsigned var, poly_coeff_t a)
+{
+    if (var == 0 || PolyIsZero(p) || PolyIsCoeff(p)) {
+        return PolyShiftMain(p, a);
+    }
+    Mono doll;
+    doll.next = NULL;
+    Mono *wanderer = &doll;
+    for (Mono *tmp = p->type.m; tmp != NULL; tmp = tmp->next) {
+        Poly c = PolyShiftRec(&tmp->p, var - 1, a);
+        if (!PolyIsZero(&c)) {
+            wanderer->next = MonoNew(c, tmp->exp);
+            wanderer = wanderer->next;
+        }
+    }
+    return PolyFromList(doll.next);
+}
+
+/**
+ * Przesuwa wielomian względem zmiennej `x_0` (przesunięcie Taylora):
+ * wyznacza `p(x_0 + a, x_1, ...)`. Wielomiany przesuwane są na tablicach
+ * (długie metodą „dziel i zwyciężaj”), a wielomiany wielu zmiennych po
+ * podziale na plastry jednej zmiennej; tylko krótkie wielomiany wielu
+ * zmiennych przesuwane są schematem Hornera na współczynnikach.
+ * @param[in] p : wielomian
+ * @param[in] a : przesunięcie
+ * @return `p(x_0 + a, x_1, ...)`
+ */
+Poly PolyShift(const Poly *p, poly_coeff_t a)
+{
+    return a != 0 ? PolyShiftMain(p, a) : PolyClone(p);
+}
+
+/**
+ * Przesuwa wielomian względem zmiennej `x_var_idx`: podstawia
+ * `x_var_idx + a` za `x_var_idx`. Współczynniki przy `x_var_idx` są
+ * przesuwane tak jak w PolyShift.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @param[in] a : przesunięcie
+ * @return `p` z `x_var_idx + a` w miejscu `x_var_idx`
+ */
+Poly PolyShiftVar(const Poly *p, unsigned var_idx, poly_coeff_t a)
+{
+    return a != 0 ? PolyShiftRec(p, var_idx, a) : PolyClone(p);
+}
+
+#ifdef POLY_TRACE
+
+/**
+ * Zapisuje @p bytes najmłodszych bajtów liczby @p value (little-endian).
+ */
+static void TracePutInt(FILE *out, unsigned long value, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        fputc((int)((value >> (8 * i)) & 0xff), out);
+    }
+}
+
+/**
+ * Liczy odcisk (FNV-1a) wielomianu i liczbę jego jednomianów.
+ * @param[in] p : wielomian
+ * @param[in,out] hash : bieżąca wartość skrótu
+ * @param[in,out] terms : licznik jednomianów
+ */
+static void TraceFingerprint(const Poly *p, unsigned long *hash, unsigned *terms)
+{
+    unsigned long value;
+    if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        value = PolyIsZero(p) ? 0 : (unsigned long)p->type.c;
+        for (int i = 0; i < 8; i++) {
+            *hash = (*hash ^ ((value >> (8 * i)) & 0xff)) * 1099511628211UL;
+        }
+    } else {
+        for (Mono *m = p->type.m; m != NULL; m = m->next) {
+            value = (unsigned long)(unsigned)m->exp ^ 0x9e3779b97f4a7c15UL;
+            for (int i = 0; i < 8; i++) {
+                *hash = (*hash ^ ((value >> (8 * i)) & 0xff)) * 1099511628211UL;
+            }
+            (*terms)++;
+            TraceFingerprint(&m->p, hash, terms);
+        }
+    }
+}
+
+/**
+ * Zapisuje wielomian jako argument śladu (format opisany w poly_trace.h).
+ * @param[in] out : plik śladu
+ * @param[in] p : wielomian
+ * @param[in] full : czy zapisać cały wielomian, czy tylko jego odcisk
+ */
+void PolyTraceWritePoly(FILE *out, const Poly *p, bool full)
+{
+    if (!full) {
+        unsigned long hash = 14695981039346656037UL;
+        unsigned terms = 0;
+        TraceFingerprint(p, &hash, &terms);
+        fputc(3, out);
+        TracePutInt(out, hash, 8);
+        TracePutInt(out, terms, 4);
+    } else if (PolyIsZero(p) || PolyIsCoeff(p)) {
+        fputc(0, out);
+        TracePutInt(out, PolyIsZero(p) ? 0 : (unsigned long)p->type.c, 8);
+    } else {
+        unsigned count = 0;
+        for (Mono *m = p->type.m; m != NULL; m = m->next) {
+            count++;
+        }
+        fputc(1, out);
+        TracePutInt(out, count, 4);
+        for (Mono *m = p->type.m; m != NULL; m = m->next) {
+            TracePutInt(out, (unsigned long)(unsigned)m->exp, 4);
+            PolyTraceWritePoly(out, &m->p, full);
+        }
+    }
+}
+
+#endif
@@ -11,13 +11,27 @@ typedef long poly_coeff_t;
 /** Typ wykładników wielomianu */
 typedef int poly_exp_t;
 
+/** Rodzaj wielomianu */
+enum UnionTest {
+    SIMPLE, ///< współczynnik
+    COMPLEX, ///< lista jednomianów
+    ZERO ///< wielomian tożsamościowo równy zeru
+};
+
+struct Mono;
+
 /**
  * Struktura przechowująca wielomian
- * TODO
+ * Wielomian jest współczynnikiem albo listą jednomianów uporządkowaną
+ * malejąco po wykładnikach.
  */
 typedef struct Poly
 {
-    /* TODO */
+    enum UnionTest tag; ///< rodzaj wielomianu
+    union {
+        struct Mono *m; ///< lista jednomianów (dla COMPLEX)
+        poly_coeff_t c; ///< współczynnik (dla SIMPLE)
+    } type; ///< zawartość wielomianu
 } Poly;
 
 /**
@@ -30,7 +44,7 @@ typedef struct Mono
 {
     Poly p; ///< współczynnik
     poly_exp_t exp; ///< wykładnik
-    /* TODO */
+    struct Mono *next; ///< następny jednomian listy
 } Mono;
 
 /**
@@ -40,7 +54,7 @@ typedef struct Mono
  */
 static inline Poly PolyFromCoeff(poly_coeff_t c)
 {
-    /* TODO */
+    return (Poly) {.tag = SIMPLE, .type.c = c};
 }
 
 /**
@@ -49,7 +63,7 @@ static inline Poly PolyFromCoeff(poly_coeff_t c)
  */
 static inline Poly PolyZero()
 {
-    /* TODO */
+    return (Poly) {.tag = ZERO, .type.m = NULL};
 }
 
 /**
@@ -71,7 +85,7 @@ static inline Mono MonoFromPoly(const Poly *p, poly_exp_t e)
  */
 static inline bool PolyIsCoeff(const Poly *p)
 {
-    /* TODO */
+    return p->tag == SIMPLE;
 }
 
 /**
@@ -81,7 +95,9 @@ static inline bool PolyIsCoeff(const Poly *p)
  */
 static inline bool PolyIsZero(const Poly *p)
 {
-    /* TODO */
+    return ((p->tag == COMPLEX) && (p->type.m == NULL))
+            || ((p->tag == SIMPLE) && (p->type.c == 0))
+            || (p->tag == ZERO);
 }
 
 /**
@@ -96,7 +112,7 @@ void PolyDestroy(Poly *p);
  */
 static inline void MonoDestroy(Mono *m)
 {
-    /* TODO */
+    PolyDestroy(&m->p);
 }
 
 /**
@@ -113,7 +129,7 @@ Poly PolyClone(const Poly *p);
  */
 static inline Mono MonoClone(const Mono *m)
 {
-    /* TODO */
+    return (Mono) {.p = PolyClone(&m->p), .exp = m->exp};
 }
 
 /**
@@ -124,9 +140,25 @@ static inline Mono MonoClone(const Mono *m)
  */
 Poly PolyAdd(const Poly *p, const Poly *q);
 
-static poly_exp_t MonoExpComparator(const void *x1, const void *x2);
+/**
+ * Dodaje współczynnik do wielomianu.
+ * Nie tworzy pomocniczego wielomianu ze współczynnika @p c.
+ * @param[in] p : wielomian
+ * @param[in] c : współczynnik
+ * @return `p + c`
+ */
+Poly PolyAddCoeff(const Poly *p, poly_coeff_t c);
 
-static void SkipZeros(const Mono monos[], unsigned *k, unsigned count);
+/**
+ * Sumuje wielomiany, opcjonalnie z wagami (kombinacja liniowa).
+ * Wszystkie wielomiany łączone są naraz, bez sum pośrednich, w czasie
+ * O(łączna liczba jednomianów * log @p count).
+ * @param[in] count : liczba wielomianów
+ * @param[in] polys : tablica wielomianów
+ * @param[in] weights : tablica wag albo NULL (wszystkie wagi równe 1)
+ * @return `weights[0] * polys[0] + ... + weights[count-1] * polys[count-1]`
+ */
+Poly PolyAddMany(unsigned count, const Poly polys[], const poly_coeff_t weights[]);
 
 /**
  * Sumuje listę jednomianów i tworzy z nich wielomian.
@@ -137,6 +169,112 @@ static void SkipZeros(const Mono monos[], unsigned *k, unsigned count);
  */
 Poly PolyAddMonos(unsigned count, const Mono monos[]);
 
+/**
+ * Budowniczy wielomianu z jednomianów podawanych malejąco po wykładnikach.
+ * Pozwala zbudować wielomian w czasie liniowym, bez tablicy jednomianów
+ * i bez sortowania.
+ */
+typedef struct PolyBuilder
+{
+    Mono *head; ///< pierwszy jednomian budowanej listy
+    Mono *tail; ///< ostatni dołączony jednomian
+    Mono *spare; ///< zarezerwowane, jeszcze nieużyte jednomiany
+} PolyBuilder;
+
+/**
+ * Inicjuje pustego budowniczego wielomianu.
+ * @param[out] b : budowniczy
+ */
+void PolyBuilderInit(PolyBuilder *b);
+
+/**
+ * Rezerwuje miejsce na @p capacity kolejnych jednomianów, żeby
+ * dołączanie ich nie alokowało pamięci.
+ * @param[in,out] b : budowniczy
+ * @param[in] capacity : liczba jednomianów
+ */
+void PolyBuilderReserve(PolyBuilder *b, unsigned capacity);
+
+/**
+ * Dołącza jednomian `p * x^exp` na koniec budowanego wielomianu.
+ * Wykładnik musi być mniejszy od wykładnika poprzednio dołączonego
+ * jednomianu (sprawdzane tylko asercją). Zerowy współczynnik jest pomijany.
+ * Przejmuje na własność zawartość @p p.
+ * @param[in,out] b : budowniczy
+ * @param[in] exp : wykładnik
+ * @param[in] p : współczynnik
+ */
+void PolyBuilderAppend(PolyBuilder *b, poly_exp_t exp, const Poly *p);
+
+/**
+ * Dołącza jednomian `c * x^exp` na koniec budowanego wielomianu.
+ * @param[in,out] b : budowniczy
+ * @param[in] exp : wykładnik
+ * @param[in] c : współczynnik
+ */
+void PolyBuilderAppendCoeff(PolyBuilder *b, poly_exp_t exp, poly_coeff_t c);
+
+/**
+ * Kończy budowanie i zwraca wielomian złożony z dołączonych jednomianów.
+ * Zwalnia niewykorzystane zarezerwowane jednomiany; budowniczy jest potem
+ * pusty i można go użyć ponownie.
+ * @param[in,out] b : budowniczy
+ * @return zbudowany wielomian
+ */
+Poly PolyBuilderFinish(PolyBuilder *b);
+
+/**
+ * Tworzy wielomian jednej zmiennej z tablicy współczynników:
+ * `coeffs[i * stride]` jest współczynnikiem przy `x^i`.
+ * @param[in] count : liczba współczynników
+ * @param[in] coeffs : tablica współczynników
+ * @param[in] stride : odstęp (w elementach) między kolejnymi współczynnikami
+ * @return wielomian
+ */
+Poly PolyFromCoeffArray(unsigned count, const poly_coeff_t coeffs[], ptrdiff_t stride);
+
+/**
+ * Zapisuje współczynniki wielomianu jednej zmiennej do tablicy:
+ * `coeffs[i * stride]` dostaje współczynnik przy `x^i`, a pozostałe
+ * elementy są zerowane.
+ * @param[in] p : wielomian
+ * @param[in] count : liczba współczynników
+ * @param[out] coeffs : tablica współczynników
+ * @param[in] stride : odstęp (w elementach) między kolejnymi współczynnikami
+ * @return czy wielomian jest wielomianem jednej zmiennej stopnia mniejszego
+ * niż @p count (jeśli nie, zawartość tablicy jest nieokreślona)
+ */
+bool PolyToCoeffArray(const Poly *p, unsigned count, poly_coeff_t coeffs[], ptrdiff_t stride);
+
+/**
+ * Tworzy wielomian z wielowymiarowej tablicy współczynników: element
+ * o indeksach `(i_0, ..., i_{dims-1})`, czyli
+ * `coeffs[i_0 * strides[0] + ... + i_{dims-1} * strides[dims-1]]`,
+ * jest współczynnikiem przy `x_0^i_0 * ... * x_{dims-1}^i_{dims-1}`
+ * (`x_0` to zmienna główna, a kolejne są zmiennymi współczynników).
+ * @param[in] dims : liczba wymiarów (zmiennych)
+ * @param[in] sizes : rozmiary kolejnych wymiarów
+ * @param[in] strides : odstępy (w elementach) w kolejnych wymiarach
+ * @param[in] coeffs : tablica współczynników
+ * @return wielomian
+ */
+Poly PolyFromCoeffTensor(unsigned dims, const unsigned sizes[],
+                         const ptrdiff_t strides[], const poly_coeff_t coeffs[]);
+
+/**
+ * Zapisuje współczynniki wielomianu do wielowymiarowej tablicy w układzie
+ * opisanym przy PolyFromCoeffTensor; pozostałe elementy są zerowane.
+ * @param[in] p : wielomian
+ * @param[in] dims : liczba wymiarów (zmiennych)
+ * @param[in] sizes : rozmiary kolejnych wymiarów
+ * @param[in] strides : odstępy (w elementach) w kolejnych wymiarach
+ * @param[out] coeffs : tablica współczynników
+ * @return czy wielomian zmieścił się w tablicy (jeśli nie, jej zawartość
+ * jest nieokreślona)
+ */
+bool PolyToCoeffTensor(const Poly *p, unsigned dims, const unsigned sizes[],
+                       const ptrdiff_t strides[], poly_coeff_t coeffs[]);
+
 /**
  * Mnoży dwa wielomiany.
  * @param[in] p : wielomian
@@ -145,6 +283,59 @@ Poly PolyAddMonos(unsigned count, const Mono monos[]);
  */
 Poly PolyMul(const Poly *p, const Poly *q);
 
+/**
+ * Mnoży dwa wielomiany jak szeregi potęgowe względem pierwszej zmiennej:
+ * wyznacza tylko jednomiany iloczynu o wykładnikach mniejszych niż @p n.
+ * Iloczyny jednomianów, które przekroczyłyby ograniczenie, nie są w ogóle
+ * liczone.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] n : ograniczenie wykładnika
+ * @return `p * q mod x_0^n`
+ */
+Poly PolyMulTrunc(const Poly *p, const Poly *q, poly_exp_t n);
+
+/**
+ * Mnoży dwa wielomiany, wyznaczając tylko jednomiany iloczynu o stopniu
+ * łącznym (sumie wykładników wszystkich zmiennych) mniejszym niż @p n.
+ * Iloczyny jednomianów, które przekroczyłyby ograniczenie, nie są w ogóle
+ * liczone.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] n : ograniczenie stopnia łącznego
+ * @return obcięty iloczyn `p * q`
+ */
+Poly PolyMulTruncTotal(const Poly *p, const Poly *q, poly_exp_t n);
+
+/**
+ * Mnoży wielomian przez współczynnik.
+ * Nie tworzy pomocniczego wielomianu ze współczynnika @p c.
+ * @param[in] p : wielomian
+ * @param[in] c : współczynnik
+ * @return `c * p`
+ */
+Poly PolyScale(const Poly *p, poly_coeff_t c);
+
+/**
+ * Podnosi wielomian do kwadratu.
+ * Wykorzystuje symetrię: każdy iloczyn mieszany liczony jest raz.
+ * @param[in] p : wielomian
+ * @return `p * p`
+ */
+Poly PolySquare(const Poly *p);
+
+/**
+ * Podnosi wielomian do potęgi.
+ * Strategia zależy od postaci wielomianu: jednomiany podnoszone są
+ * bezpośrednio, krótkie gęste wielomiany jednej zmiennej rekurencją Millera,
+ * wielomiany o kilku jednomianach rozwinięciem dwumianowym, a pozostałe
+ * przez podnoszenie do kwadratu.
+ * @param[in] p : wielomian
+ * @param[in] n : wykładnik potęgi
+ * @return `p^n` (`p^0 = 1`)
+ */
+Poly PolyPow(const Poly *p, unsigned n);
+
 /**
  * Zwraca przeciwny wielomian.
  * @param[in] p : wielomian
@@ -160,6 +351,69 @@ Poly PolyNeg(const Poly *p);
  */
 Poly PolySub(const Poly *p, const Poly *q);
 
+/**
+ * Dodaje dwa wielomiany, przejmując je na własność.
+ * Jednomiany argumentów są ponownie wykorzystywane w wyniku, więc np.
+ * `acc = PolyAddOwned(&acc, &term)` nie kopiuje niezmienionych wyrazów.
+ * Po wywołaniu @p p i @p q są zerami (można je bezpiecznie usunąć).
+ * @param[in,out] p : wielomian
+ * @param[in,out] q : wielomian
+ * @return `p + q`
+ */
+Poly PolyAddOwned(Poly *p, Poly *q);
+
+/**
+ * Mnoży dwa wielomiany, przejmując je na własność.
+ * Po wywołaniu @p p i @p q są zerami.
+ * @param[in,out] p : wielomian
+ * @param[in,out] q : wielomian
+ * @return `p * q`
+ */
+Poly PolyMulOwned(Poly *p, Poly *q);
+
+/**
+ * Zwraca przeciwny wielomian, przejmując argument na własność.
+ * Po wywołaniu @p p jest zerem.
+ * @param[in,out] p : wielomian
+ * @return `-p`
+ */
+Poly PolyNegOwned(Poly *p);
+
+/**
+ * Odejmuje wielomian od wielomianu, przejmując oba na własność.
+ * Po wywołaniu @p p i @p q są zerami.
+ * @param[in,out] p : wielomian
+ * @param[in,out] q : wielomian
+ * @return `p - q`
+ */
+Poly PolySubOwned(Poly *p, Poly *q);
+
+/**
+ * Dodaje w miejscu wielomian @p q do wielomianu @p p (`p += q`).
+ * Współczynniki są sumowane rekurencyjnie w miejscu, a alokowane są tylko
+ * jednomiany o wykładnikach, których nie było w @p p.
+ * @param[in,out] p : wielomian
+ * @param[in] q : wielomian
+ */
+void PolyAddTo(Poly *p, const Poly *q);
+
+/**
+ * Odejmuje w miejscu wielomian @p q od wielomianu @p p (`p -= q`).
+ * Współczynniki są odejmowane rekurencyjnie w miejscu, a alokowane są tylko
+ * jednomiany o wykładnikach, których nie było w @p p.
+ * @param[in,out] p : wielomian
+ * @param[in] q : wielomian
+ */
+void PolySubFrom(Poly *p, const Poly *q);
+
+/**
+ * Mnoży w miejscu wielomian przez współczynnik (`p *= c`).
+ * Jednomiany, które stały się zerem, są usuwane.
+ * @param[in,out] p : wielomian
+ * @param[in] c : współczynnik
+ */
+void PolyScaleBy(Poly *p, poly_coeff_t c);
+
 /**
  * Zwraca stopień wielomianu ze względu na zadaną zmienną (-1 dla wielomianu
  * tożsamościowo równego zeru).
@@ -201,4 +455,249 @@ bool PolyIsEq(const Poly *p, const Poly *q);
  */
 Poly PolyAt(const Poly *p, poly_coeff_t x);
 
+/**
+ * Składa wielomian @p p z wielomianami @p q.
+ * Pod zmienną @f$x_i@f$ podstawiany jest wielomian `q[i]` dla `i < k`,
+ * a pod pozostałe zmienne zero. Potęgi podstawianych wielomianów liczone
+ * są raz dla całego złożenia.
+ * @param[in] p : wielomian
+ * @param[in] k : liczba podstawianych wielomianów
+ * @param[in] q : tablica @p k wielomianów
+ * @return @f$p(q_0, \ldots, q_{k-1}, 0, 0, \ldots)@f$
+ */
+Poly PolyCompose(const Poly *p, unsigned k, const Poly q[]);
+
+/**
+ * Dzieli z resztą wielomian @p p przez wielomian @p q względem pierwszej
+ * zmiennej: `p = quot * q + rem`, a stopień @p rem względem pierwszej
+ * zmiennej jest mniejszy niż stopień @p q.
+ * Współczynniki traktowane są jak liczby modulo 2^64 (tak jak przy
+ * przepełnieniu), dlatego wiodący współczynnik @p q musi być nieparzystą
+ * liczbą (np. 1 albo -1, wtedy wynik jest zwykłym ilorazem całkowitym).
+ * Długie gęste wielomiany dzielone są metodą Newtona.
+ * @param[in] p : dzielna
+ * @param[in] q : dzielnik
+ * @param[out] quot : iloraz (zero, jeśli dzielenie nie jest możliwe)
+ * @param[out] rem : reszta (zero, jeśli dzielenie nie jest możliwe)
+ * @return czy dzielenie było możliwe
+ */
+bool PolyDivRem(const Poly *p, const Poly *q, Poly *quot, Poly *rem);
+
+/**
+ * Dzieli dokładnie wielomian @p p przez wielomian @p q, który go dzieli
+ * (w pierścieniu wielomianów o współczynnikach całkowitych).
+ * Dzielenie jest przerywane, gdy tylko okaże się, że @p q nie dzieli @p p,
+ * a w wielu takich przypadkach nie jest nawet zaczynane.
+ * @param[in] p : dzielna
+ * @param[in] q : dzielnik
+ * @param[out] quot : iloraz (zero, jeśli @p q nie dzieli @p p)
+ * @return czy @p q dzieli @p p
+ */
+bool PolyDivExact(const Poly *p, const Poly *q, Poly *quot);
+
+/**
+ * Sprawdza, czy wielomian @p q dzieli wielomian @p p (w pierścieniu
+ * wielomianów o współczynnikach całkowitych). Zero dzieli tylko zero.
+ * @param[in] q : dzielnik
+ * @param[in] p : dzielna
+ * @return czy `p = q * t` dla pewnego wielomianu `t`
+ */
+bool PolyDivides(const Poly *q, const Poly *p);
+
+/**
+ * Wyznacza największy wspólny dzielnik dwóch wielomianów (w pierścieniu
+ * wielomianów o współczynnikach całkowitych).
+ * Wynik ma dodatni wiodący współczynnik w porządku leksykograficznym
+ * (`x_0 > x_1 > ...`), a NWD dwóch zer jest zerem.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @return NWD wielomianów @p p i @p q
+ */
+Poly PolyGcd(const Poly *p, const Poly *q);
+
+/**
+ * Wyznacza NWD wielomianów jednej zmiennej `x_0` o współczynnikach modulo
+ * liczba pierwsza wraz ze współczynnikami Bézouta.
+ * Długie wielomiany przetwarzane są algorytmem „połowicznego NWD”
+ * o złożoności bliskiej mnożeniu, a nie kwadratowej.
+ * Współczynniki wyników należą do przedziału `[0, mod)`.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] gcd : NWD o wiodącym współczynniku 1 (zero dla dwóch zer)
+ * @param[out] s : wielomian, dla którego `s p + t q = gcd` modulo @p mod
+ * @param[out] t : wielomian, dla którego `s p + t q = gcd` modulo @p mod
+ * @return czy wielomiany zależą tylko od `x_0`, a moduł jest poprawny
+ * (w przeciwnym razie wyniki są zerami)
+ */
+bool PolyGcdExtMod(const Poly *p, const Poly *q, poly_coeff_t mod,
+                   Poly *gcd, Poly *s, Poly *t);
+
+/**
+ * Wyznacza wypadkową wielomianów względem zmiennej `x_var_idx` (wyznacznik
+ * macierzy Sylvestera), czyli wielomian pozostałych zmiennych, który
+ * zeruje się dokładnie tam, gdzie wielomiany mają wspólny pierwiastek.
+ * Wynik odtwarzany jest z wartości w punktach liczonych modulo liczby
+ * pierwsze, więc pośrednie współczynniki nie rosną.
+ * @param[in] p : wielomian
+ * @param[in] q : wielomian
+ * @param[in] var_idx : indeks eliminowanej zmiennej
+ * @return wypadkowa (dokładna modulo 2^64, o ile współczynniki dokładnego
+ * wyniku mają wartości bezwzględne mniejsze niż 2^92); zero, jeśli któryś
+ * z wielomianów jest zerem
+ */
+Poly PolyResultant(const Poly *p, const Poly *q, unsigned var_idx);
+
+/**
+ * Wyznacza wyróżnik wielomianu względem zmiennej `x_var_idx`:
+ * `(-1)^(n(n-1)/2) res(p, p') / lc(p)`, gdzie `n` jest stopniem, a `p'`
+ * pochodną względem tej zmiennej.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @return wyróżnik (dokładny modulo 2^64, o ile współczynniki dokładnego
+ * wyniku mają wartości bezwzględne mniejsze niż 2^92); zero dla wielomianów
+ * stopnia mniejszego niż 1
+ */
+Poly PolyDiscriminant(const Poly *p, unsigned var_idx);
+
+/**
+ * Wyznacza pochodną cząstkową wielomianu względem zmiennej `x_var_idx`.
+ * Wielomian przechodzony jest raz, bez kopii pośrednich.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @return pochodna
+ */
+Poly PolyDerivative(const Poly *p, unsigned var_idx);
+
+/**
+ * Wyznacza całkę nieoznaczoną wielomianu względem zmiennej `x_var_idx`
+ * (ze stałą całkowania zero, czyli bez wyrazów niezależnych od `x_var_idx`).
+ * Całka ma współczynniki całkowite tylko wtedy, gdy współczynniki przy
+ * `x_var_idx^e` dzielą się przez `e + 1`.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @param[out] res : całka (zero, jeśli nie ma współczynników całkowitych)
+ * @return czy całka ma współczynniki całkowite
+ */
+bool PolyIntegral(const Poly *p, unsigned var_idx, Poly *res);
+
+/**
+ * Wyznacza gradient wielomianu, czyli pochodne cząstkowe względem zmiennych
+ * `x_0, ..., x_(count-1)`, w jednym przejściu wielomianu.
+ * @param[in] p : wielomian
+ * @param[in] count : liczba zmiennych
+ * @param[out] grad : tablica @p count pochodnych (`grad[i]` jest pochodną
+ * względem `x_i`)
+ */
+void PolyGradient(const Poly *p, unsigned count, Poly grad[]);
+
+/**
+ * Wylicza w jednym przejściu wielomianu jego wartość w punkcie, gradient
+ * i opcjonalnie przekątną hesjanu, bez budowania wielomianów pochodnych.
+ * Zmienne o indeksach co najmniej @p count mają wartość zero.
+ * Obliczenia odbywają się modulo 2^64 (tak jak przy przepełnieniu).
+ * @param[in] p : wielomian
+ * @param[in] count : liczba współrzędnych punktu
+ * @param[in] point : współrzędne punktu `x_0, ..., x_(count-1)`
+ * @param[out] grad : tablica @p count pochodnych cząstkowych w punkcie
+ * @param[out] hess_diag : tablica @p count drugich pochodnych cząstkowych
+ * `d^2 p / d x_i^2` w punkcie albo NULL, jeśli nie są potrzebne
+ * @return wartość @p p w punkcie
+ */
+poly_coeff_t PolyEvalGrad(const Poly *p, unsigned count, const poly_coeff_t point[],
+                          poly_coeff_t grad[], poly_coeff_t hess_diag[]);
+
+/**
+ * Odwraca szereg potęgowy względem `x_0` modulo `x_0^n`: wyznacza `g`,
+ * dla którego `p g = 1 mod x_0^n`, iteracją Newtona podwajającą liczbę
+ * poprawnych współczynników (koszt rzędu kilku mnożeń).
+ * Współczynniki traktowane są jak liczby modulo 2^64 (tak jak przy
+ * przepełnieniu), dlatego wyraz wolny @p p musi być nieparzysty (dla 1
+ * i -1 wynik jest zwykłym odwrotnym szeregiem o współczynnikach całkowitych).
+ * @param[in] p : wielomian zależny tylko od `x_0`
+ * @param[in] n : liczba wyznaczanych współczynników (dodatnia)
+ * @param[out] res : odwrotność (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesInv(const Poly *p, poly_exp_t n, Poly *res);
+
+/**
+ * Odwraca szereg potęgowy względem `x_0` modulo `x_0^n` i liczba pierwsza
+ * iteracją Newtona. Współczynniki wyniku należą do przedziału `[0, mod)`.
+ * @param[in] p : wielomian zależny tylko od `x_0`, o wyrazie wolnym
+ * niepodzielnym przez @p mod
+ * @param[in] n : liczba wyznaczanych współczynników (dodatnia)
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] res : odwrotność (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesInvMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res);
+
+/**
+ * Wyznacza logarytm szeregu potęgowego względem `x_0` modulo `x_0^n`
+ * i liczba pierwsza jako całkę z `p' / p`. Współczynniki wyniku należą do
+ * przedziału `[0, mod)`.
+ * @param[in] p : wielomian zależny tylko od `x_0`, o wyrazie wolnym
+ * przystającym do 1
+ * @param[in] n : liczba wyznaczanych współczynników (od 1 do @p mod)
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] res : logarytm (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesLogMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res);
+
+/**
+ * Wyznacza eksponentę szeregu potęgowego względem `x_0` modulo `x_0^n`
+ * i liczba pierwsza iteracją Newtona. Współczynniki wyniku należą do
+ * przedziału `[0, mod)`.
+ * @param[in] p : wielomian zależny tylko od `x_0`, o wyrazie wolnym
+ * podzielnym przez @p mod
+ * @param[in] n : liczba wyznaczanych współczynników (od 1 do @p mod)
+ * @param[in] mod : liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] res : eksponenta (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesExpMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res);
+
+/**
+ * Wyznacza pierwiastek kwadratowy szeregu potęgowego względem `x_0` modulo
+ * `x_0^n` i nieparzysta liczba pierwsza iteracją Newtona. Wyraz wolny
+ * wyniku jest mniejszym z dwóch pierwiastków wyrazu wolnego @p p, a
+ * współczynniki należą do przedziału `[0, mod)`.
+ * @param[in] p : wielomian zależny tylko od `x_0`, o wyrazie wolnym będącym
+ * niezerową resztą kwadratową modulo @p mod
+ * @param[in] n : liczba wyznaczanych współczynników (dodatnia)
+ * @param[in] mod : nieparzysta liczba pierwsza mniejsza niż 2^32 (moduł złożony jest
+ * wykrywany i uznawany za niepoprawny)
+ * @param[out] res : pierwiastek (zero, jeśli argumenty są niepoprawne)
+ * @return czy argumenty są poprawne
+ */
+bool PolySeriesSqrtMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res);
+
+/**
+ * Przesuwa wielomian względem zmiennej `x_0` (przesunięcie Taylora):
+ * wyznacza `p(x_0 + a, x_1, ...)`. Wielomiany jednej zmiennej o stałych
+ * współczynnikach przesuwane są na tablicach (długie metodą „dziel
+ * i zwyciężaj”), a pozostałe schematem Hornera na współczynnikach.
+ * @param[in] p : wielomian
+ * @param[in] a : przesunięcie
+ * @return `p(x_0 + a, x_1, ...)`
+ */
+Poly PolyShift(const Poly *p, poly_coeff_t a);
+
+/**
+ * Przesuwa wielomian względem zmiennej `x_var_idx`: podstawia
+ * `x_var_idx + a` za `x_var_idx`. Współczynniki przy `x_var_idx` są
+ * przesuwane tak jak w PolyShift.
+ * @param[in] p : wielomian
+ * @param[in] var_idx : indeks zmiennej
+ * @param[in] a : przesunięcie
+ * @return `p` z `x_var_idx + a` w miejscu `x_var_idx`
+ */
+Poly PolyShiftVar(const Poly *p, unsigned var_idx, poly_coeff_t a);
+
 #endif //POLY_POLY_H
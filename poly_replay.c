@@ -0,0 +1,768 @@
+#include "poly.h"
+#include "poly_trace.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/** Największa liczba argumentów w rekordzie */
+#define MAX_ARGS 4
+
+/** Największa liczba argumentów liczbowych w rekordzie */
+#define MAX_SCALARS 2
+
+/** Największy kod operacji */
+#define MAX_OP POLY_TRACE_COMPOSE
+
+/** Nazwy operacji w raporcie */
+static const char *op_names[MAX_OP + 1] = {
+        [POLY_TRACE_CLONE] = "clone",
+        [POLY_TRACE_ADD] = "add",
+        [POLY_TRACE_ADD_MONOS] = "add-monos",
+        [POLY_TRACE_MUL] = "mul",
+        [POLY_TRACE_NEG] = "neg",
+        [POLY_TRACE_SUB] = "sub",
+        [POLY_TRACE_DEG_BY] = "deg-by",
+        [POLY_TRACE_DEG] = "deg",
+        [POLY_TRACE_IS_EQ] = "is-eq",
+        [POLY_TRACE_AT] = "at",
+        [POLY_TRACE_SCALE] = "scale",
+        [POLY_TRACE_ADD_COEFF] = "add-coeff",
+        [POLY_TRACE_ADD_OWNED] = "add-owned",
+        [POLY_TRACE_MUL_OWNED] = "mul-owned",
+        [POLY_TRACE_NEG_OWNED] = "neg-owned",
+        [POLY_TRACE_SUB_OWNED] = "sub-owned",
+        [POLY_TRACE_ADD_TO] = "add-to",
+        [POLY_TRACE_SUB_FROM] = "sub-from",
+        [POLY_TRACE_SCALE_BY] = "scale-by",
+        [POLY_TRACE_SQUARE] = "square",
+        [POLY_TRACE_POW] = "pow",
+        [POLY_TRACE_DIV_REM] = "div-rem",
+        [POLY_TRACE_DIV_EXACT] = "div-exact",
+        [POLY_TRACE_DIVIDES] = "divides",
+        [POLY_TRACE_GCD] = "gcd",
+        [POLY_TRACE_GCD_EXT_MOD] = "gcd-ext-mod",
+        [POLY_TRACE_RESULTANT] = "resultant",
+        [POLY_TRACE_DISCRIMINANT] = "discriminant",
+        [POLY_TRACE_DERIVATIVE] = "derivative",
+        [POLY_TRACE_INTEGRAL] = "integral",
+        [POLY_TRACE_GRADIENT] = "gradient",
+        [POLY_TRACE_EVAL_GRAD] = "eval-grad",
+        [POLY_TRACE_MUL_TRUNC] = "mul-trunc",
+        [POLY_TRACE_MUL_TRUNC_TOTAL] = "mul-trunc-total",
+        [POLY_TRACE_SERIES_INV] = "series-inv",
+        [POLY_TRACE_SERIES_INV_MOD] = "series-inv-mod",
+        [POLY_TRACE_SERIES_LOG_MOD] = "series-log-mod",
+        [POLY_TRACE_SERIES_EXP_MOD] = "series-exp-mod",
+        [POLY_TRACE_SERIES_SQRT_MOD] = "series-sqrt-mod",
+        [POLY_TRACE_SHIFT] = "shift",
+        [POLY_TRACE_SHIFT_VAR] = "shift-var",
+        [POLY_TRACE_FROM_COEFF_ARRAY] = "from-coeff-array",
+        [POLY_TRACE_TO_COEFF_ARRAY] = "to-coeff-array",
+        [POLY_TRACE_FROM_COEFF_TENSOR] = "from-coeff-tensor",
+        [POLY_TRACE_TO_COEFF_TENSOR] = "to-coeff-tensor",
+        [POLY_TRACE_ADD_MANY] = "add-many",
+        [POLY_TRACE_COMPOSE] = "compose",
+};
+
+/**
+ * Argument odczytany z rekordu śladu.
+ */
+typedef struct ReplayArg
+{
+    PolyTraceArg kind; ///< rodzaj argumentu
+    Poly p; ///< wielomian (dla POLY_TRACE_ARG_COEFF i POLY_TRACE_ARG_POLY)
+    Mono *monos; ///< jednomiany (dla POLY_TRACE_ARG_MONOS)
+    struct ReplayArg *items; ///< elementy (dla POLY_TRACE_ARG_LIST)
+    unsigned count; ///< liczba jednomianów albo elementów
+} ReplayArg;
+
+/**
+ * Podsumowanie wywołań jednej operacji.
+ */
+typedef struct ReplaySummary
+{
+    unsigned long calls; ///< liczba wywołań
+    double recorded_ns; ///< łączny czas z nagrania
+    double replay_ns; ///< łączny czas odtworzenia
+} ReplaySummary;
+
+/**
+ * Zwraca aktualny czas w nanosekundach.
+ */
+static unsigned long NowNs(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (unsigned long)ts.tv_sec * 1000000000UL + (unsigned long)ts.tv_nsec;
+}
+
+/**
+ * Odczytuje liczbę zapisaną na @p bytes bajtach (little-endian).
+ * @return czy odczyt się powiódł
+ */
+static bool ReadInt(FILE *in, int bytes, unsigned long *value)
+{
+    *value = 0;
+    for (int i = 0; i < bytes; i++)
+    {
+        int c = fgetc(in);
+        if (c == EOF)
+            return false;
+        *value |= (unsigned long)c << (8 * i);
+    }
+    return true;
+}
+
+static bool ReadArg(FILE *in, ReplayArg *arg);
+
+static void FreeArg(ReplayArg *arg);
+
+/**
+ * Zwalnia jednomiany argumentu.
+ */
+static void FreeMonos(ReplayArg *arg, unsigned count)
+{
+    for (unsigned i = 0; i < count; i++)
+        MonoDestroy(&arg->monos[i]);
+    free(arg->monos);
+    arg->monos = NULL;
+}
+
+/**
+ * Odczytuje listę jednomianów. Jeśli któryś współczynnik zapisano jako
+ * odcisk, cały argument staje się odciskiem.
+ * @return czy odczyt się powiódł
+ */
+static bool ReadMonos(FILE *in, ReplayArg *arg)
+{
+    unsigned long count, exp;
+    bool opaque = false;
+    if (!ReadInt(in, 4, &count))
+        return false;
+    arg->count = (unsigned)count;
+    arg->monos = calloc(count > 0 ? count : 1, sizeof(Mono));
+    assert(arg->monos != NULL);
+    for (unsigned i = 0; i < arg->count; i++)
+    {
+        ReplayArg coeff;
+        if (!ReadInt(in, 4, &exp) || !ReadArg(in, &coeff)
+            || coeff.kind == POLY_TRACE_ARG_MONOS)
+        {
+            FreeMonos(arg, i);
+            return false;
+        }
+        opaque |= coeff.kind == POLY_TRACE_ARG_FINGERPRINT;
+        arg->monos[i] = MonoFromPoly(&coeff.p, (poly_exp_t)exp);
+    }
+    if (opaque)
+    {
+        FreeMonos(arg, arg->count);
+        arg->kind = POLY_TRACE_ARG_FINGERPRINT;
+    }
+    return true;
+}
+
+/**
+ * Zwalnia elementy listy.
+ */
+static void FreeItems(ReplayArg *arg, unsigned count)
+{
+    for (unsigned i = 0; i < count; i++)
+        FreeArg(&arg->items[i]);
+    free(arg->items);
+    arg->items = NULL;
+}
+
+/**
+ * Odczytuje listę argumentów. Jeśli któryś element zapisano jako odcisk,
+ * cała lista staje się odciskiem.
+ * @return czy odczyt się powiódł
+ */
+static bool ReadList(FILE *in, ReplayArg *arg)
+{
+    unsigned long count;
+    bool opaque = false;
+    if (!ReadInt(in, 4, &count))
+        return false;
+    arg->count = (unsigned)count;
+    arg->items = calloc(count > 0 ? count : 1, sizeof(ReplayArg));
+    assert(arg->items != NULL);
+    for (unsigned i = 0; i < arg->count; i++)
+    {
+        if (!ReadArg(in, &arg->items[i]))
+        {
+            FreeItems(arg, i);
+            return false;
+        }
+        opaque |= arg->items[i].kind == POLY_TRACE_ARG_FINGERPRINT;
+    }
+    if (opaque)
+    {
+        FreeItems(arg, arg->count);
+        arg->kind = POLY_TRACE_ARG_FINGERPRINT;
+    }
+    return true;
+}
+
+/**
+ * Odczytuje argument rekordu.
+ * @return czy odczyt się powiódł
+ */
+static bool ReadArg(FILE *in, ReplayArg *arg)
+{
+    unsigned long value;
+    int kind = fgetc(in);
+    arg->kind = (PolyTraceArg)kind;
+    arg->monos = NULL;
+    arg->items = NULL;
+    arg->count = 0;
+    arg->p = PolyZero();
+    switch (kind)
+    {
+        case POLY_TRACE_ARG_COEFF:
+            if (!ReadInt(in, 8, &value))
+                return false;
+            if (value != 0)
+                arg->p = PolyFromCoeff((poly_coeff_t)value);
+            return true;
+        case POLY_TRACE_ARG_POLY:
+            if (!ReadMonos(in, arg))
+                return false;
+            if (arg->kind == POLY_TRACE_ARG_FINGERPRINT)
+                return true;
+            arg->p = PolyAddMonos(arg->count, arg->monos);
+            free(arg->monos);
+            arg->monos = NULL;
+            return true;
+        case POLY_TRACE_ARG_MONOS:
+            return ReadMonos(in, arg);
+        case POLY_TRACE_ARG_FINGERPRINT:
+            return ReadInt(in, 8, &value) && ReadInt(in, 4, &value);
+        case POLY_TRACE_ARG_LIST:
+            return ReadList(in, arg);
+        default:
+            return false;
+    }
+}
+
+/**
+ * Zwalnia argument.
+ */
+static void FreeArg(ReplayArg *arg)
+{
+    if (arg->monos != NULL)
+        FreeMonos(arg, arg->count);
+    if (arg->items != NULL)
+        FreeItems(arg, arg->count);
+    PolyDestroy(&arg->p);
+}
+
+/**
+ * Sprawdza, czy argument jest wielomianem.
+ */
+static bool IsPolyArg(const ReplayArg *arg)
+{
+    return arg->kind == POLY_TRACE_ARG_POLY || arg->kind == POLY_TRACE_ARG_COEFF;
+}
+
+/**
+ * Sprawdza, czy argument jest listą współczynników.
+ */
+static bool IsCoeffList(const ReplayArg *arg)
+{
+    if (arg->kind != POLY_TRACE_ARG_LIST)
+        return false;
+    for (unsigned i = 0; i < arg->count; i++)
+    {
+        if (arg->items[i].kind != POLY_TRACE_ARG_COEFF)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Sprawdza, czy argument jest listą wielomianów.
+ */
+static bool IsPolyList(const ReplayArg *arg)
+{
+    if (arg->kind != POLY_TRACE_ARG_LIST)
+        return false;
+    for (unsigned i = 0; i < arg->count; i++)
+    {
+        if (!IsPolyArg(&arg->items[i]))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Zwraca liczbę elementów tablicy o rozmiarach wymiarów z listy @p sizes.
+ */
+static unsigned long TensorCount(const ReplayArg *sizes)
+{
+    unsigned long total = 1;
+    for (unsigned k = 0; k < sizes->count; k++)
+    {
+        const Poly *size = &sizes->items[k].p;
+        total *= PolyIsZero(size) ? 0 : (unsigned long)size->type.c;
+    }
+    return total;
+}
+
+/**
+ * Przepisuje listę współczynników do nowej tablicy.
+ * @param list : lista współczynników
+ * @param count : rozmiar tablicy (co najmniej liczba elementów listy)
+ * @return tablica do zwolnienia przez wywołującego
+ */
+static poly_coeff_t *CoeffsFromList(const ReplayArg *list, unsigned long count)
+{
+    poly_coeff_t *coeffs = calloc(count > 0 ? count : 1, sizeof(poly_coeff_t));
+    assert(coeffs != NULL);
+    for (unsigned i = 0; list != NULL && i < list->count; i++)
+    {
+        const Poly *c = &list->items[i].p;
+        coeffs[i] = PolyIsZero(c) ? 0 : c->type.c;
+    }
+    return coeffs;
+}
+
+/**
+ * Przepisuje listę wielomianów do nowej tablicy. Wielomiany nie są
+ * kopiowane, więc nadal należą do listy.
+ * @param list : lista wielomianów
+ * @return tablica do zwolnienia przez wywołującego
+ */
+static Poly *PolysFromList(const ReplayArg *list)
+{
+    Poly *polys = malloc((list->count > 0 ? list->count : 1) * sizeof(Poly));
+    assert(polys != NULL);
+    for (unsigned i = 0; i < list->count; i++)
+        polys[i] = list->items[i].p;
+    return polys;
+}
+
+/**
+ * Sprawdza, czy rekord ma argumenty odpowiednie dla operacji.
+ */
+static bool ArgsMatch(int op, const ReplayArg args[], int count, int scalars)
+{
+    int polys = 1, needed_scalars = 0;
+    PolyTraceArg kind = POLY_TRACE_ARG_POLY;
+    switch (op)
+    {
+        case POLY_TRACE_ADD:
+        case POLY_TRACE_MUL:
+        case POLY_TRACE_SUB:
+        case POLY_TRACE_IS_EQ:
+        case POLY_TRACE_ADD_OWNED:
+        case POLY_TRACE_MUL_OWNED:
+        case POLY_TRACE_SUB_OWNED:
+        case POLY_TRACE_ADD_TO:
+        case POLY_TRACE_SUB_FROM:
+        case POLY_TRACE_DIV_REM:
+        case POLY_TRACE_DIV_EXACT:
+        case POLY_TRACE_DIVIDES:
+        case POLY_TRACE_GCD:
+            polys = 2;
+            break;
+        case POLY_TRACE_ADD_MONOS:
+            kind = POLY_TRACE_ARG_MONOS;
+            break;
+        case POLY_TRACE_DEG_BY:
+        case POLY_TRACE_AT:
+        case POLY_TRACE_SCALE:
+        case POLY_TRACE_ADD_COEFF:
+        case POLY_TRACE_SCALE_BY:
+        case POLY_TRACE_POW:
+        case POLY_TRACE_DISCRIMINANT:
+        case POLY_TRACE_DERIVATIVE:
+        case POLY_TRACE_INTEGRAL:
+        case POLY_TRACE_GRADIENT:
+        case POLY_TRACE_EVAL_GRAD:
+        case POLY_TRACE_SERIES_INV:
+        case POLY_TRACE_SHIFT:
+        case POLY_TRACE_TO_COEFF_ARRAY:
+            needed_scalars = 1;
+            break;
+        case POLY_TRACE_SERIES_INV_MOD:
+        case POLY_TRACE_SERIES_LOG_MOD:
+        case POLY_TRACE_SERIES_EXP_MOD:
+        case POLY_TRACE_SERIES_SQRT_MOD:
+        case POLY_TRACE_SHIFT_VAR:
+            needed_scalars = 2;
+            break;
+        case POLY_TRACE_GCD_EXT_MOD:
+        case POLY_TRACE_RESULTANT:
+        case POLY_TRACE_MUL_TRUNC:
+        case POLY_TRACE_MUL_TRUNC_TOTAL:
+            polys = 2;
+            needed_scalars = 1;
+            break;
+        case POLY_TRACE_FROM_COEFF_ARRAY:
+            return count == 1 && scalars == 0 && IsCoeffList(&args[0]);
+        case POLY_TRACE_FROM_COEFF_TENSOR:
+            return count == 2 && scalars == 0 && IsCoeffList(&args[0])
+                   && IsCoeffList(&args[1]) && args[1].count == TensorCount(&args[0]);
+        case POLY_TRACE_TO_COEFF_TENSOR:
+            return count == 2 && scalars == 0 && IsPolyArg(&args[0])
+                   && IsCoeffList(&args[1]);
+        case POLY_TRACE_ADD_MANY:
+            return (count == 1 || count == 2) && scalars == 0 && IsPolyList(&args[0])
+                   && (count == 1 || (IsCoeffList(&args[1])
+                                      && args[1].count == args[0].count));
+        case POLY_TRACE_COMPOSE:
+            return count == 2 && scalars == 0 && IsPolyArg(&args[0])
+                   && IsPolyList(&args[1]);
+        default:
+            break;
+    }
+    if (count != polys || scalars != needed_scalars)
+        return false;
+    for (int i = 0; i < count; i++)
+    {
+        if (kind == POLY_TRACE_ARG_MONOS ? args[i].kind != kind : !IsPolyArg(&args[i]))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Wykonuje operację z rekordu i mierzy jej czas.
+ * Zwalnia wynik, ale nie wlicza tego do czasu.
+ * @param op : kod operacji
+ * @param args : argumenty
+ * @param count : liczba argumentów
+ * @param scalar : pierwszy argument liczbowy
+ * @param second : drugi argument liczbowy (moduł operacji na szeregach,
+ * przesunięcie w PolyShiftVar)
+ * @return czas wykonania w nanosekundach
+ */
+static unsigned long Replay(int op, ReplayArg args[], int count, long scalar, long second)
+{
+    Poly res = PolyZero();
+    Poly rem = PolyZero();
+    Poly cofactor = PolyZero();
+    Poly *grad = NULL;
+    unsigned grad_count = 0;
+    if (op == POLY_TRACE_GRADIENT)
+    {
+        grad_count = (unsigned)scalar;
+        grad = malloc(grad_count * sizeof(Poly));
+        assert(grad_count == 0 || grad != NULL);
+    }
+    poly_coeff_t *values = NULL;
+    if (op == POLY_TRACE_EVAL_GRAD)
+    {
+        // Ślad nie zawiera współrzędnych punktu; liczymy w punkcie (1, ..., 1)
+        // razem z przekątną hesjanu.
+        unsigned long count = (unsigned long)scalar;
+        values = malloc(3 * (count > 0 ? count : 1) * sizeof(poly_coeff_t));
+        assert(values != NULL);
+        for (unsigned long i = 0; i < count; i++)
+            values[i] = 1;
+    }
+    // Tablice współczynników odtwarzane są jako ciągłe.
+    poly_coeff_t *coeffs = NULL;
+    unsigned *sizes = NULL;
+    ptrdiff_t *strides = NULL;
+    if (op == POLY_TRACE_FROM_COEFF_ARRAY)
+        coeffs = CoeffsFromList(&args[0], args[0].count);
+    else if (op == POLY_TRACE_TO_COEFF_ARRAY)
+        coeffs = CoeffsFromList(NULL, (unsigned long)scalar);
+    else if (op == POLY_TRACE_FROM_COEFF_TENSOR || op == POLY_TRACE_TO_COEFF_TENSOR)
+    {
+        bool from = op == POLY_TRACE_FROM_COEFF_TENSOR;
+        const ReplayArg *list = &args[from ? 0 : 1];
+        unsigned long total = TensorCount(list);
+        sizes = malloc((list->count > 0 ? list->count : 1) * sizeof(unsigned));
+        strides = malloc((list->count > 0 ? list->count : 1) * sizeof(ptrdiff_t));
+        assert(sizes != NULL && strides != NULL);
+        ptrdiff_t stride = 1;
+        for (unsigned k = list->count; k-- > 0;)
+        {
+            const Poly *size = &list->items[k].p;
+            sizes[k] = PolyIsZero(size) ? 0 : (unsigned)size->type.c;
+            strides[k] = stride;
+            stride *= (ptrdiff_t)sizes[k];
+        }
+        coeffs = CoeffsFromList(from ? &args[1] : NULL, total);
+    }
+    Poly *polys = NULL;
+    if (op == POLY_TRACE_ADD_MANY)
+    {
+        polys = PolysFromList(&args[0]);
+        if (count == 2)
+            coeffs = CoeffsFromList(&args[1], args[1].count);
+    }
+    else if (op == POLY_TRACE_COMPOSE)
+        polys = PolysFromList(&args[1]);
+    unsigned long start = NowNs();
+    switch (op)
+    {
+        case POLY_TRACE_CLONE:
+            res = PolyClone(&args[0].p);
+            break;
+        case POLY_TRACE_ADD:
+            res = PolyAdd(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_ADD_MONOS:
+            res = PolyAddMonos(args[0].count, args[0].monos);
+            break;
+        case POLY_TRACE_MUL:
+            res = PolyMul(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_NEG:
+            res = PolyNeg(&args[0].p);
+            break;
+        case POLY_TRACE_SUB:
+            res = PolySub(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_DEG_BY:
+            PolyDegBy(&args[0].p, (unsigned)scalar);
+            break;
+        case POLY_TRACE_DEG:
+            PolyDeg(&args[0].p);
+            break;
+        case POLY_TRACE_IS_EQ:
+            PolyIsEq(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_AT:
+            res = PolyAt(&args[0].p, scalar);
+            break;
+        case POLY_TRACE_SCALE:
+            res = PolyScale(&args[0].p, scalar);
+            break;
+        case POLY_TRACE_ADD_COEFF:
+            res = PolyAddCoeff(&args[0].p, scalar);
+            break;
+        case POLY_TRACE_ADD_OWNED:
+            res = PolyAddOwned(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_MUL_OWNED:
+            res = PolyMulOwned(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_NEG_OWNED:
+            res = PolyNegOwned(&args[0].p);
+            break;
+        case POLY_TRACE_SUB_OWNED:
+            res = PolySubOwned(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_ADD_TO:
+            PolyAddTo(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_SUB_FROM:
+            PolySubFrom(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_SCALE_BY:
+            PolyScaleBy(&args[0].p, scalar);
+            break;
+        case POLY_TRACE_SQUARE:
+            res = PolySquare(&args[0].p);
+            break;
+        case POLY_TRACE_POW:
+            res = PolyPow(&args[0].p, (unsigned)scalar);
+            break;
+        case POLY_TRACE_DIV_REM:
+            PolyDivRem(&args[0].p, &args[1].p, &res, &rem);
+            break;
+        case POLY_TRACE_DIV_EXACT:
+            PolyDivExact(&args[0].p, &args[1].p, &res);
+            break;
+        case POLY_TRACE_DIVIDES:
+            PolyDivides(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_GCD:
+            res = PolyGcd(&args[0].p, &args[1].p);
+            break;
+        case POLY_TRACE_GCD_EXT_MOD:
+            PolyGcdExtMod(&args[0].p, &args[1].p, scalar, &res, &rem, &cofactor);
+            break;
+        case POLY_TRACE_RESULTANT:
+            res = PolyResultant(&args[0].p, &args[1].p, (unsigned)scalar);
+            break;
+        case POLY_TRACE_DISCRIMINANT:
+            res = PolyDiscriminant(&args[0].p, (unsigned)scalar);
+            break;
+        case POLY_TRACE_DERIVATIVE:
+            res = PolyDerivative(&args[0].p, (unsigned)scalar);
+            break;
+        case POLY_TRACE_INTEGRAL:
+            PolyIntegral(&args[0].p, (unsigned)scalar, &res);
+            break;
+        case POLY_TRACE_GRADIENT:
+            PolyGradient(&args[0].p, grad_count, grad);
+            break;
+        case POLY_TRACE_MUL_TRUNC:
+            res = PolyMulTrunc(&args[0].p, &args[1].p, (poly_exp_t)scalar);
+            break;
+        case POLY_TRACE_MUL_TRUNC_TOTAL:
+            res = PolyMulTruncTotal(&args[0].p, &args[1].p, (poly_exp_t)scalar);
+            break;
+        case POLY_TRACE_SERIES_INV:
+            PolySeriesInv(&args[0].p, (poly_exp_t)scalar, &res);
+            break;
+        case POLY_TRACE_SERIES_INV_MOD:
+            PolySeriesInvMod(&args[0].p, (poly_exp_t)scalar, second, &res);
+            break;
+        case POLY_TRACE_SERIES_LOG_MOD:
+            PolySeriesLogMod(&args[0].p, (poly_exp_t)scalar, second, &res);
+            break;
+        case POLY_TRACE_SERIES_EXP_MOD:
+            PolySeriesExpMod(&args[0].p, (poly_exp_t)scalar, second, &res);
+            break;
+        case POLY_TRACE_SERIES_SQRT_MOD:
+            PolySeriesSqrtMod(&args[0].p, (poly_exp_t)scalar, second, &res);
+            break;
+        case POLY_TRACE_SHIFT:
+            res = PolyShift(&args[0].p, scalar);
+            break;
+        case POLY_TRACE_SHIFT_VAR:
+            res = PolyShiftVar(&args[0].p, (unsigned)scalar, second);
+            break;
+        case POLY_TRACE_EVAL_GRAD:
+            PolyEvalGrad(&args[0].p, (unsigned)scalar, values, values + scalar,
+                         values + 2 * scalar);
+            break;
+        case POLY_TRACE_FROM_COEFF_ARRAY:
+            res = PolyFromCoeffArray(args[0].count, coeffs, 1);
+            break;
+        case POLY_TRACE_TO_COEFF_ARRAY:
+            PolyToCoeffArray(&args[0].p, (unsigned)scalar, coeffs, 1);
+            break;
+        case POLY_TRACE_FROM_COEFF_TENSOR:
+            res = PolyFromCoeffTensor(args[0].count, sizes, strides, coeffs);
+            break;
+        case POLY_TRACE_TO_COEFF_TENSOR:
+            PolyToCoeffTensor(&args[0].p, args[1].count, sizes, strides, coeffs);
+            break;
+        case POLY_TRACE_ADD_MANY:
+            res = PolyAddMany(args[0].count, polys, coeffs);
+            break;
+        case POLY_TRACE_COMPOSE:
+            res = PolyCompose(&args[0].p, args[1].count, polys);
+            break;
+        default:
+            break;
+    }
+    unsigned long elapsed = NowNs() - start;
+    if (op == POLY_TRACE_ADD_MONOS)
+    {
+        // PolyAddMonos przejął zawartość jednomianów.
+        free(args[0].monos);
+        args[0].monos = NULL;
+    }
+    PolyDestroy(&res);
+    PolyDestroy(&rem);
+    PolyDestroy(&cofactor);
+    for (unsigned i = 0; i < grad_count; i++)
+        PolyDestroy(&grad[i]);
+    free(grad);
+    free(values);
+    free(coeffs);
+    free(sizes);
+    free(strides);
+    free(polys);
+    return elapsed;
+}
+
+/**
+ * Wypisuje na standardowe wyjście błędów informację o argumentach programu
+ * @param program_name nazwa programu
+ */
+void PrintHelp(char *program_name)
+{
+    fprintf(stderr, "Usage: %s <trace> [summary]\n", program_name);
+    fprintf(stderr, "Replays calls recorded with POLY_TRACE and reports "
+                    "recorded and current timings.\n");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 3 || (argc == 3 && strcmp(argv[2], "summary") != 0))
+    {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+    bool verbose = argc == 2;
+    FILE *in = fopen(argv[1], "rb");
+    char magic[4];
+    if (in == NULL || fread(magic, 1, 4, in) != 4 || memcmp(magic, "PLYT", 4) != 0
+        || fgetc(in) != POLY_TRACE_VERSION)
+    {
+        fprintf(stderr, "%s is not a trace file\n", argv[1]);
+        return -1;
+    }
+    ReplaySummary summary[MAX_OP + 1];
+    memset(summary, 0, sizeof(summary));
+    unsigned long index = 0, skipped = 0;
+    int op;
+    bool good = true;
+    while ((op = fgetc(in)) != EOF)
+    {
+        int count = fgetc(in);
+        if (op < 1 || op > MAX_OP || count < 0 || count > MAX_ARGS)
+        {
+            good = false;
+            break;
+        }
+        ReplayArg args[MAX_ARGS];
+        int read = 0;
+        while (read < count && ReadArg(in, &args[read]))
+            read++;
+        unsigned long scalar[MAX_SCALARS] = {0}, recorded;
+        int scalars = read == count ? fgetc(in) : EOF;
+        int read_scalars = 0;
+        while (read_scalars < scalars && read_scalars < MAX_SCALARS
+               && ReadInt(in, 8, &scalar[read_scalars]))
+            read_scalars++;
+        if (scalars < 0 || read_scalars != scalars || !ReadInt(in, 8, &recorded))
+        {
+            for (int i = 0; i < read; i++)
+                FreeArg(&args[i]);
+            good = false;
+            break;
+        }
+        bool fingerprint = false;
+        for (int i = 0; i < count; i++)
+            fingerprint |= args[i].kind == POLY_TRACE_ARG_FINGERPRINT;
+        if (fingerprint || !ArgsMatch(op, args, count, scalars))
+        {
+            skipped++;
+        }
+        else
+        {
+            unsigned long replay = Replay(op, args, count, (long)scalar[0],
+                                          (long)scalar[1]);
+            summary[op].calls++;
+            summary[op].recorded_ns += (double)recorded;
+            summary[op].replay_ns += (double)replay;
+            if (verbose)
+                fprintf(stderr, "%8lu %-10s recorded %12lu ns  replay %12lu ns\n",
+                        index, op_names[op], recorded, replay);
+        }
+        for (int i = 0; i < count; i++)
+            FreeArg(&args[i]);
+        index++;
+    }
+    fclose(in);
+
+    fprintf(stderr, "%-10s %10s %16s %16s %8s\n", "op", "calls", "recorded ns",
+            "replay ns", "change");
+    for (int i = 1; i <= MAX_OP; i++)
+    {
+        if (summary[i].calls == 0)
+            continue;
+        fprintf(stderr, "%-10s %10lu %16.0f %16.0f %+7.1f%%\n", op_names[i],
+                summary[i].calls, summary[i].recorded_ns, summary[i].replay_ns,
+                100.0 * (summary[i].replay_ns / summary[i].recorded_ns - 1.0));
+    }
+    if (skipped > 0)
+        fprintf(stderr, "%lu call(s) recorded without operands were skipped\n",
+                skipped);
+    if (!good)
+        fprintf(stderr, "trace is truncated or corrupted after call %lu\n", index);
+    return good ? 0 : 1;
+}
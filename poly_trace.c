@@ -0,0 +1,814 @@
+#include "poly.h"
+#include "poly_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Funkcje zdefiniowane w poly.c pod nazwami z poly_untraced.h */
+Poly PolyCloneUntraced(const Poly *p);
+Poly PolyAddUntraced(const Poly *p, const Poly *q);
+Poly PolyAddMonosUntraced(unsigned count, const Mono monos[]);
+Poly PolyMulUntraced(const Poly *p, const Poly *q);
+Poly PolyNegUntraced(const Poly *p);
+Poly PolySubUntraced(const Poly *p, const Poly *q);
+poly_exp_t PolyDegByUntraced(const Poly *p, unsigned var_idx);
+poly_exp_t PolyDegUntraced(const Poly *p);
+bool PolyIsEqUntraced(const Poly *p, const Poly *q);
+Poly PolyAtUntraced(const Poly *p, poly_coeff_t x);
+Poly PolyScaleUntraced(const Poly *p, poly_coeff_t c);
+Poly PolyAddCoeffUntraced(const Poly *p, poly_coeff_t c);
+Poly PolyAddOwnedUntraced(Poly *p, Poly *q);
+Poly PolyMulOwnedUntraced(Poly *p, Poly *q);
+Poly PolyNegOwnedUntraced(Poly *p);
+Poly PolySubOwnedUntraced(Poly *p, Poly *q);
+void PolyAddToUntraced(Poly *p, const Poly *q);
+void PolySubFromUntraced(Poly *p, const Poly *q);
+void PolyScaleByUntraced(Poly *p, poly_coeff_t c);
+Poly PolySquareUntraced(const Poly *p);
+Poly PolyPowUntraced(const Poly *p, unsigned n);
+bool PolyDivRemUntraced(const Poly *p, const Poly *q, Poly *quot, Poly *rem);
+bool PolyDivExactUntraced(const Poly *p, const Poly *q, Poly *quot);
+bool PolyDividesUntraced(const Poly *q, const Poly *p);
+Poly PolyGcdUntraced(const Poly *p, const Poly *q);
+bool PolyGcdExtModUntraced(const Poly *p, const Poly *q, poly_coeff_t mod,
+                           Poly *gcd, Poly *s, Poly *t);
+Poly PolyResultantUntraced(const Poly *p, const Poly *q, unsigned var_idx);
+Poly PolyDiscriminantUntraced(const Poly *p, unsigned var_idx);
+Poly PolyDerivativeUntraced(const Poly *p, unsigned var_idx);
+bool PolyIntegralUntraced(const Poly *p, unsigned var_idx, Poly *res);
+void PolyGradientUntraced(const Poly *p, unsigned count, Poly grad[]);
+poly_coeff_t PolyEvalGradUntraced(const Poly *p, unsigned count, const poly_coeff_t point[],
+                                  poly_coeff_t grad[], poly_coeff_t hess_diag[]);
+Poly PolyMulTruncUntraced(const Poly *p, const Poly *q, poly_exp_t n);
+Poly PolyMulTruncTotalUntraced(const Poly *p, const Poly *q, poly_exp_t n);
+bool PolySeriesInvUntraced(const Poly *p, poly_exp_t n, Poly *res);
+bool PolySeriesInvModUntraced(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res);
+bool PolySeriesLogModUntraced(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res);
+bool PolySeriesExpModUntraced(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res);
+bool PolySeriesSqrtModUntraced(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res);
+Poly PolyShiftUntraced(const Poly *p, poly_coeff_t a);
+Poly PolyShiftVarUntraced(const Poly *p, unsigned var_idx, poly_coeff_t a);
+Poly PolyFromCoeffArrayUntraced(unsigned count, const poly_coeff_t coeffs[], ptrdiff_t stride);
+bool PolyToCoeffArrayUntraced(const Poly *p, unsigned count, poly_coeff_t coeffs[],
+                              ptrdiff_t stride);
+Poly PolyFromCoeffTensorUntraced(unsigned dims, const unsigned sizes[],
+                                 const ptrdiff_t strides[], const poly_coeff_t coeffs[]);
+bool PolyToCoeffTensorUntraced(const Poly *p, unsigned dims, const unsigned sizes[],
+                               const ptrdiff_t strides[], poly_coeff_t coeffs[]);
+Poly PolyAddManyUntraced(unsigned count, const Poly polys[], const poly_coeff_t weights[]);
+Poly PolyComposeUntraced(const Poly *p, unsigned k, const Poly q[]);
+
+/** Plik śladu (NULL, gdy nic nie nagrywamy) */
+static FILE *trace_file = NULL;
+
+/** Czy zapisujemy pełne argumenty */
+static bool trace_full = true;
+
+/** Czy sprawdziliśmy już zmienne środowiskowe */
+static bool trace_env_checked = false;
+
+bool PolyTraceStart(const char *path, bool full)
+{
+    PolyTraceStop();
+    trace_env_checked = true;
+    trace_file = fopen(path, "wb");
+    if (trace_file == NULL)
+        return false;
+    trace_full = full;
+    fwrite("PLYT", 1, 4, trace_file);
+    fputc(POLY_TRACE_VERSION, trace_file);
+    return true;
+}
+
+void PolyTraceStop(void)
+{
+    if (trace_file != NULL)
+    {
+        fclose(trace_file);
+        trace_file = NULL;
+    }
+}
+
+/**
+ * Sprawdza, czy nagrywamy. Przy pierwszym wywołaniu rozpoczyna nagrywanie,
+ * jeśli ustawiona jest zmienna środowiskowa POLY_TRACE_FILE.
+ * @return czy wywołanie należy nagrać
+ */
+static bool TraceActive(void)
+{
+    if (!trace_env_checked)
+    {
+        trace_env_checked = true;
+        const char *path = getenv("POLY_TRACE_FILE");
+        const char *fingerprint = getenv("POLY_TRACE_FINGERPRINT");
+        if (path != NULL && PolyTraceStart(path, fingerprint == NULL
+                                                 || strcmp(fingerprint, "1") != 0))
+            atexit(PolyTraceStop);
+    }
+    return trace_file != NULL;
+}
+
+/**
+ * Zwraca aktualny czas w nanosekundach.
+ */
+static unsigned long TraceNow(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (unsigned long)ts.tv_sec * 1000000000UL + (unsigned long)ts.tv_nsec;
+}
+
+/**
+ * Zapisuje @p bytes najmłodszych bajtów liczby @p value (little-endian).
+ */
+static void TraceWriteInt(unsigned long value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+        fputc((int)((value >> (8 * i)) & 0xff), trace_file);
+}
+
+/**
+ * Zapisuje początek rekordu: operację i wielomiany będące argumentami.
+ * @param op : operacja
+ * @param count : liczba wielomianów
+ * @param p : pierwszy wielomian
+ * @param q : drugi wielomian (jeśli @p count == 2)
+ */
+static void TraceBegin(PolyTraceOp op, int count, const Poly *p, const Poly *q)
+{
+    fputc(op, trace_file);
+    fputc(count, trace_file);
+    if (count > 0)
+        PolyTraceWritePoly(trace_file, p, trace_full);
+    if (count > 1)
+        PolyTraceWritePoly(trace_file, q, trace_full);
+}
+
+/**
+ * Zapisuje koniec rekordu: argument liczbowy (opcjonalny) i czas wykonania.
+ * @param scalars : liczba argumentów liczbowych (0 lub 1)
+ * @param scalar : argument liczbowy
+ * @param start : czas rozpoczęcia wywołania
+ */
+static void TraceEnd(int scalars, long scalar, unsigned long start)
+{
+    unsigned long elapsed = TraceNow() - start;
+    fputc(scalars, trace_file);
+    if (scalars > 0)
+        TraceWriteInt((unsigned long)scalar, 8);
+    TraceWriteInt(elapsed, 8);
+}
+
+/**
+ * Zapisuje koniec rekordu z dwoma argumentami liczbowymi i czasem wykonania.
+ * @param first : pierwszy argument liczbowy
+ * @param second : drugi argument liczbowy
+ * @param start : czas rozpoczęcia wywołania
+ */
+static void TraceEndPair(long first, long second, unsigned long start)
+{
+    unsigned long elapsed = TraceNow() - start;
+    fputc(2, trace_file);
+    TraceWriteInt((unsigned long)first, 8);
+    TraceWriteInt((unsigned long)second, 8);
+    TraceWriteInt(elapsed, 8);
+}
+
+/**
+ * Zapisuje początek argumentu będącego listą.
+ * @param count : liczba elementów listy
+ */
+static void TraceWriteList(unsigned count)
+{
+    fputc(POLY_TRACE_ARG_LIST, trace_file);
+    TraceWriteInt(count, 4);
+}
+
+/**
+ * Zapisuje współczynnik jako element listy (przy zapisie odcisków także
+ * jako odcisk).
+ * @param c : współczynnik
+ */
+static void TraceWriteCoeff(poly_coeff_t c)
+{
+    Poly p = PolyFromCoeff(c);
+    PolyTraceWritePoly(trace_file, &p, trace_full);
+}
+
+/**
+ * Zapisuje tablicę wielomianów jako listę.
+ * @param count : liczba wielomianów
+ * @param polys : tablica wielomianów
+ */
+static void TraceWritePolys(unsigned count, const Poly polys[])
+{
+    TraceWriteList(count);
+    for (unsigned i = 0; i < count; i++)
+        PolyTraceWritePoly(trace_file, &polys[i], trace_full);
+}
+
+/**
+ * Zapisuje rozmiary wymiarów tablicy współczynników jako listę.
+ * Rozmiary opisują tylko kształt tablicy, więc zapisywane są zawsze w całości.
+ * @param dims : liczba wymiarów
+ * @param sizes : rozmiary kolejnych wymiarów
+ */
+static void TraceWriteSizes(unsigned dims, const unsigned sizes[])
+{
+    TraceWriteList(dims);
+    for (unsigned k = 0; k < dims; k++)
+    {
+        fputc(POLY_TRACE_ARG_COEFF, trace_file);
+        TraceWriteInt(sizes[k], 8);
+    }
+}
+
+/**
+ * Zapisuje elementy wielowymiarowej tablicy współczynników w kolejności
+ * wierszowej (ostatni indeks zmienia się najszybciej).
+ * @param dims : liczba wymiarów
+ * @param sizes : rozmiary kolejnych wymiarów
+ * @param strides : odstępy między elementami w kolejnych wymiarach
+ * @param coeffs : element o indeksach równych zero
+ */
+static void TraceWriteTensor(unsigned dims, const unsigned sizes[],
+                             const ptrdiff_t strides[], const poly_coeff_t *coeffs)
+{
+    if (dims == 0)
+    {
+        TraceWriteCoeff(*coeffs);
+        return;
+    }
+    for (unsigned i = 0; i < sizes[0]; i++)
+        TraceWriteTensor(dims - 1, sizes + 1, strides + 1,
+                         coeffs + (ptrdiff_t)i * strides[0]);
+}
+
+Poly PolyClone(const Poly *p)
+{
+    if (!TraceActive())
+        return PolyCloneUntraced(p);
+    TraceBegin(POLY_TRACE_CLONE, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyCloneUntraced(p);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyAdd(const Poly *p, const Poly *q)
+{
+    if (!TraceActive())
+        return PolyAddUntraced(p, q);
+    TraceBegin(POLY_TRACE_ADD, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolyAddUntraced(p, q);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyAddMonos(unsigned count, const Mono monos[])
+{
+    if (!TraceActive())
+        return PolyAddMonosUntraced(count, monos);
+    // PolyAddMonos przejmuje jednomiany, więc zapisujemy je przed
+    // wywołaniem.
+    fputc(POLY_TRACE_ADD_MONOS, trace_file);
+    fputc(1, trace_file);
+    fputc(POLY_TRACE_ARG_MONOS, trace_file);
+    TraceWriteInt(count, 4);
+    for (unsigned i = 0; i < count; i++)
+    {
+        TraceWriteInt((unsigned long)(unsigned)monos[i].exp, 4);
+        PolyTraceWritePoly(trace_file, &monos[i].p, trace_full);
+    }
+    unsigned long start = TraceNow();
+    Poly res = PolyAddMonosUntraced(count, monos);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyMul(const Poly *p, const Poly *q)
+{
+    if (!TraceActive())
+        return PolyMulUntraced(p, q);
+    TraceBegin(POLY_TRACE_MUL, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolyMulUntraced(p, q);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyNeg(const Poly *p)
+{
+    if (!TraceActive())
+        return PolyNegUntraced(p);
+    TraceBegin(POLY_TRACE_NEG, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyNegUntraced(p);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolySub(const Poly *p, const Poly *q)
+{
+    if (!TraceActive())
+        return PolySubUntraced(p, q);
+    TraceBegin(POLY_TRACE_SUB, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolySubUntraced(p, q);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+poly_exp_t PolyDegBy(const Poly *p, unsigned var_idx)
+{
+    if (!TraceActive())
+        return PolyDegByUntraced(p, var_idx);
+    TraceBegin(POLY_TRACE_DEG_BY, 1, p, NULL);
+    unsigned long start = TraceNow();
+    poly_exp_t res = PolyDegByUntraced(p, var_idx);
+    TraceEnd(1, (long)var_idx, start);
+    return res;
+}
+
+poly_exp_t PolyDeg(const Poly *p)
+{
+    if (!TraceActive())
+        return PolyDegUntraced(p);
+    TraceBegin(POLY_TRACE_DEG, 1, p, NULL);
+    unsigned long start = TraceNow();
+    poly_exp_t res = PolyDegUntraced(p);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+bool PolyIsEq(const Poly *p, const Poly *q)
+{
+    if (!TraceActive())
+        return PolyIsEqUntraced(p, q);
+    TraceBegin(POLY_TRACE_IS_EQ, 2, p, q);
+    unsigned long start = TraceNow();
+    bool res = PolyIsEqUntraced(p, q);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyAt(const Poly *p, poly_coeff_t x)
+{
+    if (!TraceActive())
+        return PolyAtUntraced(p, x);
+    TraceBegin(POLY_TRACE_AT, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyAtUntraced(p, x);
+    TraceEnd(1, x, start);
+    return res;
+}
+
+Poly PolyScale(const Poly *p, poly_coeff_t c)
+{
+    if (!TraceActive())
+        return PolyScaleUntraced(p, c);
+    TraceBegin(POLY_TRACE_SCALE, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyScaleUntraced(p, c);
+    TraceEnd(1, c, start);
+    return res;
+}
+
+Poly PolyAddCoeff(const Poly *p, poly_coeff_t c)
+{
+    if (!TraceActive())
+        return PolyAddCoeffUntraced(p, c);
+    TraceBegin(POLY_TRACE_ADD_COEFF, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyAddCoeffUntraced(p, c);
+    TraceEnd(1, c, start);
+    return res;
+}
+
+Poly PolyAddOwned(Poly *p, Poly *q)
+{
+    if (!TraceActive())
+        return PolyAddOwnedUntraced(p, q);
+    TraceBegin(POLY_TRACE_ADD_OWNED, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolyAddOwnedUntraced(p, q);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyMulOwned(Poly *p, Poly *q)
+{
+    if (!TraceActive())
+        return PolyMulOwnedUntraced(p, q);
+    TraceBegin(POLY_TRACE_MUL_OWNED, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolyMulOwnedUntraced(p, q);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyNegOwned(Poly *p)
+{
+    if (!TraceActive())
+        return PolyNegOwnedUntraced(p);
+    TraceBegin(POLY_TRACE_NEG_OWNED, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyNegOwnedUntraced(p);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolySubOwned(Poly *p, Poly *q)
+{
+    if (!TraceActive())
+        return PolySubOwnedUntraced(p, q);
+    TraceBegin(POLY_TRACE_SUB_OWNED, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolySubOwnedUntraced(p, q);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+void PolyAddTo(Poly *p, const Poly *q)
+{
+    if (!TraceActive())
+    {
+        PolyAddToUntraced(p, q);
+        return;
+    }
+    TraceBegin(POLY_TRACE_ADD_TO, 2, p, q);
+    unsigned long start = TraceNow();
+    PolyAddToUntraced(p, q);
+    TraceEnd(0, 0, start);
+}
+
+void PolySubFrom(Poly *p, const Poly *q)
+{
+    if (!TraceActive())
+    {
+        PolySubFromUntraced(p, q);
+        return;
+    }
+    TraceBegin(POLY_TRACE_SUB_FROM, 2, p, q);
+    unsigned long start = TraceNow();
+    PolySubFromUntraced(p, q);
+    TraceEnd(0, 0, start);
+}
+
+void PolyScaleBy(Poly *p, poly_coeff_t c)
+{
+    if (!TraceActive())
+    {
+        PolyScaleByUntraced(p, c);
+        return;
+    }
+    TraceBegin(POLY_TRACE_SCALE_BY, 1, p, NULL);
+    unsigned long start = TraceNow();
+    PolyScaleByUntraced(p, c);
+    TraceEnd(1, c, start);
+}
+
+Poly PolySquare(const Poly *p)
+{
+    if (!TraceActive())
+        return PolySquareUntraced(p);
+    TraceBegin(POLY_TRACE_SQUARE, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolySquareUntraced(p);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyPow(const Poly *p, unsigned n)
+{
+    if (!TraceActive())
+        return PolyPowUntraced(p, n);
+    TraceBegin(POLY_TRACE_POW, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyPowUntraced(p, n);
+    TraceEnd(1, n, start);
+    return res;
+}
+
+bool PolyDivRem(const Poly *p, const Poly *q, Poly *quot, Poly *rem)
+{
+    if (!TraceActive())
+        return PolyDivRemUntraced(p, q, quot, rem);
+    TraceBegin(POLY_TRACE_DIV_REM, 2, p, q);
+    unsigned long start = TraceNow();
+    bool res = PolyDivRemUntraced(p, q, quot, rem);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+bool PolyDivExact(const Poly *p, const Poly *q, Poly *quot)
+{
+    if (!TraceActive())
+        return PolyDivExactUntraced(p, q, quot);
+    TraceBegin(POLY_TRACE_DIV_EXACT, 2, p, q);
+    unsigned long start = TraceNow();
+    bool res = PolyDivExactUntraced(p, q, quot);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+bool PolyDivides(const Poly *q, const Poly *p)
+{
+    if (!TraceActive())
+        return PolyDividesUntraced(q, p);
+    TraceBegin(POLY_TRACE_DIVIDES, 2, q, p);
+    unsigned long start = TraceNow();
+    bool res = PolyDividesUntraced(q, p);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyGcd(const Poly *p, const Poly *q)
+{
+    if (!TraceActive())
+        return PolyGcdUntraced(p, q);
+    TraceBegin(POLY_TRACE_GCD, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolyGcdUntraced(p, q);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+bool PolyGcdExtMod(const Poly *p, const Poly *q, poly_coeff_t mod,
+                   Poly *gcd, Poly *s, Poly *t)
+{
+    if (!TraceActive())
+        return PolyGcdExtModUntraced(p, q, mod, gcd, s, t);
+    TraceBegin(POLY_TRACE_GCD_EXT_MOD, 2, p, q);
+    unsigned long start = TraceNow();
+    bool res = PolyGcdExtModUntraced(p, q, mod, gcd, s, t);
+    TraceEnd(1, mod, start);
+    return res;
+}
+
+Poly PolyResultant(const Poly *p, const Poly *q, unsigned var_idx)
+{
+    if (!TraceActive())
+        return PolyResultantUntraced(p, q, var_idx);
+    TraceBegin(POLY_TRACE_RESULTANT, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolyResultantUntraced(p, q, var_idx);
+    TraceEnd(1, var_idx, start);
+    return res;
+}
+
+Poly PolyDiscriminant(const Poly *p, unsigned var_idx)
+{
+    if (!TraceActive())
+        return PolyDiscriminantUntraced(p, var_idx);
+    TraceBegin(POLY_TRACE_DISCRIMINANT, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyDiscriminantUntraced(p, var_idx);
+    TraceEnd(1, var_idx, start);
+    return res;
+}
+
+Poly PolyDerivative(const Poly *p, unsigned var_idx)
+{
+    if (!TraceActive())
+        return PolyDerivativeUntraced(p, var_idx);
+    TraceBegin(POLY_TRACE_DERIVATIVE, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyDerivativeUntraced(p, var_idx);
+    TraceEnd(1, var_idx, start);
+    return res;
+}
+
+bool PolyIntegral(const Poly *p, unsigned var_idx, Poly *res)
+{
+    if (!TraceActive())
+        return PolyIntegralUntraced(p, var_idx, res);
+    TraceBegin(POLY_TRACE_INTEGRAL, 1, p, NULL);
+    unsigned long start = TraceNow();
+    bool ok = PolyIntegralUntraced(p, var_idx, res);
+    TraceEnd(1, var_idx, start);
+    return ok;
+}
+
+void PolyGradient(const Poly *p, unsigned count, Poly grad[])
+{
+    if (!TraceActive())
+    {
+        PolyGradientUntraced(p, count, grad);
+        return;
+    }
+    TraceBegin(POLY_TRACE_GRADIENT, 1, p, NULL);
+    unsigned long start = TraceNow();
+    PolyGradientUntraced(p, count, grad);
+    TraceEnd(1, count, start);
+}
+
+poly_coeff_t PolyEvalGrad(const Poly *p, unsigned count, const poly_coeff_t point[],
+                          poly_coeff_t grad[], poly_coeff_t hess_diag[])
+{
+    if (!TraceActive())
+        return PolyEvalGradUntraced(p, count, point, grad, hess_diag);
+    // Zapisywana jest tylko liczba współrzędnych punktu, nie same współrzędne.
+    TraceBegin(POLY_TRACE_EVAL_GRAD, 1, p, NULL);
+    unsigned long start = TraceNow();
+    poly_coeff_t res = PolyEvalGradUntraced(p, count, point, grad, hess_diag);
+    TraceEnd(1, count, start);
+    return res;
+}
+
+Poly PolyMulTrunc(const Poly *p, const Poly *q, poly_exp_t n)
+{
+    if (!TraceActive())
+        return PolyMulTruncUntraced(p, q, n);
+    TraceBegin(POLY_TRACE_MUL_TRUNC, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolyMulTruncUntraced(p, q, n);
+    TraceEnd(1, n, start);
+    return res;
+}
+
+Poly PolyMulTruncTotal(const Poly *p, const Poly *q, poly_exp_t n)
+{
+    if (!TraceActive())
+        return PolyMulTruncTotalUntraced(p, q, n);
+    TraceBegin(POLY_TRACE_MUL_TRUNC_TOTAL, 2, p, q);
+    unsigned long start = TraceNow();
+    Poly res = PolyMulTruncTotalUntraced(p, q, n);
+    TraceEnd(1, n, start);
+    return res;
+}
+
+bool PolySeriesInv(const Poly *p, poly_exp_t n, Poly *res)
+{
+    if (!TraceActive())
+        return PolySeriesInvUntraced(p, n, res);
+    TraceBegin(POLY_TRACE_SERIES_INV, 1, p, NULL);
+    unsigned long start = TraceNow();
+    bool ok = PolySeriesInvUntraced(p, n, res);
+    TraceEnd(1, n, start);
+    return ok;
+}
+
+bool PolySeriesInvMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res)
+{
+    if (!TraceActive())
+        return PolySeriesInvModUntraced(p, n, mod, res);
+    TraceBegin(POLY_TRACE_SERIES_INV_MOD, 1, p, NULL);
+    unsigned long start = TraceNow();
+    bool ok = PolySeriesInvModUntraced(p, n, mod, res);
+    TraceEndPair(n, mod, start);
+    return ok;
+}
+
+bool PolySeriesLogMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res)
+{
+    if (!TraceActive())
+        return PolySeriesLogModUntraced(p, n, mod, res);
+    TraceBegin(POLY_TRACE_SERIES_LOG_MOD, 1, p, NULL);
+    unsigned long start = TraceNow();
+    bool ok = PolySeriesLogModUntraced(p, n, mod, res);
+    TraceEndPair(n, mod, start);
+    return ok;
+}
+
+bool PolySeriesExpMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res)
+{
+    if (!TraceActive())
+        return PolySeriesExpModUntraced(p, n, mod, res);
+    TraceBegin(POLY_TRACE_SERIES_EXP_MOD, 1, p, NULL);
+    unsigned long start = TraceNow();
+    bool ok = PolySeriesExpModUntraced(p, n, mod, res);
+    TraceEndPair(n, mod, start);
+    return ok;
+}
+
+bool PolySeriesSqrtMod(const Poly *p, poly_exp_t n, poly_coeff_t mod, Poly *res)
+{
+    if (!TraceActive())
+        return PolySeriesSqrtModUntraced(p, n, mod, res);
+    TraceBegin(POLY_TRACE_SERIES_SQRT_MOD, 1, p, NULL);
+    unsigned long start = TraceNow();
+    bool ok = PolySeriesSqrtModUntraced(p, n, mod, res);
+    TraceEndPair(n, mod, start);
+    return ok;
+}
+
+Poly PolyShift(const Poly *p, poly_coeff_t a)
+{
+    if (!TraceActive())
+        return PolyShiftUntraced(p, a);
+    TraceBegin(POLY_TRACE_SHIFT, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyShiftUntraced(p, a);
+    TraceEnd(1, a, start);
+    return res;
+}
+
+Poly PolyShiftVar(const Poly *p, unsigned var_idx, poly_coeff_t a)
+{
+    if (!TraceActive())
+        return PolyShiftVarUntraced(p, var_idx, a);
+    TraceBegin(POLY_TRACE_SHIFT_VAR, 1, p, NULL);
+    unsigned long start = TraceNow();
+    Poly res = PolyShiftVarUntraced(p, var_idx, a);
+    TraceEndPair(var_idx, a, start);
+    return res;
+}
+
+Poly PolyFromCoeffArray(unsigned count, const poly_coeff_t coeffs[], ptrdiff_t stride)
+{
+    if (!TraceActive())
+        return PolyFromCoeffArrayUntraced(count, coeffs, stride);
+    // Współczynniki zapisywane są kolejno, bez odstępu.
+    fputc(POLY_TRACE_FROM_COEFF_ARRAY, trace_file);
+    fputc(1, trace_file);
+    TraceWriteList(count);
+    for (unsigned i = 0; i < count; i++)
+        TraceWriteCoeff(coeffs[(ptrdiff_t)i * stride]);
+    unsigned long start = TraceNow();
+    Poly res = PolyFromCoeffArrayUntraced(count, coeffs, stride);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+bool PolyToCoeffArray(const Poly *p, unsigned count, poly_coeff_t coeffs[], ptrdiff_t stride)
+{
+    if (!TraceActive())
+        return PolyToCoeffArrayUntraced(p, count, coeffs, stride);
+    TraceBegin(POLY_TRACE_TO_COEFF_ARRAY, 1, p, NULL);
+    unsigned long start = TraceNow();
+    bool res = PolyToCoeffArrayUntraced(p, count, coeffs, stride);
+    TraceEnd(1, count, start);
+    return res;
+}
+
+Poly PolyFromCoeffTensor(unsigned dims, const unsigned sizes[],
+                         const ptrdiff_t strides[], const poly_coeff_t coeffs[])
+{
+    if (!TraceActive())
+        return PolyFromCoeffTensorUntraced(dims, sizes, strides, coeffs);
+    // Tablica zapisywana jest jako ciągła, bez odstępów.
+    unsigned long total = 1;
+    for (unsigned k = 0; k < dims; k++)
+        total *= sizes[k];
+    fputc(POLY_TRACE_FROM_COEFF_TENSOR, trace_file);
+    fputc(2, trace_file);
+    TraceWriteSizes(dims, sizes);
+    TraceWriteList((unsigned)total);
+    TraceWriteTensor(dims, sizes, strides, coeffs);
+    unsigned long start = TraceNow();
+    Poly res = PolyFromCoeffTensorUntraced(dims, sizes, strides, coeffs);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+bool PolyToCoeffTensor(const Poly *p, unsigned dims, const unsigned sizes[],
+                       const ptrdiff_t strides[], poly_coeff_t coeffs[])
+{
+    if (!TraceActive())
+        return PolyToCoeffTensorUntraced(p, dims, sizes, strides, coeffs);
+    fputc(POLY_TRACE_TO_COEFF_TENSOR, trace_file);
+    fputc(2, trace_file);
+    PolyTraceWritePoly(trace_file, p, trace_full);
+    TraceWriteSizes(dims, sizes);
+    unsigned long start = TraceNow();
+    bool res = PolyToCoeffTensorUntraced(p, dims, sizes, strides, coeffs);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyAddMany(unsigned count, const Poly polys[], const poly_coeff_t weights[])
+{
+    if (!TraceActive())
+        return PolyAddManyUntraced(count, polys, weights);
+    // Wagi są drugim argumentem, jeśli zostały podane.
+    fputc(POLY_TRACE_ADD_MANY, trace_file);
+    fputc(weights != NULL ? 2 : 1, trace_file);
+    TraceWritePolys(count, polys);
+    if (weights != NULL)
+    {
+        TraceWriteList(count);
+        for (unsigned i = 0; i < count; i++)
+            TraceWriteCoeff(weights[i]);
+    }
+    unsigned long start = TraceNow();
+    Poly res = PolyAddManyUntraced(count, polys, weights);
+    TraceEnd(0, 0, start);
+    return res;
+}
+
+Poly PolyCompose(const Poly *p, unsigned k, const Poly q[])
+{
+    if (!TraceActive())
+        return PolyComposeUntraced(p, k, q);
+    fputc(POLY_TRACE_COMPOSE, trace_file);
+    fputc(2, trace_file);
+    PolyTraceWritePoly(trace_file, p, trace_full);
+    TraceWritePolys(k, q);
+    unsigned long start = TraceNow();
+    Poly res = PolyComposeUntraced(p, k, q);
+    TraceEnd(0, 0, start);
+    return res;
+}
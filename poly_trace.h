@@ -0,0 +1,129 @@
+#ifndef POLY_POLY_TRACE_H
+#define POLY_POLY_TRACE_H
+
+#include "poly.h"
+#include <stdio.h>
+
+/**
+ * Nagrywanie wywołań biblioteki do pliku śladu.
+ *
+ * Nagrywanie jest dostępne tylko w programach zbudowanych z opcją
+ * POLY_TRACE (wtedy publiczne funkcje z poly.h są opakowane przez
+ * poly_trace.c). Zapis rozpoczyna wywołanie PolyTraceStart albo ustawienie
+ * zmiennej środowiskowej POLY_TRACE_FILE na ścieżkę pliku; zmienna
+ * POLY_TRACE_FINGERPRINT=1 włącza zapis samych odcisków argumentów.
+ * Nagrywane są tylko wywołania z zewnątrz biblioteki, wywołania rekurencyjne
+ * nie trafiają do śladu.
+ *
+ * Funkcje PolyBuilder* nie są nagrywane: każde wywołanie zależy od stanu
+ * budowniczego pozostawionego przez poprzednie, więc pojedynczego rekordu
+ * nie dałoby się odtworzyć osobno. Zbudowany wielomian trafia do śladu
+ * jako argument operacji, w których jest potem używany.
+ *
+ * Format pliku (liczby całkowite zapisane w porządku little-endian):
+ * - nagłówek: 4 bajty "PLYT", 1 bajt wersji POLY_TRACE_VERSION;
+ * - rekord: 1 bajt operacji (PolyTraceOp), 1 bajt liczby argumentów,
+ *   argumenty, 1 bajt liczby argumentów liczbowych, argumenty liczbowe
+ *   (po 8 bajtów), 8 bajtów czasu wykonania w nanosekundach;
+ * - argument: 1 bajt rodzaju (PolyTraceArg), a dalej:
+ *   - POLY_TRACE_ARG_COEFF: 8 bajtów współczynnika,
+ *   - POLY_TRACE_ARG_POLY i POLY_TRACE_ARG_MONOS: 4 bajty liczby
+ *     jednomianów, a dla każdego 4 bajty wykładnika i współczynnik zapisany
+ *     jako argument,
+ *   - POLY_TRACE_ARG_FINGERPRINT: 8 bajtów skrótu i 4 bajty liczby
+ *     jednomianów,
+ *   - POLY_TRACE_ARG_LIST: 4 bajty liczby elementów i elementy zapisane
+ *     jako argumenty (tablica wielomianów albo współczynników).
+ */
+
+/** Wersja formatu pliku śladu */
+#define POLY_TRACE_VERSION 1
+
+/** Kody nagrywanych operacji */
+typedef enum PolyTraceOp
+{
+    POLY_TRACE_CLONE = 1,
+    POLY_TRACE_ADD,
+    POLY_TRACE_ADD_MONOS,
+    POLY_TRACE_MUL,
+    POLY_TRACE_NEG,
+    POLY_TRACE_SUB,
+    POLY_TRACE_DEG_BY,
+    POLY_TRACE_DEG,
+    POLY_TRACE_IS_EQ,
+    POLY_TRACE_AT,
+    POLY_TRACE_SCALE,
+    POLY_TRACE_ADD_COEFF,
+    POLY_TRACE_ADD_OWNED,
+    POLY_TRACE_MUL_OWNED,
+    POLY_TRACE_NEG_OWNED,
+    POLY_TRACE_SUB_OWNED,
+    POLY_TRACE_ADD_TO,
+    POLY_TRACE_SUB_FROM,
+    POLY_TRACE_SCALE_BY,
+    POLY_TRACE_SQUARE,
+    POLY_TRACE_POW,
+    POLY_TRACE_DIV_REM,
+    POLY_TRACE_DIV_EXACT,
+    POLY_TRACE_DIVIDES,
+    POLY_TRACE_GCD,
+    POLY_TRACE_GCD_EXT_MOD,
+    POLY_TRACE_RESULTANT,
+    POLY_TRACE_DISCRIMINANT,
+    POLY_TRACE_DERIVATIVE,
+    POLY_TRACE_INTEGRAL,
+    POLY_TRACE_GRADIENT,
+    POLY_TRACE_EVAL_GRAD,
+    POLY_TRACE_MUL_TRUNC,
+    POLY_TRACE_MUL_TRUNC_TOTAL,
+    POLY_TRACE_SERIES_INV,
+    POLY_TRACE_SERIES_INV_MOD,
+    POLY_TRACE_SERIES_LOG_MOD,
+    POLY_TRACE_SERIES_EXP_MOD,
+    POLY_TRACE_SERIES_SQRT_MOD,
+    POLY_TRACE_SHIFT,
+    POLY_TRACE_SHIFT_VAR,
+    POLY_TRACE_FROM_COEFF_ARRAY,
+    POLY_TRACE_TO_COEFF_ARRAY,
+    POLY_TRACE_FROM_COEFF_TENSOR,
+    POLY_TRACE_TO_COEFF_TENSOR,
+    POLY_TRACE_ADD_MANY,
+    POLY_TRACE_COMPOSE
+} PolyTraceOp;
+
+/** Rodzaje zapisanych argumentów */
+typedef enum PolyTraceArg
+{
+    POLY_TRACE_ARG_COEFF = 0,
+    POLY_TRACE_ARG_POLY,
+    POLY_TRACE_ARG_MONOS,
+    POLY_TRACE_ARG_FINGERPRINT,
+    POLY_TRACE_ARG_LIST
+} PolyTraceArg;
+
+/**
+ * Rozpoczyna nagrywanie do pliku @p path (nadpisuje go).
+ * Kończy wcześniej rozpoczęte nagrywanie.
+ * @param[in] path : ścieżka pliku śladu
+ * @param[in] full : czy zapisywać pełne argumenty (w przeciwnym razie
+ * zapisywane są tylko ich odciski, których nie da się odtworzyć)
+ * @return czy udało się otworzyć plik
+ */
+bool PolyTraceStart(const char *path, bool full);
+
+/**
+ * Kończy nagrywanie i zamyka plik śladu.
+ */
+void PolyTraceStop(void);
+
+/**
+ * Zapisuje wielomian jako argument śladu.
+ * Funkcja jest zdefiniowana w poly.c, bo tylko tam znana jest budowa
+ * wielomianu.
+ * @param[in] out : plik śladu
+ * @param[in] p : wielomian
+ * @param[in] full : czy zapisać cały wielomian, czy tylko jego odcisk
+ */
+void PolyTraceWritePoly(FILE *out, const Poly *p, bool full);
+
+#endif //POLY_POLY_TRACE_H
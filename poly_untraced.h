@@ -0,0 +1,60 @@
+#ifndef POLY_POLY_UNTRACED_H
+#define POLY_POLY_UNTRACED_H
+
+/*
+ * Przy budowaniu z opcją POLY_TRACE poly.c definiuje publiczne funkcje pod
+ * poniższymi nazwami, a funkcje o nazwach z poly.h definiuje poly_trace.c,
+ * który nagrywa wywołanie i przekazuje je dalej. Wywołania wewnątrz
+ * biblioteki (w tym rekurencyjne) trafiają od razu do wersji
+ * nienagrywanych.
+ */
+
+#define PolyClone PolyCloneUntraced
+#define PolyAdd PolyAddUntraced
+#define PolyAddMonos PolyAddMonosUntraced
+#define PolyMul PolyMulUntraced
+#define PolyNeg PolyNegUntraced
+#define PolySub PolySubUntraced
+#define PolyDegBy PolyDegByUntraced
+#define PolyDeg PolyDegUntraced
+#define PolyIsEq PolyIsEqUntraced
+#define PolyAt PolyAtUntraced
+#define PolyScale PolyScaleUntraced
+#define PolyAddCoeff PolyAddCoeffUntraced
+#define PolyAddOwned PolyAddOwnedUntraced
+#define PolyMulOwned PolyMulOwnedUntraced
+#define PolyNegOwned PolyNegOwnedUntraced
+#define PolySubOwned PolySubOwnedUntraced
+#define PolyAddTo PolyAddToUntraced
+#define PolySubFrom PolySubFromUntraced
+#define PolyScaleBy PolyScaleByUntraced
+#define PolySquare PolySquareUntraced
+#define PolyPow PolyPowUntraced
+#define PolyDivRem PolyDivRemUntraced
+#define PolyDivExact PolyDivExactUntraced
+#define PolyDivides PolyDividesUntraced
+#define PolyGcd PolyGcdUntraced
+#define PolyGcdExtMod PolyGcdExtModUntraced
+#define PolyResultant PolyResultantUntraced
+#define PolyDiscriminant PolyDiscriminantUntraced
+#define PolyDerivative PolyDerivativeUntraced
+#define PolyIntegral PolyIntegralUntraced
+#define PolyGradient PolyGradientUntraced
+#define PolyEvalGrad PolyEvalGradUntraced
+#define PolyMulTrunc PolyMulTruncUntraced
+#define PolyMulTruncTotal PolyMulTruncTotalUntraced
+#define PolySeriesInv PolySeriesInvUntraced
+#define PolySeriesInvMod PolySeriesInvModUntraced
+#define PolySeriesLogMod PolySeriesLogModUntraced
+#define PolySeriesExpMod PolySeriesExpModUntraced
+#define PolySeriesSqrtMod PolySeriesSqrtModUntraced
+#define PolyShift PolyShiftUntraced
+#define PolyShiftVar PolyShiftVarUntraced
+#define PolyFromCoeffArray PolyFromCoeffArrayUntraced
+#define PolyToCoeffArray PolyToCoeffArrayUntraced
+#define PolyFromCoeffTensor PolyFromCoeffTensorUntraced
+#define PolyToCoeffTensor PolyToCoeffTensorUntraced
+#define PolyAddMany PolyAddManyUntraced
+#define PolyCompose PolyComposeUntraced
+
+#endif //POLY_POLY_UNTRACED_H
@@ -30,6 +30,27 @@
 #define OVERFLOW "overflow"
 #define SIMPLE_ARITHMETIC "simple-aritmethic"
 #define SIMPLE_ARITHMETIC2 "simple-aritmethic2"
+#define SCALAR "scalar"
+#define OWNED "owned"
+#define IN_PLACE "in-place"
+#define ADD_MONOS_ORDER "add-monos-order"
+#define BUILDER "builder"
+#define COEFF_ARRAY "coeff-array"
+#define ADD_MANY "add-many"
+#define SQUARE "square"
+#define POW "pow"
+#define COMPOSE "compose"
+#define DIV_REM "div-rem"
+#define DIV_EXACT "div-exact"
+#define GCD "gcd"
+#define GCD_EXT_MOD "gcd-ext-mod"
+#define RESULTANT "resultant"
+#define DERIVATIVE "derivative"
+#define EVAL_GRAD "eval-grad"
+#define MUL_TRUNC "mul-trunc"
+#define SERIES "series"
+#define SHIFT "shift"
+#define NEG_SUB "neg-sub"
 
 bool SimpleArithmeticTest();
 
@@ -81,6 +102,48 @@ bool SimpleAtTest();
 
 bool OverflowTest();
 
+bool ScalarTest();
+
+bool OwnedTest();
+
+bool InPlaceTest();
+
+bool AddMonosOrderTest();
+
+bool BuilderTest();
+
+bool CoeffArrayTest();
+
+bool AddManyTest();
+
+bool SquareTest();
+
+bool PowTest();
+
+bool ComposeTest();
+
+bool DivRemTest();
+
+bool DivExactTest();
+
+bool GcdTest();
+
+bool GcdExtModTest();
+
+bool ResultantTest();
+
+bool DerivativeTest();
+
+bool EvalGradTest();
+
+bool MulTruncTest();
+
+bool SeriesTest();
+
+bool ShiftTest();
+
+bool NegSubTest();
+
 void MemoryThiefTest();
 
 void MemoryTest();
@@ -191,6 +254,90 @@ int main(int argc, char **argv)
     {
         return !OverflowTest();
     }
+    else if (strcmp(argv[1], SCALAR) == 0)
+    {
+        return !ScalarTest();
+    }
+    else if (strcmp(argv[1], OWNED) == 0)
+    {
+        return !OwnedTest();
+    }
+    else if (strcmp(argv[1], IN_PLACE) == 0)
+    {
+        return !InPlaceTest();
+    }
+    else if (strcmp(argv[1], ADD_MONOS_ORDER) == 0)
+    {
+        return !AddMonosOrderTest();
+    }
+    else if (strcmp(argv[1], BUILDER) == 0)
+    {
+        return !BuilderTest();
+    }
+    else if (strcmp(argv[1], COEFF_ARRAY) == 0)
+    {
+        return !CoeffArrayTest();
+    }
+    else if (strcmp(argv[1], ADD_MANY) == 0)
+    {
+        return !AddManyTest();
+    }
+    else if (strcmp(argv[1], SQUARE) == 0)
+    {
+        return !SquareTest();
+    }
+    else if (strcmp(argv[1], POW) == 0)
+    {
+        return !PowTest();
+    }
+    else if (strcmp(argv[1], COMPOSE) == 0)
+    {
+        return !ComposeTest();
+    }
+    else if (strcmp(argv[1], DIV_REM) == 0)
+    {
+        return !DivRemTest();
+    }
+    else if (strcmp(argv[1], DIV_EXACT) == 0)
+    {
+        return !DivExactTest();
+    }
+    else if (strcmp(argv[1], GCD) == 0)
+    {
+        return !GcdTest();
+    }
+    else if (strcmp(argv[1], GCD_EXT_MOD) == 0)
+    {
+        return !GcdExtModTest();
+    }
+    else if (strcmp(argv[1], RESULTANT) == 0)
+    {
+        return !ResultantTest();
+    }
+    else if (strcmp(argv[1], DERIVATIVE) == 0)
+    {
+        return !DerivativeTest();
+    }
+    else if (strcmp(argv[1], EVAL_GRAD) == 0)
+    {
+        return !EvalGradTest();
+    }
+    else if (strcmp(argv[1], MUL_TRUNC) == 0)
+    {
+        return !MulTruncTest();
+    }
+    else if (strcmp(argv[1], SERIES) == 0)
+    {
+        return !SeriesTest();
+    }
+    else if (strcmp(argv[1], SHIFT) == 0)
+    {
+        return !ShiftTest();
+    }
+    else if (strcmp(argv[1], NEG_SUB) == 0)
+    {
+        return !NegSubTest();
+    }
     else if (strcmp(argv[1], ALL_TESTS) == 0)
     {
         int res = 0;
@@ -219,7 +366,28 @@ int main(int argc, char **argv)
         res += SimpleIsEqTest();
         res += SimpleAtTest();//
         res += OverflowTest();
-        printf("%d of 20 tests passed\n", res);
+        res += ScalarTest();
+        res += OwnedTest();
+        res += InPlaceTest();
+        res += AddMonosOrderTest();
+        res += BuilderTest();
+        res += CoeffArrayTest();
+        res += AddManyTest();
+        res += SquareTest();
+        res += PowTest();
+        res += ComposeTest();
+        res += DivRemTest();
+        res += DivExactTest();
+        res += GcdTest();
+        res += GcdExtModTest();
+        res += ResultantTest();
+        res += DerivativeTest();
+        res += EvalGradTest();
+        res += MulTruncTest();
+        res += SeriesTest();
+        res += ShiftTest();
+        res += NegSubTest();
+        printf("%d of 41 tests passed\n", res);
     }
     else
     {
@@ -261,6 +429,27 @@ void PrintHelp(char *program_name)
     printf("\t%-*s - run simple equality test\n", width, EQ_SIMPLE);
     printf("\t%-*s - run rare polynomial test\n", width, RARE);
     printf("\t%-*s - run overflow test\n", width, OVERFLOW);
+    printf("\t%-*s - run scalar add/scale test\n", width, SCALAR);
+    printf("\t%-*s - run ownership-taking arithmetic test\n", width, OWNED);
+    printf("\t%-*s - run in-place accumulation test\n", width, IN_PLACE);
+    printf("\t%-*s - run add monos input order test\n", width, ADD_MONOS_ORDER);
+    printf("\t%-*s - run polynomial builder test\n", width, BUILDER);
+    printf("\t%-*s - run coefficient array conversion test\n", width, COEFF_ARRAY);
+    printf("\t%-*s - run n-ary summation test\n", width, ADD_MANY);
+    printf("\t%-*s - run squaring test\n", width, SQUARE);
+    printf("\t%-*s - run pow test\n", width, POW);
+    printf("\t%-*s - run compose test\n", width, COMPOSE);
+    printf("\t%-*s - run division with remainder test\n", width, DIV_REM);
+    printf("\t%-*s - run exact division test\n", width, DIV_EXACT);
+    printf("\t%-*s - run PolyGcd test\n", width, GCD);
+    printf("\t%-*s - run PolyGcdExtMod test\n", width, GCD_EXT_MOD);
+    printf("\t%-*s - run PolyResultant and PolyDiscriminant test\n", width, RESULTANT);
+    printf("\t%-*s - run PolyDerivative, PolyIntegral and PolyGradient test\n", width, DERIVATIVE);
+    printf("\t%-*s - run PolyEvalGrad test\n", width, EVAL_GRAD);
+    printf("\t%-*s - run PolyMulTrunc and PolyMulTruncTotal test\n", width, MUL_TRUNC);
+    printf("\t%-*s - run power series (PolySeries*) test\n", width, SERIES);
+    printf("\t%-*s - run PolyShift and PolyShiftVar test\n", width, SHIFT);
+    printf("\t%-*s - run negation and subtraction test\n", width, NEG_SUB);
 }
 
 /**
@@ -1402,6 +1591,16 @@ bool TestSub(Poly a, Poly b, Poly res)
     return TestOpC(a, b, res, PolySub);
 }
 
+bool TestNeg(Poly a, Poly res)
+{
+    Poly r = PolyNeg(&a);
+    bool is_eq = PolyIsEq(&r, &res);
+    PolyDestroy(&a);
+    PolyDestroy(&r);
+    PolyDestroy(&res);
+    return is_eq;
+}
+
 bool TestDegBy(Poly a, unsigned var_idx, int res)
 {
     bool is_eq = PolyDegBy(&a, var_idx) == res;
@@ -1434,6 +1633,626 @@ bool TestAt(Poly a, poly_coeff_t x, Poly res)
     return is_eq;
 }
 
+bool TestScale(Poly a, poly_coeff_t c, Poly res)
+{
+    Poly b = PolyScale(&a, c);
+    bool is_eq = PolyIsEq(&b, &res);
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&res);
+    return is_eq;
+}
+
+bool TestAddCoeff(Poly a, poly_coeff_t c, Poly res)
+{
+    Poly b = PolyAddCoeff(&a, c);
+    bool is_eq = PolyIsEq(&b, &res);
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&res);
+    return is_eq;
+}
+
+/**
+ * Sprawdza operację przejmującą argumenty: wynik oraz to, że argumenty
+ * zostały wyzerowane.
+ */
+bool TestOpOwned(Poly a, Poly b, Poly res, Poly (*op)(Poly *, Poly *))
+{
+    Poly c = op(&a, &b);
+    bool is_eq = PolyIsEq(&c, &res) && PolyIsZero(&a) && PolyIsZero(&b);
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&c);
+    PolyDestroy(&res);
+    return is_eq;
+}
+
+/**
+ * Sprawdza operację działającą w miejscu: wynik w @p a oraz to, że @p b
+ * nie został zmieniony.
+ */
+bool TestOpInPlace(Poly a, Poly b, Poly res, void (*op)(Poly *, const Poly *))
+{
+    Poly b_copy = PolyClone(&b);
+    op(&a, &b);
+    bool is_eq = PolyIsEq(&a, &res) && PolyIsEq(&b, &b_copy);
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&b_copy);
+    PolyDestroy(&res);
+    return is_eq;
+}
+
+/**
+ * Porównuje PolyPow z wielokrotnym mnożeniem przez PolyMul.
+ */
+bool TestPow(Poly p, unsigned n)
+{
+    Poly power = PolyPow(&p, n);
+    Poly product = C(1);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        Poly tmp = PolyMul(&product, &p);
+        PolyDestroy(&product);
+        product = tmp;
+    }
+    bool is_eq = PolyIsEq(&power, &product);
+    PolyDestroy(&p);
+    PolyDestroy(&power);
+    PolyDestroy(&product);
+    return is_eq;
+}
+
+/**
+ * Porównuje PolyCompose z wynikiem oczekiwanym.
+ * Przejmuje na własność wszystkie argumenty.
+ */
+bool TestCompose(Poly p, unsigned k, Poly q[], Poly expected)
+{
+    Poly composed = PolyCompose(&p, k, q);
+    bool is_eq = PolyIsEq(&composed, &expected);
+    PolyDestroy(&p);
+    for (unsigned i = 0; i < k; ++i)
+        PolyDestroy(&q[i]);
+    PolyDestroy(&composed);
+    PolyDestroy(&expected);
+    return is_eq;
+}
+
+/**
+ * Składa wielomian jednej zmiennej stopnia mniejszego niż @p n
+ * z wielomianem @p q, sumując iloczyny współczynników i potęg @p q.
+ */
+Poly ComposeReference(const Poly *p, unsigned n, const Poly *q)
+{
+    poly_coeff_t *coeffs = calloc(n, sizeof(poly_coeff_t));
+    Poly *pows = calloc(n, sizeof(Poly));
+    PolyToCoeffArray(p, n, coeffs, 1);
+    for (unsigned i = 0; i < n; ++i)
+        pows[i] = PolyPow(q, i);
+    Poly sum = PolyAddMany(n, pows, coeffs);
+    for (unsigned i = 0; i < n; ++i)
+        PolyDestroy(&pows[i]);
+    free(pows);
+    free(coeffs);
+    return sum;
+}
+
+/**
+ * Sprawdza PolyDivRem: dzieli @p p przez @p q i porównuje iloraz i resztę
+ * z oczekiwanymi. Przejmuje na własność wszystkie argumenty.
+ */
+bool TestDivRem(Poly p, Poly q, Poly quot, Poly rem)
+{
+    Poly res_quot, res_rem;
+    bool res = PolyDivRem(&p, &q, &res_quot, &res_rem);
+    res &= PolyIsEq(&res_quot, &quot) && PolyIsEq(&res_rem, &rem);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&quot);
+    PolyDestroy(&rem);
+    PolyDestroy(&res_quot);
+    PolyDestroy(&res_rem);
+    return res;
+}
+
+/**
+ * Dzieli `a * q + r` przez @p q, oczekując ilorazu @p a i reszty @p r.
+ * Przejmuje na własność wszystkie argumenty.
+ */
+bool TestDivRemProduct(Poly a, Poly q, Poly r)
+{
+    Poly p = PolyMul(&a, &q);
+    PolyAddTo(&p, &r);
+    return TestDivRem(p, q, a, r);
+}
+
+/**
+ * Porównuje PolyMul z sumą iloczynów @p p i kolejnych jednomianów @p q
+ * (wielomiany jednej zmiennej stopnia mniejszego niż @p n).
+ */
+bool TestMulByMonos(Poly p, Poly q, unsigned n)
+{
+    poly_coeff_t *coeffs = calloc(n, sizeof(poly_coeff_t));
+    Poly *products = calloc(n, sizeof(Poly));
+    PolyToCoeffArray(&q, n, coeffs, 1);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        Poly mono = P(C(1), i);
+        products[i] = PolyMul(&p, &mono);
+        PolyDestroy(&mono);
+    }
+    Poly expected = PolyAddMany(n, products, coeffs);
+    for (unsigned i = 0; i < n; ++i)
+        PolyDestroy(&products[i]);
+    Poly product = PolyMul(&p, &q);
+    bool is_eq = PolyIsEq(&product, &expected);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&product);
+    PolyDestroy(&expected);
+    free(products);
+    free(coeffs);
+    return is_eq;
+}
+
+/**
+ * Sprawdza PolyDivExact i PolyDivides dla `p = a * b`: oba czynniki
+ * muszą dzielić iloczyn, a iloraz musi być drugim czynnikiem.
+ * Przejmuje na własność argumenty.
+ */
+bool TestDivExact(Poly a, Poly b)
+{
+    Poly p = PolyMul(&a, &b);
+    Poly quot_a, quot_b;
+    bool res = PolyDivExact(&p, &b, &quot_a) && PolyIsEq(&quot_a, &a);
+    res &= PolyDivExact(&p, &a, &quot_b) && PolyIsEq(&quot_b, &b);
+    res &= PolyDivides(&a, &p) && PolyDivides(&b, &p);
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&p);
+    PolyDestroy(&quot_a);
+    PolyDestroy(&quot_b);
+    return res;
+}
+
+/**
+ * Sprawdza, że @p q nie dzieli @p p, a iloraz PolyDivExact jest zerem.
+ * Przejmuje na własność argumenty.
+ */
+bool TestNotDivides(Poly p, Poly q)
+{
+    Poly quot;
+    bool res = !PolyDivExact(&p, &q, &quot) && PolyIsZero(&quot);
+    res &= !PolyDivides(&q, &p);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&quot);
+    return res;
+}
+
+/**
+ * Sprawdza, że NWD @p p i @p q (w obu kolejnościach) to @p expected.
+ * Przejmuje na własność argumenty.
+ */
+bool TestGcd(Poly p, Poly q, Poly expected)
+{
+    Poly gcd_pq = PolyGcd(&p, &q);
+    Poly gcd_qp = PolyGcd(&q, &p);
+    bool res = PolyIsEq(&gcd_pq, &expected) && PolyIsEq(&gcd_qp, &expected);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&expected);
+    PolyDestroy(&gcd_pq);
+    PolyDestroy(&gcd_qp);
+    return res;
+}
+
+/**
+ * Sprawdza, że NWD `g * a` i `g * b` to `g`, gdy `a` i `b` są względnie
+ * pierwsze, a `g` ma dodatni wiodący współczynnik.
+ * Przejmuje na własność argumenty.
+ */
+bool TestGcdOfProducts(Poly g, Poly a, Poly b)
+{
+    Poly p = PolyMul(&g, &a);
+    Poly q = PolyMul(&g, &b);
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    return TestGcd(p, q, g);
+}
+
+/**
+ * Sprawdza, że PolyGcdExtMod wyznacza NWD @p expected wielomianów @p p
+ * i @p q modulo @p mod, a `s p + t q - NWD` ma współczynniki podzielne
+ * przez @p mod. Przejmuje na własność argumenty.
+ */
+bool TestGcdExtMod(Poly p, Poly q, poly_coeff_t mod, Poly expected)
+{
+    unsigned count = 8192;
+    poly_coeff_t *coeffs = calloc(count, sizeof(poly_coeff_t));
+    Poly gcd, s, t;
+    bool res = PolyGcdExtMod(&p, &q, mod, &gcd, &s, &t) && PolyIsEq(&gcd, &expected);
+    Poly sp = PolyMul(&s, &p);
+    Poly tq = PolyMul(&t, &q);
+    Poly sum = PolyAdd(&sp, &tq);
+    Poly diff = PolySub(&sum, &gcd);
+    res &= PolyToCoeffArray(&diff, count, coeffs, 1);
+    for (unsigned i = 0; i < count; ++i)
+        res &= coeffs[i] % mod == 0;
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&expected);
+    PolyDestroy(&gcd);
+    PolyDestroy(&s);
+    PolyDestroy(&t);
+    PolyDestroy(&sp);
+    PolyDestroy(&tq);
+    PolyDestroy(&sum);
+    PolyDestroy(&diff);
+    free(coeffs);
+    return res;
+}
+
+/**
+ * Sprawdza, że wypadkowa @p p i @p q względem `x_var` to @p expected,
+ * a wypadkowa w odwrotnej kolejności różni się znakiem `(-1)^(mn)`.
+ * Przejmuje na własność argumenty.
+ */
+bool TestResultant(Poly p, Poly q, unsigned var, bool odd, Poly expected)
+{
+    Poly res = PolyResultant(&p, &q, var);
+    Poly swapped = PolyResultant(&q, &p, var);
+    Poly neg = PolyNeg(&swapped);
+    bool is_eq = PolyIsEq(&res, &expected) && PolyIsEq(odd ? &neg : &swapped, &expected);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&expected);
+    PolyDestroy(&res);
+    PolyDestroy(&swapped);
+    PolyDestroy(&neg);
+    return is_eq;
+}
+
+/**
+ * Sprawdza, że wyróżnik @p p względem `x_var` to @p expected.
+ * Przejmuje na własność argumenty.
+ */
+bool TestDiscriminant(Poly p, unsigned var, Poly expected)
+{
+    Poly res = PolyDiscriminant(&p, var);
+    bool is_eq = PolyIsEq(&res, &expected);
+    PolyDestroy(&p);
+    PolyDestroy(&expected);
+    PolyDestroy(&res);
+    return is_eq;
+}
+
+/**
+ * Sprawdza, że pochodna @p p względem `x_var` to @p expected.
+ * Przejmuje na własność argumenty.
+ */
+bool TestDerivative(Poly p, unsigned var, Poly expected)
+{
+    Poly res = PolyDerivative(&p, var);
+    bool is_eq = PolyIsEq(&res, &expected);
+    PolyDestroy(&p);
+    PolyDestroy(&expected);
+    PolyDestroy(&res);
+    return is_eq;
+}
+
+/**
+ * Sprawdza, że całka @p p względem `x_var` istnieje wtedy, gdy @p ok,
+ * i jest równa @p expected (zero, jeśli nie istnieje).
+ * Przejmuje na własność argumenty.
+ */
+bool TestIntegral(Poly p, unsigned var, bool ok, Poly expected)
+{
+    Poly res;
+    bool is_eq = PolyIntegral(&p, var, &res) == ok && PolyIsEq(&res, &expected);
+    if (ok && is_eq) {
+        Poly back = PolyDerivative(&res, var);
+        is_eq = PolyIsEq(&back, &p);
+        PolyDestroy(&back);
+    }
+    PolyDestroy(&p);
+    PolyDestroy(&expected);
+    PolyDestroy(&res);
+    return is_eq;
+}
+
+/**
+ * Sprawdza, że gradient @p p z @p count pochodnych składa się z pochodnych
+ * liczonych osobno. Przejmuje na własność @p p.
+ */
+bool TestGradient(Poly p, unsigned count)
+{
+    Poly grad[8];
+    assert(count <= 8);
+    PolyGradient(&p, count, grad);
+    bool is_eq = true;
+    for (unsigned i = 0; i < count; i++) {
+        Poly d = PolyDerivative(&p, i);
+        is_eq &= PolyIsEq(&grad[i], &d);
+        PolyDestroy(&d);
+        PolyDestroy(&grad[i]);
+    }
+    PolyDestroy(&p);
+    return is_eq;
+}
+
+/**
+ * Wylicza wartość wielomianu, w którym występują tylko zmienne
+ * `x_0, ..., x_(count-1)`, w punkcie, podstawiając kolejno współrzędne.
+ */
+poly_coeff_t EvalAt(const Poly *p, unsigned count, const poly_coeff_t point[])
+{
+    Poly value = PolyClone(p);
+    for (unsigned i = 0; i < count; i++) {
+        Poly next = PolyAt(&value, point[i]);
+        PolyDestroy(&value);
+        value = next;
+    }
+    poly_coeff_t c = 0;
+    PolyToCoeffArray(&value, 1, &c, 1);
+    PolyDestroy(&value);
+    return c;
+}
+
+/**
+ * Sprawdza PolyEvalGrad z wartościami pochodnych wyznaczonych przez
+ * PolyDerivative. Zmienne @p p muszą mieć indeksy mniejsze niż @p count.
+ * Przejmuje na własność @p p.
+ */
+bool TestEvalGrad(Poly p, unsigned count, const poly_coeff_t point[])
+{
+    poly_coeff_t grad[8], hess[8], grad_only[8];
+    assert(count <= 8);
+    bool is_eq = PolyEvalGrad(&p, count, point, grad, hess) == EvalAt(&p, count, point);
+    is_eq &= PolyEvalGrad(&p, count, point, grad_only, NULL) == EvalAt(&p, count, point);
+    for (unsigned i = 0; i < count; i++) {
+        Poly d = PolyDerivative(&p, i);
+        Poly d2 = PolyDerivative(&d, i);
+        is_eq &= grad[i] == EvalAt(&d, count, point) && grad_only[i] == grad[i];
+        is_eq &= hess[i] == EvalAt(&d2, count, point);
+        PolyDestroy(&d);
+        PolyDestroy(&d2);
+    }
+    PolyDestroy(&p);
+    return is_eq;
+}
+
+/**
+ * Sprawdza PolyMulTrunc z resztą z dzielenia pełnego iloczynu przez
+ * `x_0^n`. Przejmuje na własność @p p i @p q.
+ */
+bool TestMulTrunc(Poly p, Poly q, poly_exp_t n)
+{
+    Poly trunc = PolyMulTrunc(&p, &q, n);
+    Poly full = PolyMul(&p, &q);
+    Poly xn = P(C(1), n);
+    Poly quot, rem;
+    bool is_eq = PolyDivRem(&full, &xn, &quot, &rem) && PolyIsEq(&trunc, &rem);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&trunc);
+    PolyDestroy(&full);
+    PolyDestroy(&xn);
+    PolyDestroy(&quot);
+    PolyDestroy(&rem);
+    return is_eq;
+}
+
+/** Rozmiar wymiaru tablicy w TestMulTruncTotal */
+#define TRUNC_TOTAL_SIZE 16
+
+/**
+ * Sprawdza PolyMulTruncTotal z pełnym iloczynem (co najwyżej trzech
+ * zmiennych, o stopniach mniejszych niż TRUNC_TOTAL_SIZE), z którego tablicy
+ * współczynników usunięto jednomiany stopnia łącznego co najmniej @p n.
+ * Przejmuje na własność @p p i @p q.
+ */
+bool TestMulTruncTotal(Poly p, Poly q, poly_exp_t n)
+{
+    static poly_coeff_t coeffs[TRUNC_TOTAL_SIZE * TRUNC_TOTAL_SIZE * TRUNC_TOTAL_SIZE];
+    const unsigned sizes[3] = {TRUNC_TOTAL_SIZE, TRUNC_TOTAL_SIZE, TRUNC_TOTAL_SIZE};
+    const ptrdiff_t strides[3] = {TRUNC_TOTAL_SIZE * TRUNC_TOTAL_SIZE, TRUNC_TOTAL_SIZE, 1};
+    Poly trunc = PolyMulTruncTotal(&p, &q, n);
+    Poly full = PolyMul(&p, &q);
+    bool is_eq = PolyToCoeffTensor(&full, 3, sizes, strides, coeffs);
+    for (int i = 0; i < TRUNC_TOTAL_SIZE; i++) {
+        for (int j = 0; j < TRUNC_TOTAL_SIZE; j++) {
+            for (int k = 0; k < TRUNC_TOTAL_SIZE; k++) {
+                if (i + j + k >= n) {
+                    coeffs[i * strides[0] + j * strides[1] + k] = 0;
+                }
+            }
+        }
+    }
+    Poly expected = PolyFromCoeffTensor(3, sizes, strides, coeffs);
+    is_eq &= PolyIsEq(&trunc, &expected);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&trunc);
+    PolyDestroy(&full);
+    PolyDestroy(&expected);
+    return is_eq;
+}
+
+/** Największa długość szeregów w SeriesIsEqMod */
+#define SERIES_MAX 2048
+
+/**
+ * Wylicza modulo @p mod współczynniki przy `x^0, ..., x^(n-1)` iloczynu
+ * wielomianów jednej zmiennej stopnia mniejszego niż SERIES_MAX.
+ * Współczynniki czynników są dzielone na 16-bitowe połówki, aby sumy
+ * iloczynów nie przekroczyły zakresu.
+ */
+void SeriesMulMod(const Poly *p, const Poly *q, unsigned n, poly_coeff_t mod, poly_coeff_t res[])
+{
+    static poly_coeff_t a[SERIES_MAX], b[SERIES_MAX], halves[4][SERIES_MAX];
+    PolyToCoeffArray(p, SERIES_MAX, a, 1);
+    PolyToCoeffArray(q, SERIES_MAX, b, 1);
+    for (unsigned i = 0; i < SERIES_MAX; i++) {
+        a[i] = (a[i] % mod + mod) % mod;
+        b[i] = (b[i] % mod + mod) % mod;
+        halves[0][i] = a[i] & 0xffff;
+        halves[1][i] = a[i] >> 16;
+        halves[2][i] = b[i] & 0xffff;
+        halves[3][i] = b[i] >> 16;
+    }
+    Poly h[4];
+    for (unsigned i = 0; i < 4; i++) {
+        h[i] = PolyFromCoeffArray(SERIES_MAX, halves[i], 1);
+    }
+    for (unsigned i = 0; i < n; i++) {
+        res[i] = 0;
+    }
+    for (unsigned i = 0; i < 2; i++) {
+        for (unsigned j = 0; j < 2; j++) {
+            Poly product = PolyMulTrunc(&h[i], &h[2 + j], n);
+            PolyToCoeffArray(&product, n, a, 1);
+            for (unsigned k = 0; k < n; k++) {
+                poly_coeff_t term = a[k] % mod;
+                for (unsigned s = 0; s < 16 * (i + j); s++) {
+                    term = term * 2 % mod;
+                }
+                res[k] = (res[k] + term) % mod;
+            }
+            PolyDestroy(&product);
+        }
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        PolyDestroy(&h[i]);
+    }
+}
+
+/**
+ * Sprawdza, czy wielomiany jednej zmiennej stopnia mniejszego niż
+ * SERIES_MAX mają przystające modulo @p mod współczynniki przy
+ * `x^0, ..., x^(n-1)`.
+ */
+bool SeriesIsEqMod(const Poly *p, const Poly *q, unsigned n, poly_coeff_t mod)
+{
+    static poly_coeff_t a[SERIES_MAX], b[SERIES_MAX];
+    if (!PolyToCoeffArray(p, SERIES_MAX, a, 1) || !PolyToCoeffArray(q, SERIES_MAX, b, 1)) {
+        return false;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        if (((a[i] - b[i]) % mod + mod) % mod != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Sprawdza, czy iloczyn @p p i @p q ma modulo @p mod te same początkowe
+ * @p n współczynników co @p r.
+ */
+bool SeriesMulIsEqMod(const Poly *p, const Poly *q, const Poly *r, unsigned n, poly_coeff_t mod)
+{
+    static poly_coeff_t product[SERIES_MAX];
+    SeriesMulMod(p, q, n, mod, product);
+    Poly expected = PolyFromCoeffArray(n, product, 1);
+    bool res = SeriesIsEqMod(&expected, r, n, mod);
+    PolyDestroy(&expected);
+    return res;
+}
+
+/**
+ * Sprawdza operacje na szeregu @p p z @p n współczynnikami modulo @p mod:
+ * `p * p^(-1) = 1`, `exp(log p) = p` (jeśli wyraz wolny jest równy 1)
+ * i `sqrt(p)^2 = p`. Przejmuje na własność @p p.
+ */
+bool TestSeriesMod(Poly p, poly_exp_t n, poly_coeff_t mod)
+{
+    Poly one = C(1), inv, log, exp, sqrt;
+    bool res = PolySeriesInvMod(&p, n, mod, &inv);
+    res &= SeriesMulIsEqMod(&p, &inv, &one, (unsigned) n, mod);
+    if (PolySeriesLogMod(&p, n, mod, &log)) {
+        res &= PolySeriesExpMod(&log, n, mod, &exp) && SeriesIsEqMod(&exp, &p, (unsigned) n, mod);
+        PolyDestroy(&exp);
+    }
+    res &= PolySeriesSqrtMod(&p, n, mod, &sqrt);
+    res &= SeriesMulIsEqMod(&sqrt, &sqrt, &p, (unsigned) n, mod);
+    PolyDestroy(&p);
+    PolyDestroy(&one);
+    PolyDestroy(&inv);
+    PolyDestroy(&log);
+    PolyDestroy(&sqrt);
+    return res;
+}
+
+/**
+ * Sprawdza PolyShiftVar (i PolyShift dla @p var równego zeru): wartości
+ * przesuniętego wielomianu w punktach o współrzędnych od -1 do 1 oraz
+ * powrót po przesunięciu o `-a`. Zmienne @p p muszą mieć indeksy mniejsze
+ * niż @p count (co najwyżej 3). Przejmuje na własność @p p.
+ */
+bool TestShift(Poly p, unsigned count, unsigned var, poly_coeff_t a)
+{
+    assert(count <= 3);
+    Poly shifted = PolyShiftVar(&p, var, a);
+    bool res = true;
+    if (var == 0) {
+        Poly main = PolyShift(&p, a);
+        res &= PolyIsEq(&main, &shifted);
+        PolyDestroy(&main);
+    }
+    Poly back = PolyShiftVar(&shifted, var, -a);
+    res &= PolyIsEq(&back, &p);
+    unsigned points = 1;
+    for (unsigned i = 0; i < count; i++) {
+        points *= 3;
+    }
+    for (unsigned k = 0; k < points; k++) {
+        poly_coeff_t point[3], moved[3];
+        for (unsigned i = 0, rest = k; i < count; i++, rest /= 3) {
+            point[i] = moved[i] = (poly_coeff_t) (rest % 3) - 1;
+        }
+        if (var < count) {
+            moved[var] += a;
+        }
+        res &= EvalAt(&shifted, count, point) == EvalAt(&p, count, moved);
+    }
+    PolyDestroy(&p);
+    PolyDestroy(&shifted);
+    PolyDestroy(&back);
+    return res;
+}
+
+/**
+ * Porównuje PolyShiftVar ze złożeniem @p p z wielomianami `x_0, ...,
+ * x_(count-1)`, w których `x_var` zastąpiono przez `x_var + a`, a potem
+ * sprawdza przesunięcie funkcją TestShift. Zmienne @p p muszą mieć indeksy
+ * mniejsze niż @p count (co najwyżej 3). Przejmuje na własność @p p.
+ */
+bool TestShiftCompose(Poly p, unsigned count, unsigned var, poly_coeff_t a)
+{
+    assert(count <= 3 && var < count);
+    Poly vars[3] = {PolyZero(), PolyZero(), PolyZero()};
+    for (unsigned i = 0; i < count; i++) {
+        Poly x = C(1);
+        for (unsigned j = i + 1; j-- > 0;) {
+            x = P(x, j == i ? 1 : 0);
+        }
+        vars[i] = i == var ? PolyAddCoeff(&x, a) : PolyClone(&x);
+        PolyDestroy(&x);
+    }
+    Poly expected = PolyCompose(&p, count, vars);
+    Poly shifted = PolyShiftVar(&p, var, a);
+    bool res = PolyIsEq(&shifted, &expected);
+    for (unsigned i = 0; i < count; i++) {
+        PolyDestroy(&vars[i]);
+    }
+    PolyDestroy(&expected);
+    PolyDestroy(&shifted);
+    return res && TestShift(p, count, var, a);
+}
+
 bool SimpleAddTest()
 {
     bool res = true;
@@ -1610,6 +2429,31 @@ bool SimpleSubTest()
             P(P(C(1), 0, C(4), 1, C(1), 2), 1));
 }
 
+bool NegSubTest()
+{
+    bool res = true;
+    // Negacja wielomianu niebędącego współczynnikiem.
+    res &= TestNeg(P(C(1), 1, C(2), 2), P(C(-1), 1, C(-2), 2));
+    res &= TestNeg(P(C(3), 0, P(C(2), 0, C(2), 1), 2),
+                   P(C(-3), 0, P(C(-2), 0, C(-2), 1), 2));
+    // Jednomiany odjemnej i odjemnika spoza wspólnej części list.
+    res &= TestSub(P(C(1), 0, C(1), 1, C(1), 2, C(1), 3), P(C(1), 2, C(1), 3),
+                   P(C(1), 0, C(1), 1));
+    res &= TestSub(P(C(2), 0, C(1), 1), P(C(1), 0, C(1), 3),
+                   P(C(1), 0, C(1), 1, C(-1), 3));
+    res &= TestSub(P(C(1), 0, C(2), 5), P(C(1), 1, C(1), 2, C(2), 5),
+                   P(C(1), 0, C(-1), 1, C(-1), 2));
+    res &= TestSub(P(P(C(1), 0, C(1), 4), 0, C(2), 1),
+                   P(P(C(1), 2, C(1), 4), 0, C(2), 1, P(C(1), 0, C(1), 1), 3),
+                   P(P(C(1), 0, C(-1), 2), 0, P(C(-1), 0, C(-1), 1), 3));
+    // Wyniki będące współczynnikiem albo zerem.
+    res &= TestSub(P(C(3), 0, C(1), 1, C(1), 2), P(C(1), 1, C(1), 2), C(3));
+    res &= TestSub(P(C(3), 0, P(C(1), 0, C(1), 2), 4),
+                   P(C(3), 0, P(C(1), 0, C(1), 2), 4), C(0));
+    res &= TestSub(C(0), P(C(1), 0, C(-2), 2), P(C(-1), 0, C(2), 2));
+    return res;
+}
+
 #define POLY_P P(P(C(1), 3), 0, P(C(1), 2), 2, C(1), 3)
 
 bool SimpleDegByTest()
@@ -1677,6 +2521,1055 @@ bool OverflowTest()
     return res;
 }
 
+bool ScalarTest()
+{
+    bool res = true;
+    res &= TestScale(C(2), 3, C(6));
+    res &= TestScale(P(C(1), 0, C(2), 1), 3, P(C(3), 0, C(6), 1));
+    res &= TestScale(P(C(1), 0, P(C(1), 0, C(2), 1), 2), -1,
+                     P(C(-1), 0, P(C(-1), 0, C(-2), 1), 2));
+    res &= TestScale(P(C(1), 0, C(2), 1), 0, C(0));
+    res &= TestScale(P(C(1), 0, C(1L << 32), 1), 1L << 32, C(1L << 32));
+    res &= TestAddCoeff(C(2), 3, C(5));
+    res &= TestAddCoeff(P(C(1), 0, C(2), 1), 3, P(C(4), 0, C(2), 1));
+    res &= TestAddCoeff(P(C(2), 1, C(1), 2), 3, P(C(3), 0, C(2), 1, C(1), 2));
+    res &= TestAddCoeff(P(P(C(1), 0, C(1), 1), 0, C(1), 1), 2,
+                        P(P(C(3), 0, C(1), 1), 0, C(1), 1));
+    res &= TestAddCoeff(P(C(-3), 0, C(1), 1, C(1), 2), 3, P(C(1), 1, C(1), 2));
+    return res;
+}
+
+bool OwnedTest()
+{
+    bool res = true;
+    res &= TestOpOwned(C(1), C(2), C(3), PolyAddOwned);
+    res &= TestOpOwned(P(C(1), 0, C(1), 1), C(2), P(C(3), 0, C(1), 1),
+                       PolyAddOwned);
+    res &= TestOpOwned(C(2), P(C(1), 1, C(1), 2), P(C(2), 0, C(1), 1, C(1), 2),
+                       PolyAddOwned);
+    res &= TestOpOwned(P(C(1), 0, C(1), 2), P(C(1), 1, C(-1), 2),
+                       P(C(1), 0, C(1), 1), PolyAddOwned);
+    res &= TestOpOwned(P(P(C(1), 0, C(1), 1, C(1), 2), 0, C(1), 1),
+                       P(P(C(-1), 0, C(1), 1), 0, C(1), 1),
+                       P(P(C(2), 1, C(1), 2), 0, C(2), 1), PolyAddOwned);
+    res &= TestOpOwned(P(C(1), 0, C(1), 1), P(C(1), 0, C(1), 1), C(0),
+                       PolySubOwned);
+    res &= TestOpOwned(P(C(1), 0, C(1), 2), P(C(1), 1, C(1), 2),
+                       P(C(1), 0, C(-1), 1), PolySubOwned);
+    res &= TestOpOwned(C(3), P(C(1), 0, C(2), 1), P(C(2), 0, C(-2), 1),
+                       PolySubOwned);
+    res &= TestOpOwned(P(C(1), 0, C(2), 1), C(3), P(C(3), 0, C(6), 1),
+                       PolyMulOwned);
+    res &= TestOpOwned(C(0), P(C(1), 0, C(2), 1), C(0), PolyMulOwned);
+
+    Poly p = P(C(1), 0, P(C(1), 0, C(-1), 1), 1);
+    Poly q = PolyNegOwned(&p);
+    Poly expected = P(C(-1), 0, P(C(-1), 0, C(1), 1), 1);
+    res &= PolyIsEq(&q, &expected) && PolyIsZero(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&expected);
+
+    // Akumulacja: acc = acc + term
+    Poly acc = PolyZero();
+    for (int i = 0; i < 10; ++i)
+    {
+        Poly term = P(C(1), 0, C(i), i + 1);
+        acc = PolyAddOwned(&acc, &term);
+    }
+    expected = P(C(10), 0, C(1), 2, C(2), 3, C(3), 4, C(4), 5, C(5), 6,
+                 C(6), 7, C(7), 8, C(8), 9, C(9), 10);
+    res &= PolyIsEq(&acc, &expected);
+    PolyDestroy(&acc);
+    PolyDestroy(&expected);
+    return res;
+}
+
+bool InPlaceTest()
+{
+    bool res = true;
+    res &= TestOpInPlace(C(1), C(2), C(3), PolyAddTo);
+    res &= TestOpInPlace(C(0), P(C(1), 0, C(1), 1), P(C(1), 0, C(1), 1),
+                         PolyAddTo);
+    res &= TestOpInPlace(C(2), P(C(1), 1, C(1), 2),
+                         P(C(2), 0, C(1), 1, C(1), 2), PolyAddTo);
+    res &= TestOpInPlace(P(C(1), 0, C(1), 2), P(C(1), 1, C(-1), 2),
+                         P(C(1), 0, C(1), 1), PolyAddTo);
+    res &= TestOpInPlace(P(P(C(1), 0, C(1), 1, C(1), 2), 0, C(1), 1),
+                         P(P(C(-1), 0, C(1), 1), 0, C(1), 1),
+                         P(P(C(2), 1, C(1), 2), 0, C(2), 1), PolyAddTo);
+    res &= TestOpInPlace(P(C(1), 0, C(1), 1), P(C(1), 0, C(1), 1), C(0),
+                         PolySubFrom);
+    res &= TestOpInPlace(P(C(1), 0, C(1), 2), P(C(1), 1, C(1), 2),
+                         P(C(1), 0, C(-1), 1), PolySubFrom);
+    res &= TestOpInPlace(C(3), P(C(1), 0, C(2), 1), P(C(2), 0, C(-2), 1),
+                         PolySubFrom);
+
+    Poly p = P(C(1), 0, P(C(1), 0, C(-1), 1), 1);
+    PolyScaleBy(&p, -2);
+    Poly expected = P(C(-2), 0, P(C(-2), 0, C(2), 1), 1);
+    res &= PolyIsEq(&p, &expected);
+    PolyScaleBy(&p, 0);
+    res &= PolyIsZero(&p);
+    PolyDestroy(&expected);
+
+    // p += p
+    p = P(C(1), 0, C(2), 1);
+    PolyAddTo(&p, &p);
+    expected = P(C(2), 0, C(4), 1);
+    res &= PolyIsEq(&p, &expected);
+    PolyDestroy(&p);
+    PolyDestroy(&expected);
+
+    // Akumulacja: acc += term
+    Poly acc = PolyZero();
+    for (int i = 0; i < 10; ++i)
+    {
+        Poly term = P(C(1), 0, C(i), i % 3 + 1);
+        PolyAddTo(&acc, &term);
+        PolyDestroy(&term);
+    }
+    expected = P(C(10), 0, C(18), 1, C(12), 2, C(15), 3);
+    res &= PolyIsEq(&acc, &expected);
+    PolyDestroy(&acc);
+    PolyDestroy(&expected);
+    return res;
+}
+
+/**
+ * Sumuje jednomiany `(i % 5 + 1) * x^exps[i]` i porównuje wynik z sumą
+ * tych jednomianów dodawanych po jednym.
+ */
+bool TestAddMonosOrder(unsigned count, const poly_exp_t exps[])
+{
+    Mono *m = calloc(count, sizeof(Mono));
+    for (unsigned i = 0; i < count; ++i)
+    {
+        Poly c = C(i % 5 + 1);
+        m[i] = MonoFromPoly(&c, exps[i]);
+    }
+    Poly p = PolyAddMonos(count, m);
+    free(m);
+    Poly expected = PolyZero();
+    for (unsigned i = 0; i < count; ++i)
+    {
+        Poly c = C(i % 5 + 1);
+        Mono mono = MonoFromPoly(&c, exps[i]);
+        Poly term = PolyAddMonos(1, &mono);
+        PolyAddTo(&expected, &term);
+        PolyDestroy(&term);
+    }
+    bool res = PolyIsEq(&p, &expected);
+    PolyDestroy(&p);
+    PolyDestroy(&expected);
+    return res;
+}
+
+bool AddMonosOrderTest()
+{
+    bool res = true;
+    poly_exp_t descending[] = {5, 4, 4, 2, 0};
+    poly_exp_t ascending[] = {0, 1, 1, 3, 7};
+    poly_exp_t mixed[] = {3, 0, 7, 3, 1};
+    res &= TestAddMonosOrder(5, descending);
+    res &= TestAddMonosOrder(5, ascending);
+    res &= TestAddMonosOrder(5, mixed);
+
+    // Dłuższa tablica z dużymi wykładnikami i powtórzeniami.
+    unsigned count = 1000;
+    poly_exp_t *exps = calloc(count, sizeof(poly_exp_t));
+    for (unsigned i = 0; i < count; ++i)
+        exps[i] = (poly_exp_t)((i * 7919u) % 613u) * 100003;
+    res &= TestAddMonosOrder(count, exps);
+
+    // Krótki przedział wykładników (sumowanie bezpośrednio w tablicy).
+    for (unsigned i = 0; i < count; ++i)
+        exps[i] = (poly_exp_t)((i * 7u) % 500u);
+    res &= TestAddMonosOrder(count, exps);
+    free(exps);
+
+    // Mało różnych, odległych wykładników (sumowanie w tablicy haszującej).
+    count = 4000;
+    exps = calloc(count, sizeof(poly_exp_t));
+    for (unsigned i = 0; i < count; ++i)
+        exps[i] = (poly_exp_t)((i * 11u) % 37u) * 1000003;
+    res &= TestAddMonosOrder(count, exps);
+    free(exps);
+
+    // Iloczyn rzadkich wielomianów (różne wykładniki w tablicy haszującej).
+    res &= TestMul(P(C(1), 0, C(1), 1000000), P(C(1), 0, C(-1), 2000000),
+                   P(C(1), 0, C(1), 1000000, C(-1), 2000000, C(-1), 3000000));
+    return res;
+}
+
+bool BuilderTest()
+{
+    bool res = true;
+    PolyBuilder b;
+    PolyBuilderInit(&b);
+    PolyBuilderReserve(&b, 8);
+    PolyBuilderAppendCoeff(&b, 5, 3);
+    PolyBuilderAppendCoeff(&b, 4, 0);
+    Poly p = P(C(1), 0, C(1), 1);
+    PolyBuilderAppend(&b, 2, &p);
+    PolyBuilderAppendCoeff(&b, 0, 7);
+    Poly built = PolyBuilderFinish(&b);
+    Poly expected = P(C(7), 0, P(C(1), 0, C(1), 1), 2, C(3), 5);
+    res &= PolyIsEq(&built, &expected);
+    PolyDestroy(&built);
+    PolyDestroy(&expected);
+
+    // Pusty budowniczy daje zero, a sam wyraz wolny - współczynnik.
+    built = PolyBuilderFinish(&b);
+    res &= PolyIsZero(&built);
+    PolyDestroy(&built);
+    PolyBuilderAppendCoeff(&b, 0, 5);
+    built = PolyBuilderFinish(&b);
+    expected = C(5);
+    res &= PolyIsCoeff(&built) && PolyIsEq(&built, &expected);
+    PolyDestroy(&built);
+
+    // Długi wielomian bez rezerwacji.
+    unsigned count = 10000;
+    Mono *m = calloc(count, sizeof(Mono));
+    for (unsigned i = 0; i < count; ++i)
+    {
+        PolyBuilderAppendCoeff(&b, (poly_exp_t)(count - i), (poly_coeff_t)i + 1);
+        Poly c = C((poly_coeff_t)i + 1);
+        m[i] = MonoFromPoly(&c, (poly_exp_t)(count - i));
+    }
+    built = PolyBuilderFinish(&b);
+    expected = PolyAddMonos(count, m);
+    free(m);
+    res &= PolyIsEq(&built, &expected);
+    PolyDestroy(&built);
+    PolyDestroy(&expected);
+    return res;
+}
+
+bool CoeffArrayTest()
+{
+    bool res = true;
+    unsigned count = (unsigned)conf_size;
+    poly_coeff_t *out = calloc(count, sizeof(poly_coeff_t));
+
+    // Tablica ciągła: przejście w obie strony i porównanie z PolyAddMonos.
+    Poly p = PolyFromCoeffArray(count, coef_arr1, 1);
+    Mono *m = calloc(count, sizeof(Mono));
+    for (unsigned i = 0; i < count; ++i)
+    {
+        Poly c = C(coef_arr1[i]);
+        m[i] = MonoFromPoly(&c, (poly_exp_t)i);
+    }
+    Poly expected = PolyAddMonos(count, m);
+    free(m);
+    res &= PolyIsEq(&p, &expected);
+    res &= PolyToCoeffArray(&p, count, out, 1);
+    for (unsigned i = 0; i < count; ++i)
+        res &= out[i] == coef_arr1[i];
+    // Za krótka tablica
+    res &= !PolyToCoeffArray(&p, count - 1, out, 1);
+    PolyDestroy(&p);
+    PolyDestroy(&expected);
+
+    // Co drugi element i odwrócona kolejność.
+    p = PolyFromCoeffArray(count / 2, coef_arr2, 2);
+    res &= PolyToCoeffArray(&p, count / 2, out + count / 2 - 1, -1);
+    for (unsigned i = 0; i < count / 2; ++i)
+        res &= out[count / 2 - 1 - i] == coef_arr2[2 * i];
+    PolyDestroy(&p);
+    free(out);
+
+    // 2 x 3: x^i y^j ma współczynnik arr[i][j].
+    poly_coeff_t arr[2][3] = {{1, 0, 2}, {0, 3, 0}};
+    unsigned sizes[] = {2, 3, 2};
+    ptrdiff_t strides[] = {3, 1};
+    p = PolyFromCoeffTensor(2, sizes, strides, &arr[0][0]);
+    expected = P(P(C(1), 0, C(2), 2), 0, P(C(3), 1), 1);
+    res &= PolyIsEq(&p, &expected);
+    poly_coeff_t back[2][3];
+    res &= PolyToCoeffTensor(&p, 2, sizes, strides, &back[0][0]);
+    for (unsigned i = 0; i < 2; ++i)
+        for (unsigned j = 0; j < 3; ++j)
+            res &= back[i][j] == arr[i][j];
+    PolyDestroy(&expected);
+
+    // Te same współczynniki jako tablica 2 x 3 x 2 z zerową ostatnią
+    // warstwą oraz w układzie kolumnowym.
+    poly_coeff_t cube[2][3][2];
+    ptrdiff_t cube_strides[] = {6, 2, 1};
+    res &= PolyToCoeffTensor(&p, 3, sizes, cube_strides, &cube[0][0][0]);
+    for (unsigned i = 0; i < 2; ++i)
+        for (unsigned j = 0; j < 3; ++j)
+            res &= cube[i][j][0] == arr[i][j] && cube[i][j][1] == 0;
+    ptrdiff_t column_strides[] = {1, 2};
+    poly_coeff_t column[6];
+    res &= PolyToCoeffTensor(&p, 2, sizes, column_strides, column);
+    Poly q = PolyFromCoeffTensor(2, sizes, column_strides, column);
+    res &= PolyIsEq(&p, &q);
+    // Zmienna spoza tablicy
+    res &= !PolyToCoeffArray(&p, 2, column, 1);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    return res;
+}
+
+bool AddManyTest()
+{
+    bool res = true;
+    Poly polys[] = {
+            P(C(1), 0, C(2), 3),
+            C(5),
+            P(P(C(1), 1), 0, C(-2), 3, C(1), 4),
+            PolyZero(),
+            P(C(-1), 1, C(4), 2)};
+    Poly sum = PolyAddMany(5, polys, NULL);
+    Poly expected = P(P(C(6), 0, C(1), 1), 0, C(-1), 1, C(4), 2, C(1), 4);
+    res &= PolyIsEq(&sum, &expected);
+    PolyDestroy(&sum);
+    PolyDestroy(&expected);
+
+    // Kombinacja liniowa
+    poly_coeff_t weights[] = {2, -1, 1, 7, 0};
+    sum = PolyAddMany(5, polys, weights);
+    expected = P(P(C(-3), 0, C(1), 1), 0, C(2), 3, C(1), 4);
+    res &= PolyIsEq(&sum, &expected);
+    PolyDestroy(&sum);
+    PolyDestroy(&expected);
+
+    // Wszystko się redukuje
+    Poly same[] = {polys[2], polys[2]};
+    poly_coeff_t cancel[] = {1, -1};
+    sum = PolyAddMany(2, same, cancel);
+    res &= PolyIsZero(&sum);
+    PolyDestroy(&sum);
+    sum = PolyAddMany(0, polys, NULL);
+    res &= PolyIsZero(&sum);
+    PolyDestroy(&sum);
+
+    // Porównanie z kolejnymi PolyAdd
+    Poly many[50];
+    Poly chained = PolyZero();
+    for (int i = 0; i < 50; ++i)
+    {
+        many[i] = P(C(i + 1), 0, P(C(1), 0, C(i), i % 5 + 1), i % 7 + 1,
+                    C(-i), 2 * i + 10);
+        Poly next = PolyAdd(&chained, &many[i]);
+        PolyDestroy(&chained);
+        chained = next;
+    }
+    sum = PolyAddMany(50, many, NULL);
+    res &= PolyIsEq(&sum, &chained);
+    PolyDestroy(&sum);
+    PolyDestroy(&chained);
+    for (int i = 0; i < 50; ++i)
+        PolyDestroy(&many[i]);
+    for (int i = 0; i < 5; ++i)
+        PolyDestroy(&polys[i]);
+    return res;
+}
+
+/**
+ * Porównuje PolySquare z PolyMul.
+ */
+bool TestSquare(Poly p)
+{
+    Poly square = PolySquare(&p);
+    Poly product = PolyMul(&p, &p);
+    bool is_eq = PolyIsEq(&square, &product);
+    PolyDestroy(&p);
+    PolyDestroy(&square);
+    PolyDestroy(&product);
+    return is_eq;
+}
+
+bool SquareTest()
+{
+    bool res = true;
+    res &= TestSquare(C(0));
+    res &= TestSquare(C(-7));
+    res &= TestSquare(P(C(1), 0, C(1), 1));
+    res &= TestSquare(P(C(3), 2, C(-1), 1000));
+    res &= TestSquare(P(P(C(1), 0, C(2), 3), 0, P(C(-1), 1), 4, C(5), 7));
+    res &= TestSquare(P(C(1L << 32), 1, C(1), 2));
+
+    // Gęste wielomiany (Karatsuba), także przesunięte i z przepełnieniem.
+    unsigned sizes[] = {31, 32, 33, 100, 257};
+    for (unsigned k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+    {
+        res &= TestSquare(PolyFromCoeffArray(sizes[k], coef_arr1, 1));
+        res &= TestSquare(PolyFromCoeffArray(sizes[k], coef_arr2 + 1, 3));
+    }
+    Mono *m = calloc(200, sizeof(Mono));
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        Poly c = C(i % 3 == 0 ? 0 : coef_arr1[i] * (1L << 40));
+        m[i] = MonoFromPoly(&c, (poly_exp_t)i + 50);
+    }
+    res &= TestSquare(PolyAddMonos(200, m));
+    free(m);
+    return res;
+}
+
+bool PowTest()
+{
+    bool res = true;
+    res &= TestPow(C(0), 0);
+    res &= TestPow(C(0), 5);
+    res &= TestPow(C(-3), 5);
+    res &= TestPow(C(3), 80);
+    res &= TestPow(P(C(2), 1, C(1), 3), 1);
+    res &= TestPow(P(P(C(2), 1), 3), 4);
+
+    // Gęste wielomiany jednej zmiennej (rekurencja Millera), także
+    // przesunięte i z ujemnymi współczynnikami.
+    res &= TestPow(P(C(1), 0, C(1), 1), 10);
+    res &= TestPow(P(C(2), 5, C(-3), 6, C(1), 7), 9);
+    res &= TestPow(PolyFromCoeffArray(10, coef_arr1, 1), 2);
+    res &= TestPow(P(C(1), 0, C(1), 1, C(1), 2, C(1), 3), 12);
+
+    // Kilka jednomianów (rozwinięcie dwumianowe), także z przepełnieniem.
+    res &= TestPow(P(C(1), 0, C(1), 1), 70);
+    res &= TestPow(P(C(3), 2, C(-1), 1000), 9);
+    res &= TestPow(P(C(1), 0, C(1), 5, C(1), 100), 12);
+    res &= TestPow(P(P(C(1), 0, C(2), 3), 0, P(C(-1), 1), 4, C(5), 7), 6);
+    res &= TestPow(P(C(1L << 32), 1, C(1), 2), 5);
+
+    // Pozostałe: podnoszenie do kwadratu.
+    res &= TestPow(PolyFromCoeffArray(100, coef_arr2, 1), 3);
+    res &= TestPow(PolyFromCoeffArray(20, coef_arr1, 7), 5);
+    res &= TestPow(P(C(1), 0, C(1), 1), 2000);
+    return res;
+}
+
+bool ComposeTest()
+{
+    bool res = true;
+    // x0^2 + x1 dla x0 = x + 1, x1 = 3
+    res &= TestCompose(P(P(C(1), 1), 0, C(1), 2), 2,
+                       (Poly[]){P(C(1), 0, C(1), 1), C(3)},
+                       P(C(4), 0, C(2), 1, C(1), 2));
+    // Pod zmienne bez podstawienia trafia zero.
+    res &= TestCompose(P(P(C(5), 0, C(1), 1), 0, C(2), 1), 0, NULL, C(5));
+    res &= TestCompose(P(P(C(5), 0, C(1), 1), 0, C(2), 1), 1,
+                       (Poly[]){C(7)}, C(19));
+    res &= TestCompose(P(C(1), 3), 1, (Poly[]){C(0)}, C(0));
+    res &= TestCompose(P(C(2), 0, C(1), 3), 1, (Poly[]){PolyZero()}, C(2));
+    res &= TestCompose(PolyZero(), 1, (Poly[]){P(C(1), 0, C(1), 1)}, C(0));
+    // Podstawienie zmiennych za siebie samych nie zmienia wielomianu.
+    res &= TestCompose(POLY_P, 3,
+                       (Poly[]){P(C(1), 1), P(P(C(1), 1), 0),
+                                P(P(P(C(1), 1), 0), 0)},
+                       POLY_P);
+
+    // Podstawienie stałej to PolyAt.
+    Poly p = PolyFromCoeffArray(10, coef_arr1, 1);
+    Poly at = PolyAt(&p, -3);
+    res &= TestCompose(p, 1, (Poly[]){C(-3)}, at);
+
+    // Gęste złożenia („dziel i zwyciężaj”) i rzadkie (Horner).
+    unsigned sizes[] = {17, 40, 100};
+    for (unsigned k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+    {
+        p = PolyFromCoeffArray(sizes[k], coef_arr1, 1);
+        Poly q = PolyFromCoeffArray(5 + k, coef_arr2, 1);
+        Poly expected = ComposeReference(&p, sizes[k], &q);
+        res &= TestCompose(p, 1, &q, expected);
+    }
+    p = P(C(2), 0, C(-1), 7, C(3), 30);
+    Poly q = P(C(1), 1, C(1), 4);
+    Poly expected = ComposeReference(&p, 31, &q);
+    res &= TestCompose(p, 1, &q, expected);
+    p = PolyFromCoeffArray(40, coef_arr2, 1);
+    q = P(P(C(1), 1), 0, C(-2), 3);
+    expected = ComposeReference(&p, 40, &q);
+    res &= TestCompose(p, 1, &q, expected);
+    return res;
+}
+
+bool DivRemTest()
+{
+    bool res = true;
+    res &= TestDivRem(P(C(-1), 0, C(1), 2), P(C(-1), 0, C(1), 1),
+                      P(C(1), 0, C(1), 1), C(0));
+    res &= TestDivRem(P(C(5), 0, C(2), 1, C(1), 3), P(C(1), 0, C(1), 2),
+                      P(C(1), 1), P(C(5), 0, C(1), 1));
+    res &= TestDivRem(P(C(1), 1), P(C(1), 0, C(1), 2), C(0), P(C(1), 1));
+    res &= TestDivRem(P(C(6), 0, C(-9), 1), C(3), P(C(2), 0, C(-3), 1), C(0));
+    // Iloraz przez -1 i przez odwracalną modulo 2^64 liczbę 3.
+    res &= TestDivRem(C(7), C(-1), C(-7), C(0));
+    res &= TestDivRemProduct(P(C(1), 0, C(-4), 2), P(C(3), 0, C(1), 1), C(2));
+    // Współczynniki będące wielomianami.
+    res &= TestDivRem(P(C(1), 0, P(C(1), 1), 2), P(C(-1), 0, C(1), 1),
+                      P(P(C(1), 1), 0, P(C(1), 1), 1), P(P(C(1), 0, C(1), 1), 0));
+    res &= TestDivRemProduct(P(P(C(1), 0, C(2), 3), 0, P(C(-1), 1), 4),
+                             P(P(C(5), 2), 0, C(-1), 3), P(P(C(1), 1), 2));
+
+    // Dzielenie niemożliwe.
+    Poly quot, rem;
+    Poly p = P(C(1), 0, C(1), 3);
+    Poly bad[] = {C(0), C(2), P(C(1), 0, C(2), 1), P(P(C(1), 1), 1)};
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        res &= !PolyDivRem(&p, &bad[i], &quot, &rem);
+        res &= PolyIsZero(&quot) && PolyIsZero(&rem);
+        PolyDestroy(&bad[i]);
+    }
+    PolyDestroy(&p);
+
+    // Gęste: szkolnie i metodą Newtona, a także rzadkie wysokiego stopnia.
+    unsigned sizes[][2] = {{100, 10}, {300, 100}, {1000, 400}, {200, 199},
+                           {500, 64}, {64, 64}};
+    for (unsigned k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+    {
+        unsigned n = sizes[k][0], m = sizes[k][1];
+        poly_coeff_t divisor[400];
+        for (unsigned i = 0; i < m; ++i)
+            divisor[i] = coef_arr2[i];
+        divisor[m - 1] = k % 2 == 0 ? 1 : -3;
+        res &= TestDivRemProduct(PolyFromCoeffArray(n - m + 1, coef_arr1, 1),
+                                 PolyFromCoeffArray(m, divisor, 1),
+                                 PolyFromCoeffArray(m - 1, coef_arr1 + 500, 1));
+    }
+    res &= TestDivRemProduct(P(C(1), 0, C(5), 1000), P(C(3), 0, C(-1), 50),
+                             P(C(7), 3));
+
+    // Gęste mnożenie na tablicach (Karatsuba).
+    res &= TestMulByMonos(PolyFromCoeffArray(100, coef_arr1, 1),
+                          PolyFromCoeffArray(40, coef_arr2, 1), 40);
+    res &= TestMulByMonos(PolyFromCoeffArray(33, coef_arr2, 3),
+                          PolyFromCoeffArray(257, coef_arr1, 1), 257);
+    return res;
+}
+
+bool DivExactTest()
+{
+    bool res = true;
+    res &= TestDivExact(P(C(1), 0, C(1), 1), P(C(-1), 0, C(1), 1));
+    res &= TestDivExact(C(-3), P(C(2), 0, C(4), 5));
+    res &= TestDivExact(C(-1), P(C(5), 1));
+    res &= TestDivExact(P(P(C(1), 0, C(2), 1), 0, C(3), 2),
+                        P(P(C(-1), 1), 0, P(C(1), 0, C(1), 2), 1));
+    res &= TestDivExact(P(P(C(1), 0, C(2), 3), 0, P(C(-1), 1), 4, C(5), 7),
+                        P(P(P(C(1), 1), 0, C(2), 1), 1, C(-7), 3));
+
+    // Potęgi x + y + 1: (x + y + 1)^2 dzieli (x + y + 1)^5.
+    Poly base = P(P(C(1), 0, C(1), 1), 0, C(1), 1);
+    Poly pow2 = PolyPow(&base, 2);
+    Poly pow3 = PolyPow(&base, 3);
+    Poly pow5 = PolyPow(&base, 5);
+    Poly quot;
+    res &= PolyDivExact(&pow5, &pow2, &quot) && PolyIsEq(&quot, &pow3);
+    PolyDestroy(&quot);
+    res &= TestNotDivides(PolyAddCoeff(&pow5, 1), PolyClone(&pow2));
+    res &= TestNotDivides(PolyClone(&pow5), P(C(-1), 0, C(1), 1));
+    res &= TestNotDivides(PolyClone(&pow5), P(P(C(-1), 1), 0, C(1), 1));
+    PolyDestroy(&base);
+    PolyDestroy(&pow2);
+    PolyDestroy(&pow3);
+    PolyDestroy(&pow5);
+
+    // Współczynniki całkowite, stopnie i zmienne, których nie ma w dzielnej.
+    res &= TestNotDivides(P(C(4), 0, C(6), 1), C(4));
+    res &= TestNotDivides(P(C(4), 0, C(6), 1), P(C(4), 0, C(6), 2));
+    res &= TestNotDivides(P(C(1), 1), P(P(C(1), 1), 0));
+    res &= TestNotDivides(P(C(1), 1), P(C(1), 2));
+    res &= TestNotDivides(C(7), C(2));
+    res &= TestNotDivides(C(7), C(0));
+    // Reszta z dzielenia x^4 + 4x^2 + 5 przez x^2 + 1 to 2.
+    res &= TestNotDivides(P(C(5), 0, C(4), 2, C(1), 4), P(C(1), 0, C(1), 2));
+    // Wartości w punktach są zbyt duże, więc rozstrzyga samo dzielenie.
+    res &= TestNotDivides(P(C(3L << 61), 0, C(1), 3), P(C(1), 0, C(1), 1));
+    res &= TestDivExact(P(C(3L << 40), 0, C(1), 1), P(C(1L << 21), 0, C(1), 2));
+
+    Poly zero = C(0), x = P(C(1), 1);
+    res &= PolyDivides(&zero, &zero) && !PolyDivides(&zero, &x);
+    res &= PolyDivides(&x, &zero);
+    res &= PolyDivExact(&zero, &x, &quot) && PolyIsZero(&quot);
+    PolyDestroy(&x);
+
+    // Długie gęste czynniki.
+    res &= TestDivExact(PolyFromCoeffArray(60, coef_arr1, 1),
+                        PolyFromCoeffArray(45, coef_arr2, 1));
+    return res;
+}
+
+bool GcdTest()
+{
+    bool res = true;
+    // Zera i stałe.
+    res &= TestGcd(C(0), C(0), C(0));
+    res &= TestGcd(C(0), P(C(-1), 1), P(C(1), 1));
+    res &= TestGcd(C(6), C(-4), C(2));
+    res &= TestGcd(P(C(4), 0, C(6), 1), C(10), C(2));
+    res &= TestGcd(P(C(1), 0, C(1), 2), P(C(1), 0, C(1), 1), C(1));
+
+    // Jedna zmienna, zawartości całkowite i ujemne wiodące współczynniki.
+    res &= TestGcdOfProducts(P(C(1), 0, C(1), 1), P(C(-2), 0, C(1), 1),
+                             P(C(3), 0, C(1), 1));
+    res &= TestGcd(P(C(-2), 0, C(-3), 1, C(-1), 2), P(C(2), 0, C(1), 1),
+                   P(C(2), 0, C(1), 1));
+    res &= TestGcd(P(C(6), 0, C(12), 1, C(6), 2), P(C(-4), 0, C(4), 2),
+                   P(C(2), 0, C(2), 1));
+
+    // Wiele zmiennych: x + y + 1 jest NWD (x + y + 1)^2 (x - y)
+    // i (x + y + 1)(xy + 3).
+    Poly base = P(P(C(1), 0, C(1), 1), 0, C(1), 1);
+    Poly diff = P(P(C(-1), 1), 0, C(1), 1);
+    res &= TestGcdOfProducts(PolyClone(&base), PolyMul(&base, &diff),
+                             P(C(3), 0, P(C(1), 1), 1));
+    PolyDestroy(&base);
+    PolyDestroy(&diff);
+    // Zawartość względem x: NWD y(x + 1) i y^2(x + 2) to y.
+    res &= TestGcdOfProducts(P(P(C(1), 1), 0), P(C(1), 0, C(1), 1),
+                             P(P(C(2), 1), 0, P(C(1), 1), 1));
+    // Trzy zmienne: xz + y^2 - 1 razy x + z + 2 oraz yz - x.
+    res &= TestGcdOfProducts(P(P(C(-1), 0, C(1), 2), 0, P(P(C(1), 1), 0), 1),
+                             P(P(P(C(2), 0, C(1), 1), 0), 0, C(1), 1),
+                             P(P(P(C(1), 1), 1), 0, C(-1), 1));
+
+    // Duże współczynniki: wartości w punktach są zbyt duże dla heurystyki,
+    // więc NWD wyznaczany jest modularnie.
+    res &= TestGcdOfProducts(P(P(C(3), 0, C(999), 3), 0, C(-7), 1, P(C(1000), 1), 2),
+                             P(C(-29), 0, P(C(311), 2), 1, C(577), 3),
+                             P(P(C(17), 0, C(403), 4), 0, P(C(-811), 1), 1, C(2), 2));
+    Poly dense = PolyFromCoeffArray(20, coef_arr1, 1);
+    Poly lead = P(C(1), 20);
+    PolyAddTo(&dense, &lead);
+    PolyDestroy(&lead);
+    res &= TestGcdOfProducts(dense, PolyFromCoeffArray(25, coef_arr2, 1),
+                             PolyFromCoeffArray(30, coef_arr1 + 100, 1));
+    return res;
+}
+
+bool GcdExtModTest()
+{
+    bool res = true;
+    poly_coeff_t mod = 2147483647;
+    res &= TestGcdExtMod(C(0), C(0), 7, C(0));
+    res &= TestGcdExtMod(C(0), P(C(3), 0, C(3), 1), 5, P(C(1), 0, C(1), 1));
+    res &= TestGcdExtMod(C(4), C(6), 7, C(1));
+    res &= TestGcdExtMod(P(C(-1), 0, C(1), 2), P(C(-1), 0, C(1), 1), 7,
+                         P(C(6), 0, C(1), 1));
+    res &= TestGcdExtMod(P(C(1), 0, C(1), 2), P(C(1), 0, C(1), 1), 7, C(1));
+    // x^2 + 1 = (x + 2)(x + 3) modulo 5.
+    res &= TestGcdExtMod(P(C(1), 0, C(1), 2), P(C(2), 0, C(1), 1), 5,
+                         P(C(2), 0, C(1), 1));
+
+    // Długie wielomiany: NWD g a i g b to g (o współczynnikach modulo mod).
+    unsigned sizes[] = {70, 1000, 2500};
+    for (unsigned k = 0; k < 3; ++k)
+    {
+        unsigned n = sizes[k];
+        poly_coeff_t *reduced = calloc(n + 1, sizeof(poly_coeff_t));
+        for (unsigned i = 0; i < n; ++i)
+            reduced[i] = (coef_arr1[i] % mod + mod) % mod;
+        reduced[n] = 1;
+        Poly g = PolyFromCoeffArray(n, coef_arr1, 1);
+        Poly lead = P(C(1), (poly_exp_t)n);
+        PolyAddTo(&g, &lead);
+        Poly a = PolyFromCoeffArray(n + 100, coef_arr2, 1);
+        Poly b = PolyFromCoeffArray(n + 50, coef_arr1 + 2000, 1);
+        res &= TestGcdExtMod(PolyMul(&g, &a), PolyMul(&g, &b), mod,
+                             PolyFromCoeffArray(n + 1, reduced, 1));
+        // Bez wspólnego czynnika, także dla wielomianów równych stopni.
+        res &= TestGcdExtMod(PolyClone(&a), PolyAddCoeff(&a, 1), mod, C(1));
+        PolyDestroy(&g);
+        PolyDestroy(&lead);
+        PolyDestroy(&a);
+        PolyDestroy(&b);
+        free(reduced);
+    }
+
+    // Wielomiany wielu zmiennych i niepoprawne moduły.
+    Poly gcd, s, t;
+    Poly x = P(C(1), 1), y = P(P(C(1), 1), 0);
+    res &= !PolyGcdExtMod(&x, &y, 7, &gcd, &s, &t) && PolyIsZero(&gcd);
+    res &= !PolyGcdExtMod(&x, &x, 1, &gcd, &s, &t) && PolyIsZero(&s);
+    res &= !PolyGcdExtMod(&x, &x, 1L << 40, &gcd, &s, &t) && PolyIsZero(&t);
+    // Moduły złożone, w tym 2047 = 23 * 89 (silnie pseudopierwsza przy
+    // podstawie 2) i 2^32 - 1, oraz największa liczba pierwsza poniżej 2^32.
+    Poly a = P(C(1), 0, C(3), 1), b = P(C(2), 0, C(1), 2);
+    poly_coeff_t composites[] = {9, 561, 2047, 4294967295L};
+    for (unsigned k = 0; k < 4; ++k)
+    {
+        res &= !PolyGcdExtMod(&a, &b, composites[k], &gcd, &s, &t)
+               && PolyIsZero(&gcd) && PolyIsZero(&s) && PolyIsZero(&t);
+    }
+    res &= PolyGcdExtMod(&a, &b, 4294967291L, &gcd, &s, &t);
+    PolyDestroy(&gcd);
+    PolyDestroy(&s);
+    PolyDestroy(&t);
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&x);
+    PolyDestroy(&y);
+    return res;
+}
+
+bool ResultantTest()
+{
+    bool res = true;
+    // Jedna zmienna: res(x^2 + 1, x - 1) = 2, res(x^2 - 2, x^2 - 3) = 1.
+    res &= TestResultant(P(C(1), 0, C(1), 2), P(C(-1), 0, C(1), 1), 0, false, C(2));
+    res &= TestResultant(P(C(-2), 0, C(1), 2), P(C(-3), 0, C(1), 2), 0, false, C(1));
+    res &= TestResultant(P(C(2), 1), P(C(3), 1), 0, true, C(0));
+    res &= TestResultant(C(3), P(C(1), 0, C(1), 2), 0, false, C(9));
+    res &= TestResultant(C(0), P(C(1), 1), 0, false, C(0));
+    // Współczynniki większe niż iloczyn dwóch liczb pierwszych,
+    // a w drugim przypadku przepełniające się tak jak w mnożeniu.
+    res &= TestResultant(P(C(-1000000), 0, C(1), 1), P(C(-7), 0, C(1), 3), 0, true,
+                         C(1000000000000000000L - 7));
+    res &= TestResultant(P(C(-3000000), 0, C(1), 1), P(C(1), 3), 0, true,
+                         C((poly_coeff_t)(3000000UL * 3000000UL * 3000000UL)));
+
+    // res_x0(x0 - x1, q(x0)) = q(x1).
+    res &= TestResultant(P(P(C(-1), 1), 0, C(1), 1), P(C(5), 0, C(-2), 1, C(1), 3), 0, true,
+                         P(P(C(5), 0, C(-2), 1, C(1), 3), 0));
+    // res_x1(x0^2 + x1^2 - 1, x0 - x1) = 2x0^2 - 1.
+    res &= TestResultant(P(P(C(-1), 0, C(1), 2), 0, C(1), 2), P(P(C(-1), 1), 0, C(1), 1),
+                         1, false, P(C(-1), 0, C(2), 2));
+    // res_x1(x1 - x0 x2, x1^2 - 3) = x0^2 x2^2 - 3.
+    res &= TestResultant(P(P(C(1), 1), 0, P(P(C(-1), 1), 0), 1), P(P(C(-3), 0, C(1), 2), 0),
+                         1, false, P(C(-3), 0, P(P(C(1), 2), 0), 2));
+
+    // Wyróżniki: x^2 - x, x0^2 + x1 x0 + x2, x0^3 + x1 x0 + x2
+    // i x0 x1^2 + 3x1 + 1 względem x1.
+    res &= TestDiscriminant(P(C(-1), 1, C(1), 2), 0, C(1));
+    res &= TestDiscriminant(P(C(-1), 1, C(1), 3), 0, C(4));
+    res &= TestDiscriminant(P(P(P(C(1), 1), 0), 0, P(C(1), 1), 1, C(1), 2), 0,
+                            P(P(P(C(-4), 1), 0, C(1), 2), 0));
+    res &= TestDiscriminant(P(P(P(C(1), 1), 0), 0, P(C(1), 1), 1, C(1), 3), 0,
+                            P(P(P(C(-27), 2), 0, C(-4), 3), 0));
+    res &= TestDiscriminant(P(P(C(1), 0, C(3), 1), 0, P(C(1), 2), 1), 1,
+                            P(C(9), 0, C(-4), 1));
+    res &= TestDiscriminant(P(C(5), 0, C(3), 1), 0, C(1));
+    res &= TestDiscriminant(C(5), 0, C(0));
+    return res;
+}
+
+bool DerivativeTest()
+{
+    bool res = true;
+    // x0^2 x1^3 + x0 x1 + 4x1
+    Poly p = P(P(C(4), 1), 0, P(C(1), 1), 1, P(C(1), 3), 2);
+
+    res &= TestDerivative(P(C(7), 0, C(2), 1, C(3), 2), 0, P(C(2), 0, C(6), 1));
+    res &= TestDerivative(C(5), 0, C(0));
+    res &= TestDerivative(C(0), 1, C(0));
+    res &= TestDerivative(P(C(1), 3), 1, C(0));
+    res &= TestDerivative(PolyClone(&p), 0, P(P(C(1), 1), 0, P(C(2), 3), 1));
+    res &= TestDerivative(PolyClone(&p), 1, P(C(4), 0, C(1), 1, P(C(3), 2), 2));
+    res &= TestDerivative(PolyClone(&p), 2, C(0));
+    // 4 * 2^62 przepełnia się do zera.
+    res &= TestDerivative(P(C(1), 1, C(1L << 62), 4), 0, C(1));
+
+    res &= TestIntegral(P(C(2), 0, C(6), 1), 0, true, P(C(2), 1, C(3), 2));
+    res &= TestIntegral(C(5), 1, true, P(P(C(5), 1), 0));
+    res &= TestIntegral(P(C(1), 1), 2, true, P(P(P(C(1), 1), 0), 1));
+    res &= TestIntegral(P(C(4), 0, C(1), 1, P(C(3), 2), 2), 1, true, PolyClone(&p));
+    res &= TestIntegral(C(0), 0, true, C(0));
+    res &= TestIntegral(P(C(1), 1), 0, false, C(0));
+    res &= TestIntegral(PolyClone(&p), 0, false, C(0));
+
+    res &= TestGradient(PolyClone(&p), 4);
+    res &= TestGradient(C(3), 2);
+    res &= TestGradient(C(3), 0);
+
+    // Gradient (x0 + x1 + x2 + 1)^6 to 6 (x0 + x1 + x2 + 1)^5 dla każdej zmiennej.
+    Poly s = P(P(P(C(1), 0, C(1), 1), 0, C(1), 1), 0, C(1), 1);
+    Poly s6 = PolyPow(&s, 6);
+    Poly s5 = PolyPow(&s, 5);
+    Poly expected = PolyScale(&s5, 6);
+    Poly grad[3];
+    PolyGradient(&s6, 3, grad);
+    for (unsigned i = 0; i < 3; i++) {
+        res &= PolyIsEq(&grad[i], &expected);
+        PolyDestroy(&grad[i]);
+    }
+    res &= TestGradient(PolyClone(&s6), 3);
+    PolyDestroy(&s);
+    PolyDestroy(&s6);
+    PolyDestroy(&s5);
+    PolyDestroy(&expected);
+    PolyDestroy(&p);
+    return res;
+}
+
+bool EvalGradTest()
+{
+    bool res = true;
+    // x0^2 x1^3 + x0 x1 + 4x1 w punkcie (2, 3).
+    Poly p = P(P(C(4), 1), 0, P(C(1), 1), 1, P(C(1), 3), 2);
+    poly_coeff_t point[3] = {2, 3, -1};
+    poly_coeff_t grad[3], hess[3];
+    res &= PolyEvalGrad(&p, 2, point, grad, hess) == 126;
+    res &= grad[0] == 111 && grad[1] == 114 && hess[0] == 54 && hess[1] == 72;
+    res &= PolyEvalGrad(&p, 3, point, grad, NULL) == 126 && grad[2] == 0;
+    // Zmienne o indeksach od count mają wartość zero.
+    res &= PolyEvalGrad(&p, 1, point, grad, hess) == 0 && grad[0] == 0 && hess[0] == 0;
+    PolyDestroy(&p);
+
+    Poly q = P(P(C(5), 0, C(1), 1), 0, C(1), 1);
+    res &= PolyEvalGrad(&q, 1, point, grad, hess) == 7 && grad[0] == 1 && hess[0] == 0;
+    res &= PolyEvalGrad(&q, 0, point, NULL, NULL) == 5;
+    PolyDestroy(&q);
+    Poly c = C(-3);
+    res &= PolyEvalGrad(&c, 2, point, grad, hess) == -3 && grad[0] == 0 && grad[1] == 0;
+
+    res &= TestEvalGrad(P(C(7), 0, C(2), 1, C(3), 2, C(-1), 9), 1, point);
+    // Stałe i niestałe współczynniki przy dużych różnicach wykładników.
+    res &= TestEvalGrad(P(C(3), 0, P(C(1), 0, C(2), 5), 3, C(-4), 40, P(C(-1), 1, C(1), 2), 41,
+                          C(6), 1000), 2, point);
+    Poly s =P(P(P(C(1), 0, C(1), 1), 0, C(1), 1), 0, C(-2), 1);
+    Poly s7 = PolyPow(&s, 7);
+    res &= TestEvalGrad(PolyClone(&s7), 3, point);
+    poly_coeff_t big[3] = {1000003, -77777, 123456789};
+    res &= TestEvalGrad(PolyClone(&s7), 3, big);
+    PolyDestroy(&s);
+    PolyDestroy(&s7);
+    return res;
+}
+
+bool MulTruncTest()
+{
+    bool res = true;
+    poly_coeff_t coeffs[100];
+    for (unsigned i = 0; i < 100; i++) {
+        coeffs[i] = (poly_coeff_t) (i * 7 % 13) - 6;
+    }
+    Poly dense = PolyFromCoeffArray(100, coeffs, 1);
+    Poly shorter = PolyFromCoeffArray(40, coeffs + 60, 1);
+    Poly shifted = P(C(1), 5);
+    Poly dense_shifted = PolyMul(&dense, &shifted);
+    const poly_exp_t bounds[] = {1, 2, 31, 50, 99, 100, 101, 150, 198, 199, 250};
+    for (unsigned i = 0; i < sizeof(bounds) / sizeof(bounds[0]); i++) {
+        res &= TestMulTrunc(PolyClone(&dense), PolyClone(&dense), bounds[i]);
+        res &= TestMulTrunc(PolyClone(&dense), PolyClone(&shorter), bounds[i]);
+        res &= TestMulTrunc(PolyClone(&dense_shifted), PolyClone(&dense), bounds[i]);
+        res &= TestMulTrunc(PolyClone(&dense_shifted), PolyClone(&dense_shifted), bounds[i]);
+    }
+    res &= TestMulTrunc(P(C(1), 0, C(3), 1000, C(-2), 2000), P(C(5), 10, C(1), 1500), 2600);
+    res &= TestMulTrunc(P(C(1), 0, C(3), 1000, C(-2), 2000), C(4), 1001);
+    res &= TestMulTrunc(C(4), C(5), 1);
+
+    // (x0 + x1 + x2 - 2)^5 razy (x0 + x1 + x2 - 2)^3.
+    Poly s = P(P(P(C(-2), 0, C(1), 1), 0, C(1), 1), 0, C(1), 1);
+    Poly s5 = PolyPow(&s, 5);
+    Poly s3 = PolyPow(&s, 3);
+    for (poly_exp_t n = 1; n <= 9; n++) {
+        res &= TestMulTrunc(PolyClone(&s5), PolyClone(&s3), n);
+        res &= TestMulTruncTotal(PolyClone(&s5), PolyClone(&s3), n);
+    }
+    res &= TestMulTruncTotal(PolyClone(&s5), C(3), 3);
+    res &= TestMulTruncTotal(C(-1), PolyClone(&s3), 2);
+
+    Poly zero = C(0);
+    Poly trunc = PolyMulTrunc(&s5, &s3, 0);
+    res &= PolyIsZero(&trunc);
+    trunc = PolyMulTruncTotal(&s5, &zero, 5);
+    res &= PolyIsZero(&trunc);
+    PolyDestroy(&s);
+    PolyDestroy(&s5);
+    PolyDestroy(&s3);
+    PolyDestroy(&dense);
+    PolyDestroy(&shorter);
+    PolyDestroy(&shifted);
+    PolyDestroy(&dense_shifted);
+    return res;
+}
+
+bool SeriesTest()
+{
+    bool res = true;
+    const poly_coeff_t mod = 998244353;
+    Poly g, h;
+
+    // 1 / (1 - x) = 1 + x + ... + x^9.
+    Poly p = P(C(1), 0, C(-1), 1);
+    res &= PolySeriesInv(&p, 10, &g);
+    poly_coeff_t ones[10] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    h = PolyFromCoeffArray(10, ones, 1);
+    res &= PolyIsEq(&g, &h);
+    PolyDestroy(&g);
+    PolyDestroy(&h);
+    // log(1 - x) = -(x + x^2 / 2 + ...), więc k-ty współczynnik razy k to -1.
+    res &= PolySeriesLogMod(&p, 50, mod, &g);
+    poly_coeff_t coeffs[SERIES_MAX];
+    res &= PolyToCoeffArray(&g, 50, coeffs, 1) && coeffs[0] == 0;
+    for (poly_coeff_t k = 1; k < 50; k++) {
+        res &= coeffs[k] * k % mod == mod - 1;
+    }
+    PolyDestroy(&g);
+    PolyDestroy(&p);
+    // exp(x) = sum x^k / k!.
+    p = P(C(1), 1);
+    res &= PolySeriesExpMod(&p, 40, mod, &g);
+    res &= PolyToCoeffArray(&g, 40, coeffs, 1);
+    poly_coeff_t factorial = 1;
+    for (poly_coeff_t k = 0; k < 40; k++) {
+        factorial = k > 0 ? factorial * k % mod : 1;
+        res &= coeffs[k] * factorial % mod == 1;
+    }
+    PolyDestroy(&g);
+    PolyDestroy(&p);
+
+    // Długie szeregi o współczynnikach całkowitych: (1 + x)^-2 i losowy.
+    for (unsigned i = 0; i < SERIES_MAX; i++) {
+        coeffs[i] = (poly_coeff_t) (i * 7919 % 2001) - 1000;
+    }
+    coeffs[0] = 1;
+    p = P(C(1), 0, C(2), 1, C(1), 2);
+    Poly random = PolyFromCoeffArray(300, coeffs, 1);
+    const poly_exp_t lengths[] = {1, 2, 7, 33, 100, 200, 500, 1000};
+    for (unsigned i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        poly_exp_t n = lengths[i];
+        Poly one = C(1);
+        res &= PolySeriesInv(&p, n, &g);
+        h = PolyMulTrunc(&p, &g, n);
+        res &= PolyIsEq(&h, &one);
+        PolyDestroy(&g);
+        PolyDestroy(&h);
+        res &= PolySeriesInv(&random, n, &g);
+        h = PolyMulTrunc(&random, &g, n);
+        res &= PolyIsEq(&h, &one);
+        PolyDestroy(&g);
+        PolyDestroy(&h);
+        res &= TestSeriesMod(PolyClone(&p), n, mod);
+        res &= TestSeriesMod(PolyClone(&random), n, mod);
+        res &= TestSeriesMod(PolyAddCoeff(&random, 8), n, mod);
+    }
+    res &= PolySeriesInv(&p, 1000, &g);
+    res &= PolyToCoeffArray(&g, 1000, coeffs, 1);
+    for (poly_coeff_t k = 0; k < 1000; k++) {
+        res &= coeffs[k] == (k % 2 == 0 ? k + 1 : -k - 1);
+    }
+    PolyDestroy(&g);
+
+    // Pierwiastek z 2 + x modulo 7 zaczyna się od 3, a 3 + x go nie ma.
+    Poly two = P(C(2), 0, C(1), 1), three = P(C(3), 0, C(1), 1);
+    res &= TestSeriesMod(PolyClone(&two), 5, 7);
+    res &= PolySeriesSqrtMod(&two, 1, 7, &g) && PolyToCoeffArray(&g, 1, coeffs, 1) && coeffs[0] == 3;
+    PolyDestroy(&g);
+    res &= !PolySeriesSqrtMod(&three, 5, 7, &g) && PolyIsZero(&g);
+
+    // Niepoprawne argumenty.
+    Poly x0x1 = P(P(C(1), 1), 1);
+    res &= !PolySeriesInv(&two, 5, &g) && PolyIsZero(&g);
+    res &= !PolySeriesInv(&p, 0, &g) && PolyIsZero(&g);
+    res &= !PolySeriesInv(&x0x1, 5, &g) && PolyIsZero(&g);
+    res &= !PolySeriesInvMod(&x0x1, 5, mod, &g) && PolyIsZero(&g);
+    res &= !PolySeriesInvMod(&p, 5, 1, &g) && PolyIsZero(&g);
+    res &= !PolySeriesLogMod(&two, 5, mod, &g) && PolyIsZero(&g);
+    res &= !PolySeriesLogMod(&p, 8, 7, &g) && PolyIsZero(&g);
+    res &= !PolySeriesExpMod(&p, 5, mod, &g) && PolyIsZero(&g);
+    res &= !PolySeriesSqrtMod(&p, 5, 2, &g) && PolyIsZero(&g);
+    res &= !PolySeriesInvMod(&p, 5, 9, &g) && PolyIsZero(&g);
+    res &= !PolySeriesSqrtMod(&two, 5, 2047, &g) && PolyIsZero(&g);
+    PolyDestroy(&two);
+    PolyDestroy(&three);
+    PolyDestroy(&x0x1);
+    PolyDestroy(&p);
+    PolyDestroy(&random);
+    return res;
+}
+
+bool ShiftTest()
+{
+    bool res = true;
+
+    // (x + 1)^2 przesunięty o -1 to x^2, a x przesunięty o 3 to x + 3.
+    Poly p = P(C(1), 0, C(2), 1, C(1), 2), q = P(C(1), 2);
+    Poly shifted = PolyShift(&p, -1);
+    res &= PolyIsEq(&shifted, &q);
+    PolyDestroy(&shifted);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    p = P(C(1), 1);
+    q = P(C(3), 0, C(1), 1);
+    shifted = PolyShift(&p, 3);
+    res &= PolyIsEq(&shifted, &q);
+    PolyDestroy(&shifted);
+    PolyDestroy(&q);
+    shifted = PolyShift(&p, 0);
+    res &= PolyIsEq(&shifted, &p);
+    PolyDestroy(&shifted);
+    PolyDestroy(&p);
+
+    res &= TestShift(PolyZero(), 1, 0, 5);
+    res &= TestShift(C(7), 1, 0, 5);
+    res &= TestShift(P(C(1), 0, C(1), 100), 1, 0, 2);
+    res &= TestShift(P(C(-4), 3, C(1), 1000), 1, 0, -1);
+
+    // Gęste wielomiany po obu stronach progu metody „dziel i zwyciężaj”.
+    poly_coeff_t coeffs[500];
+    for (unsigned i = 0; i < 500; i++) {
+        coeffs[i] = (poly_coeff_t) (i * 7919 % 2001) - 1000;
+    }
+    const unsigned lengths[] = {2, 10, 100, 127, 128, 129, 257, 500};
+    for (unsigned i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        res &= TestShift(PolyFromCoeffArray(lengths[i], coeffs, 1), 1, 0, 1);
+        res &= TestShift(PolyFromCoeffArray(lengths[i], coeffs, 1), 1, 0, -3);
+        res &= TestShift(PolyFromCoeffArray(lengths[i], coeffs, 1), 1, 0, 123456789);
+        res &= TestShift(PolyFromCoeffArray(lengths[i], coeffs, 1), 1, 0, 0);
+    }
+    // Długi wielomian (dziel i zwyciężaj) rozbity na trzy części przesuwane
+    // schematem Hornera: p(x + 7) = (top(x + 7) (x + 7)^100 + high(x + 7))
+    // (x + 7)^100 + low(x + 7).
+    p = PolyFromCoeffArray(300, coeffs, 1);
+    Poly parts[3] = {PolyFromCoeffArray(100, coeffs + 200, 1),
+                     PolyFromCoeffArray(100, coeffs + 100, 1),
+                     PolyFromCoeffArray(100, coeffs, 1)};
+    Poly x7 = P(C(7), 0, C(1), 1), x7_100 = PolyPow(&x7, 100);
+    q = PolyZero();
+    for (unsigned i = 0; i < 3; i++) {
+        Poly product = PolyMul(&q, &x7_100);
+        Poly part = PolyShift(&parts[i], 7);
+        PolyDestroy(&q);
+        q = PolyAdd(&product, &part);
+        PolyDestroy(&product);
+        PolyDestroy(&part);
+        PolyDestroy(&parts[i]);
+    }
+    shifted = PolyShift(&p, 7);
+    res &= PolyIsEq(&shifted, &q);
+    PolyDestroy(&p);
+    PolyDestroy(&q);
+    PolyDestroy(&x7);
+    PolyDestroy(&x7_100);
+    PolyDestroy(&shifted);
+
+    // Wielomiany wielu zmiennych względem każdej zmiennej.
+    for (unsigned var = 0; var < 4; var++) {
+        res &= TestShift(P(P(C(1), 0, C(2), 1), 0, P(C(3), 2), 3), 2, var, 2);
+        res &= TestShift(P(P(C(1), 0, P(C(-1), 1, C(5), 3), 2), 1,
+                           P(P(C(4), 2), 0, C(1), 1), 4), 3, var, -3);
+        res &= TestShift(P(P(P(C(1), 5), 70), 0, P(C(2), 0, C(1), 1), 90), 3, var, 1);
+    }
+
+    // Gęste wielomiany wielu zmiennych po obu stronach progu, przesuwane
+    // po podziale na plastry jednej zmiennej (co piąty współczynnik zerowy).
+    poly_coeff_t grid[1200];
+    for (unsigned i = 0; i < 1200; i++) {
+        grid[i] = i % 5 == 0 ? 0 : (poly_coeff_t) (i * 7919 % 2001) - 1000;
+    }
+    const unsigned rows[] = {100, 128, 300};
+    for (unsigned i = 0; i < sizeof(rows) / sizeof(rows[0]); i++) {
+        const unsigned sizes[2] = {rows[i], 4};
+        const ptrdiff_t strides[2] = {4, 1};
+        Poly d = PolyFromCoeffTensor(2, sizes, strides, grid);
+        res &= TestShiftCompose(PolyClone(&d), 2, 0, 5);
+        res &= TestShiftCompose(PolyClone(&d), 2, 1, -3);
+        PolyDestroy(&d);
+    }
+    const unsigned sizes[3] = {2, 200, 3};
+    const ptrdiff_t strides[3] = {600, 3, 1};
+    Poly d = PolyFromCoeffTensor(3, sizes, strides, grid);
+    res &= TestShiftCompose(PolyClone(&d), 3, 1, 7);
+    res &= TestShiftCompose(PolyClone(&d), 3, 2, -1);
+    PolyDestroy(&d);
+    return res;
+}
+
 void MemoryTest()
 {
     Poly *p = malloc(sizeof(struct Poly));